@@ -0,0 +1,50 @@
+/**
+ * @file    attitudebench.c
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2026/10/16
+ * @brief
+ *          Runs ATTITUDE_Benchmark from user/attitude.c on the host and prints:
+ *              1. Ticks per attitude of the old double precision conversion
+ *                 and of the single precision Euler, yaw and quaternion paths
+ *              2. Largest pitch, roll and yaw error against double precision
+ * @note
+ *          Build from the repository root:
+ *              gcc -std=gnu99 -O2 -DATTITUDE_USE_BENCHMARK -include tools/attitudebench/include/cyclecounter.h -Iuser \
+ *                  -o attitudebench tools/attitudebench/attitudebench.c user/attitude.c -lm
+ *          Add -DATTITUDE_ATAN_TERMS=3..6 to try another polynomial.
+ *          On the target, define ATTITUDE_USE_BENCHMARK in attitude.h and
+ *          call ATTITUDE_Benchmark, the numbers are then Cortex-M4 cycles.
+ *          Exit code is 0 when the errors are within the bound of the
+ *          selected polynomial.
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#include <stdio.h>
+#include "attitude.h"
+
+#ifndef ATTITUDE_USE_BENCHMARK
+#error Build with -DATTITUDE_USE_BENCHMARK.
+#endif
+
+int main(void)
+{
+    ATTITUDE_BenchmarkTypedef result;
+    uint8_t code = ATTITUDE_Benchmark(&result);
+    printf("%u attitudes, atan polynomial with %d terms\n\n", result.samples, ATTITUDE_ATAN_TERMS);
+    printf("path                       ticks  max error deg\n");
+    printf("reference (double)      %8u  %.6f\n", result.referenceCycles, (double)result.referenceError);
+    printf("ATTITUDE_QuatToEuler    %8u  pitch %.6f roll %.6f yaw %.6f\n", result.eulerCycles,
+        (double)result.maxError[0], (double)result.maxError[1], (double)result.maxError[2]);
+    printf("ATTITUDE_QuatToYaw      %8u\n", result.yawCycles);
+    printf("ATTITUDE_QuatFromQ30    %8u\n", result.quaternionCycles);
+    printf("%s\n", code ? "FAIL" : "PASS");
+    return code;
+}
@@ -0,0 +1,46 @@
+/**
+ * @file    cyclecounter.h
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2026/10/16
+ * @brief
+ *          Host replacement of user/cyclecounter.h for attitudebench.
+ *          Counts time stamp counter ticks on x86, nanoseconds elsewhere.
+ * @note
+ *          attitude.c includes "cyclecounter.h" from its own directory, so
+ *          this file is force-included with -include, which defines the
+ *          include guard first and leaves user/cyclecounter.h empty.
+ *          Host ticks are not Cortex-M4 cycles, compare the columns with
+ *          each other, not with the numbers printed on the target.
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#ifndef __CYCLECOUNTER_H
+#define __CYCLECOUNTER_H
+
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CYCLECOUNTER_Read()         ((uint32_t)__rdtsc())
+#else
+#include <time.h>
+static inline uint32_t CYCLECOUNTER_HostRead(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)(now.tv_sec * 1000000000ULL + now.tv_nsec);
+}
+#define CYCLECOUNTER_Read()         CYCLECOUNTER_HostRead()
+#endif
+
+static inline void CYCLECOUNTER_Init(void) {}
+
+#endif
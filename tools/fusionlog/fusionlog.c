@@ -0,0 +1,259 @@
+/**
+ * @file    fusionlog.c
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2026/10/16
+ * @brief
+ *          Replays an IMU log through the Mahony filter of user/attitude.c on
+ *          the host and prints:
+ *              1. Pitch, roll and yaw after every sample, as CSV
+ *              2. Largest and RMS error against the reference angles of the log
+ *          It can also write a synthetic log with noise and gyroscope bias.
+ * @note
+ *          Build from the repository root:
+ *              gcc -std=gnu99 -O2 -Iuser -o fusionlog tools/fusionlog/fusionlog.c user/attitude.c -lm
+ *          Usage:
+ *              fusionlog [-p kp] [-i ki] [-s settle seconds] [-e tolerance deg] [-q] [log.csv]
+ *              fusionlog -g still|tilt|spin [-t seconds] [-r Hz] > log.csv
+ *          One sample per line, '#' starts a comment:
+ *              time s, gx, gy, gz deg/s, ax, ay, az g[, pitch, roll, yaw deg]
+ *          dt is taken from the time column, so logs with jitter or dropped
+ *          samples replay as recorded. The reference angles are optional,
+ *          errors are only counted after the settle time. The yaw reference
+ *          is shifted to start at the yaw of the filter, which starts at 0.
+ *          Roll and yaw are not compared where the reference pitch is beyond
+ *          GIMBAL_LOCK_DEG, they are not defined at 90.
+ *          The same layout is printed by a target that logs MPU6050 raw
+ *          samples scaled with the sensitivity of the selected range.
+ *          -g writes a generated log, not a recording: the motions of mpusim,
+ *          gyroscope noise 0.05 deg/s and bias, accelerometer noise 0.005 g.
+ *          Exit code is 0 when every error after the settle time is within
+ *          the tolerance given with -e, or when -e is not given.
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include "attitude.h"
+
+#define MOTION_PHASE_S              2.0//tiltÿ˶ʱ, mpusimͬ
+#define GIMBAL_LOCK_DEG             85.0//οǳʱȽϺǺͺ
+
+static const double GyroBias[3] = {0.05, -0.03, 0.02};//-gʱƫ(/s)
+
+/**
+ * @brief ͳ
+ */
+static struct {
+    uint32_t samples;//־еĲ
+    uint32_t compared;//ȶʱ֮вοǶȵĲ
+    uint32_t gimbalLock;//ֻȽ˸ǵĲ
+    double maxError[3];
+    double squareError[3];
+}stats;
+
+static void FUSIONLOG_Usage(void)
+{
+    fprintf(stderr, "usage: fusionlog [-p kp] [-i ki] [-s settle seconds] [-e tolerance deg] [-q] [log.csv]\n"
+                    "       fusionlog -g still|tilt|spin [-t seconds] [-r Hz]\n");
+    exit(2);
+}
+
+/**
+ * @brief ׼ֲ̬α, ̶, ÿɵ־ͬ
+ */
+static double FUSIONLOG_Gauss(void)
+{
+    static uint32_t seed = 12345;
+    double u1, u2;
+    seed = seed * 1664525u + 1013904223u;
+    u1 = ((seed >> 8) + 1.0) / 16777217.0;
+    seed = seed * 1664525u + 1013904223u;
+    u2 = (seed >> 8) / 16777216.0;
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+/**
+ * @brief ˫Ԫתŷ, ʽATTITUDE_QuatToEulerfͬ
+ */
+static void FUSIONLOG_QuatToEuler(const double *q, double *euler)
+{
+    euler[0] = asin(2 * (q[0] * q[2] - q[1] * q[3])) * 57.29577951;
+    euler[1] = atan2(2 * (q[2] * q[3] + q[0] * q[1]), q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3]) * 57.29577951;
+    euler[2] = atan2(2 * (q[1] * q[2] + q[0] * q[3]), q[0] * q[0] + q[1] * q[1] - q[2] * q[2] - q[3] * q[3]) * 57.29577951;
+}
+
+/**
+ * @brief ־, ʵ̬˫ȰٶȾȷת
+ * @param motion 0-still; 1-tilt; 2-spin
+ */
+static void FUSIONLOG_Generate(int motion, double seconds, double rate)
+{
+    double q[4] = {1.0, 0.0, 0.0, 0.0}, r[4], dps[3], g[3], euler[3], angle, s, t;
+    uint32_t n, count = (uint32_t)(seconds * rate), phase, i;
+    printf("# synthetic log written by fusionlog -g, not a recording\n");
+    printf("# time s, gx, gy, gz deg/s, ax, ay, az g, pitch, roll, yaw deg\n");
+    for(n = 0; n <= count; n++)
+    {
+        t = n / rate;
+        g[0] = 2 * (q[1] * q[3] - q[0] * q[2]);
+        g[1] = 2 * (q[0] * q[1] + q[2] * q[3]);
+        g[2] = q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3];
+        FUSIONLOG_QuatToEuler(q, euler);
+        phase = (uint32_t)(t / MOTION_PHASE_S) % 4;
+        dps[0] = dps[1] = dps[2] = 0.0;
+        if(motion == 1)
+            dps[phase / 2] = phase % 2 ? -10.0 : 10.0;
+        else if(motion == 2)
+        {
+            dps[0] = phase % 2 ? -30.0 : 30.0;
+            dps[2] = 90.0;
+        }
+        printf("%.6f", t);
+        for(i = 0; i < 3; i++)
+            printf(",%.4f", dps[i] + GyroBias[i] + 0.05 * FUSIONLOG_Gauss());
+        for(i = 0; i < 3; i++)
+            printf(",%.5f", g[i] + 0.005 * FUSIONLOG_Gauss());
+        printf(",%.4f,%.4f,%.4f\n", euler[0], euler[1], euler[2]);
+        //q = q * exp( dt / 2)
+        angle = sqrt(dps[0] * dps[0] + dps[1] * dps[1] + dps[2] * dps[2]) * (M_PI / 180.0) / rate;
+        if(angle > 0.0)
+        {
+            s = sin(angle / 2) / (angle * rate) * (M_PI / 180.0);
+            r[0] = cos(angle / 2);
+            r[1] = dps[0] * s;
+            r[2] = dps[1] * s;
+            r[3] = dps[2] * s;
+            g[0] = q[0] * r[0] - q[1] * r[1] - q[2] * r[2] - q[3] * r[3];
+            g[1] = q[0] * r[1] + q[1] * r[0] + q[2] * r[3] - q[3] * r[2];
+            g[2] = q[0] * r[2] - q[1] * r[3] + q[2] * r[0] + q[3] * r[1];
+            q[3] = q[0] * r[3] + q[1] * r[2] - q[2] * r[1] + q[3] * r[0];
+            q[0] = g[0];
+            q[1] = g[1];
+            q[2] = g[2];
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    ATTITUDE_MahonyTypedef filter = ATTITUDE_MAHONY_INIT(ATTITUDE_MAHONY_KP, ATTITUDE_MAHONY_KI);
+    double settle = 1.0, tolerance = -1.0, seconds = 10.0, rate = 1000.0, time, lastTime = 0.0, yawOffset = 0.0;
+    double reference[3], error;
+    float gyro[3], accel[3], euler[3];
+    char line[256], *p;
+    int opt, quiet = 0, motion = -1, fields, fail = 0, i;
+    FILE *log = stdin;
+    while((opt = getopt(argc, argv, "p:i:s:e:qg:t:r:")) != -1)
+    {
+        switch(opt)
+        {
+            case 'p': filter.kp = atof(optarg); break;
+            case 'i': filter.ki = atof(optarg); break;
+            case 's': settle = atof(optarg); break;
+            case 'e': tolerance = atof(optarg); break;
+            case 'q': quiet = 1; break;
+            case 't': seconds = atof(optarg); break;
+            case 'r': rate = atof(optarg); break;
+            case 'g':
+                if(!strcmp(optarg, "still"))
+                    motion = 0;
+                else if(!strcmp(optarg, "tilt"))
+                    motion = 1;
+                else if(!strcmp(optarg, "spin"))
+                    motion = 2;
+                else
+                    FUSIONLOG_Usage();
+                break;
+            default: FUSIONLOG_Usage();
+        }
+    }
+    if(motion >= 0)
+    {
+        if(rate <= 0.0 || seconds <= 0.0)
+            FUSIONLOG_Usage();
+        FUSIONLOG_Generate(motion, seconds, rate);
+        return 0;
+    }
+    if(optind < argc && !(log = fopen(argv[optind], "r")))
+    {
+        perror(argv[optind]);
+        return 2;
+    }
+
+    while(fgets(line, sizeof(line), log))
+    {
+        if((p = strchr(line, '#')))
+            *p = '\0';
+        fields = sscanf(line, "%lf,%f,%f,%f,%f,%f,%f,%lf,%lf,%lf", &time, &gyro[0], &gyro[1], &gyro[2],
+            &accel[0], &accel[1], &accel[2], &reference[0], &reference[1], &reference[2]);
+        if(fields <= 0)
+            continue;
+        if(fields != 7 && fields != 10)
+        {
+            fprintf(stderr, "line %u: expected 7 or 10 fields, got %d\n", stats.samples + 1, fields);
+            return 2;
+        }
+        for(i = 0; i < 3; i++)
+            gyro[i] *= ATTITUDE_DEG_TO_RAD;
+        ATTITUDE_MahonyUpdate(&filter, gyro, accel, stats.samples ? (float)(time - lastTime) : 0.0f);
+        ATTITUDE_QuatToEulerf(filter.q, &euler[0], &euler[1], &euler[2]);
+        if(!quiet)
+            printf("%.6f,%.4f,%.4f,%.4f\n", time, (double)euler[0], (double)euler[1], (double)euler[2]);
+        if(fields == 10)
+        {
+            if(!stats.samples)
+                yawOffset = reference[2] - (double)euler[2];
+            reference[2] -= yawOffset;
+            if(time >= settle)
+            {
+                if(fabs(reference[0]) > GIMBAL_LOCK_DEG)
+                    stats.gimbalLock++;
+                for(i = 0; i < (fabs(reference[0]) > GIMBAL_LOCK_DEG ? 1 : 3); i++)
+                {
+                    error = fabs(remainder(reference[i] - (double)euler[i], 360.0));
+                    stats.squareError[i] += error * error;
+                    if(error > stats.maxError[i])
+                        stats.maxError[i] = error;
+                }
+                stats.compared++;
+            }
+        }
+        lastTime = time;
+        stats.samples++;
+    }
+    if(log != stdin)
+        fclose(log);
+
+    fprintf(stderr, "%u samples, kp %.3f, ki %.4f\n", stats.samples, (double)filter.kp, (double)filter.ki);
+    if(stats.compared)
+    {
+        fprintf(stderr, "%u samples after %.2f s compared with the reference, %u of them pitch only\n",
+            stats.compared, settle, stats.gimbalLock);
+        fprintf(stderr, "max error  pitch %.4f roll %.4f yaw %.4f deg\n", stats.maxError[0], stats.maxError[1], stats.maxError[2]);
+        i = stats.compared > stats.gimbalLock ? stats.compared - stats.gimbalLock : 1;
+        fprintf(stderr, "rms error  pitch %.4f roll %.4f yaw %.4f deg\n", sqrt(stats.squareError[0] / stats.compared),
+            sqrt(stats.squareError[1] / i), sqrt(stats.squareError[2] / i));
+        for(i = 0; i < 3; i++)
+            if(tolerance >= 0.0 && stats.maxError[i] > tolerance)
+                fail = 1;
+    }
+    else if(tolerance >= 0.0)
+    {
+        fprintf(stderr, "no reference angles after %.2f s\n", settle);
+        fail = 1;
+    }
+    if(tolerance >= 0.0)
+        fprintf(stderr, "%s\n", fail ? "FAIL" : "PASS");
+    return fail;
+}
@@ -0,0 +1,418 @@
+/**
+ * @file    iictrace.c
+ * @author  Miaow
+ * @version 0.2.0
+ * @date    2026/10/16
+ * @brief
+ *          Host tool that decodes the IIC trace dumped by IIC_TraceDump
+ *          (bsp_iic.c, IIC_USE_TRACE) and prints:
+ *              1. Bandwidth and error counts of every device
+ *              2. Latency histogram of every device
+ *              3. The slowest call sites, symbolized with the Keil map file
+ * @note
+ *          Build with any C99 compiler on the host:
+ *              gcc -std=c99 -O2 -o iictrace iictrace.c
+ *          Usage:
+ *              iictrace <capture.bin> [car.map]
+ *          capture.bin is the raw data received from USART1, text printed by
+ *          printf may be mixed in. The map file is generated by Keil in the
+ *          Listings/Objects folder; without it call sites are shown as addresses.
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define TRACE_VERSION           2
+#define TRACE_RECORD_SIZE       20
+#define TRACE_HEADER_SIZE       16
+#define TRACE_FLAG_STATUS       0x03
+#define TRACE_FLAG_READ         0x04
+#define TRACE_FLAG_BUS_POS      4
+#define TRACE_STATUS_ERROR      1
+#define TRACE_STATUS_TIMEOUT    3
+
+#define HISTOGRAM_BUCKETS       18//<1us, 1~2us, 2~4us, ... , >=65536us
+#define MAX_DEVICES             64
+#define MAX_SITES               256
+#define TOP_SITES               15
+
+/**
+ * @brief һټ¼, IIC_TraceRecordTypedefӦ
+ */
+typedef struct {
+    uint32_t start;
+    uint32_t end;
+    uint32_t caller;
+    uint16_t len;
+    uint8_t addr;
+    uint8_t reg;
+    uint8_t flags;
+}Record;
+
+/**
+ * @brief ÿ(+ַ)ͳ
+ */
+typedef struct {
+    uint8_t bus;
+    uint8_t addr;
+    uint32_t transfers;
+    uint32_t reads;
+    uint32_t errors;
+    uint32_t timeouts;
+    uint64_t bytes;
+    uint64_t busyCycles;
+    uint32_t histogram[HISTOGRAM_BUCKETS];
+}Device;
+
+/**
+ * @brief ÿλõͳ
+ */
+typedef struct {
+    uint32_t caller;
+    uint32_t calls;
+    uint64_t bytes;
+    uint64_t totalCycles;
+    uint32_t maxCycles;
+}Site;
+
+/**
+ * @brief mapļеĺ
+ */
+typedef struct {
+    uint32_t addr;
+    uint32_t size;
+    char name[64];
+}Symbol;
+
+static Device devices[MAX_DEVICES];
+static int deviceCount = 0;
+static Site sites[MAX_SITES];
+static int siteCount = 0;
+static Symbol *symbols = NULL;
+static int symbolCount = 0;
+static uint32_t coreClock = 168000000;
+
+static uint32_t ReadLe(const uint8_t *p, int size)
+{
+    uint32_t value = 0;
+    while(size--)
+        value = (value << 8) | p[size];
+    return value;
+}
+
+static int CompareSymbol(const void *a, const void *b)
+{
+    const Symbol *x = a, *y = b;
+    return x->addr < y->addr ? -1 : x->addr > y->addr;
+}
+
+/**
+ * @brief ȡKeil mapļImage Symbol Table, ֻ
+ * @return 
+ */
+static int LoadMap(const char *path)
+{
+    char line[512], name[64], type[32], kind[32];
+    unsigned int addr, size;
+    int capacity = 0;
+    FILE *fp = fopen(path, "r");
+
+    if(!fp)
+    {
+        perror(path);
+        return 0;
+    }
+    while(fgets(line, sizeof(line), fp))
+    {
+        //    IIC_BusInit    0x08000f41   Thumb Code    96  bsp_iic.o(i.IIC_BusInit)
+        if(sscanf(line, "%63s 0x%x %31s %31s %u", name, &addr, type, kind, &size) != 5)
+            continue;
+        if(strcmp(kind, "Code") || !size)
+            continue;
+        if(symbolCount == capacity)
+        {
+            capacity = capacity ? capacity * 2 : 1024;
+            symbols = realloc(symbols, capacity * sizeof(Symbol));
+            if(!symbols)
+                exit(1);
+        }
+        symbols[symbolCount].addr = addr & ~1u;
+        symbols[symbolCount].size = size;
+        snprintf(symbols[symbolCount].name, sizeof(symbols[symbolCount].name), "%s", name);
+        symbolCount++;
+    }
+    fclose(fp);
+    qsort(symbols, symbolCount, sizeof(Symbol), CompareSymbol);
+    return symbolCount;
+}
+
+/**
+ * @brief صַΪ
+ * @note صַָBLһָ, 1ڵڲ
+ */
+static const char *Symbolize(uint32_t caller)
+{
+    static char buffer[16];
+    uint32_t pc = (caller & ~1u) - 1;
+    int low = 0, high = symbolCount - 1, mid;
+
+    while(low <= high)
+    {
+        mid = (low + high) / 2;
+        if(pc < symbols[mid].addr)
+            high = mid - 1;
+        else if(pc >= symbols[mid].addr + symbols[mid].size)
+            low = mid + 1;
+        else
+            return symbols[mid].name;
+    }
+    snprintf(buffer, sizeof(buffer), "0x%08X", caller);
+    return buffer;
+}
+
+static Device *FindDevice(uint8_t bus, uint8_t addr)
+{
+    int i;
+    for(i = 0; i < deviceCount; i++)
+    {
+        if(devices[i].bus == bus && devices[i].addr == addr)
+            return &devices[i];
+    }
+    if(deviceCount == MAX_DEVICES)
+        return NULL;
+    devices[deviceCount].bus = bus;
+    devices[deviceCount].addr = addr;
+    return &devices[deviceCount++];
+}
+
+static Site *FindSite(uint32_t caller)
+{
+    int i;
+    for(i = 0; i < siteCount; i++)
+    {
+        if(sites[i].caller == caller)
+            return &sites[i];
+    }
+    if(siteCount == MAX_SITES)
+        return NULL;
+    sites[siteCount].caller = caller;
+    return &sites[siteCount++];
+}
+
+static double CyclesToUs(uint64_t cycles)
+{
+    return (double)cycles * 1e6 / coreClock;
+}
+
+static void AddRecord(const Record *record)
+{
+    uint32_t cycles = record->end - record->start;
+    uint32_t us = (uint32_t)CyclesToUs(cycles);
+    uint8_t status = record->flags & TRACE_FLAG_STATUS;
+    Device *device = FindDevice(record->flags >> TRACE_FLAG_BUS_POS & 0x03, record->addr);
+    Site *site = FindSite(record->caller);
+    int bucket = 0;
+
+    while(us && bucket < HISTOGRAM_BUCKETS - 1)
+    {
+        us >>= 1;
+        bucket++;
+    }
+    if(device)
+    {
+        device->transfers++;
+        device->reads += (record->flags & TRACE_FLAG_READ) != 0;
+        device->errors += status == TRACE_STATUS_ERROR;
+        device->timeouts += status == TRACE_STATUS_TIMEOUT;
+        device->bytes += record->len;
+        device->busyCycles += cycles;
+        device->histogram[bucket]++;
+    }
+    if(site)
+    {
+        site->calls++;
+        site->bytes += record->len;
+        site->totalCycles += cycles;
+        if(cycles > site->maxCycles)
+            site->maxCycles = cycles;
+    }
+}
+
+/**
+ * @brief вҲи֡
+ * @return ɹļ¼
+ */
+static uint32_t ParseCapture(const uint8_t *data, size_t size, uint32_t *firstStart, uint32_t *lastEnd, uint32_t *lost)
+{
+    uint32_t records = 0;
+    size_t i = 0, j, frameSize;
+    uint16_t count, checksum;
+    uint32_t total, k;
+    Record record;
+
+    while(i + TRACE_HEADER_SIZE <= size)
+    {
+        if(memcmp(data + i, "IICT", 4) || data[i + 4] != TRACE_VERSION || data[i + 5] != TRACE_RECORD_SIZE)
+        {
+            i++;
+            continue;
+        }
+        count = ReadLe(data + i + 6, 2);
+        frameSize = TRACE_HEADER_SIZE + (size_t)count * TRACE_RECORD_SIZE;
+        if(i + frameSize + 2 > size)
+        {
+            fprintf(stderr, "truncated frame at offset %lu\n", (unsigned long)i);
+            break;
+        }
+        for(checksum = 0, j = 0; j < frameSize; j++)
+            checksum += data[i + j];
+        if(checksum != ReadLe(data + i + frameSize, 2))
+        {
+            fprintf(stderr, "bad checksum at offset %lu, skipped\n", (unsigned long)i);
+            i++;
+            continue;
+        }
+        coreClock = ReadLe(data + i + 8, 4);
+        total = ReadLe(data + i + 12, 4);
+        *lost += total - count;
+        for(k = 0; k < count; k++)
+        {
+            const uint8_t *p = data + i + TRACE_HEADER_SIZE + k * TRACE_RECORD_SIZE;
+            record.start = ReadLe(p, 4);
+            record.end = ReadLe(p + 4, 4);
+            record.caller = ReadLe(p + 8, 4);
+            record.len = ReadLe(p + 12, 2);
+            record.addr = p[14];
+            record.reg = p[15];
+            record.flags = p[16];
+            if(!records)
+                *firstStart = record.start;
+            *lastEnd = record.end;
+            AddRecord(&record);
+            records++;
+        }
+        i += frameSize + 2;
+    }
+    return records;
+}
+
+static int CompareSite(const void *a, const void *b)
+{
+    const Site *x = a, *y = b;
+    return x->totalCycles < y->totalCycles ? 1 : x->totalCycles > y->totalCycles ? -1 : 0;
+}
+
+static void PrintDevices(uint32_t window)
+{
+    int i, b;
+    double seconds = window ? (double)window / coreClock : 0;
+
+    printf("== devices ==\n");
+    printf("bus addr  transfers  reads  errors  timeouts     bytes   bytes/s   busy%%\n");
+    for(i = 0; i < deviceCount; i++)
+    {
+        Device *d = &devices[i];
+        printf("%3u 0x%02X %10u %6u %7u %9u %9llu %9.0f %6.2f\n", d->bus, d->addr, d->transfers, d->reads,
+               d->errors, d->timeouts, (unsigned long long)d->bytes,
+               seconds ? d->bytes / seconds : 0.0, window ? 100.0 * d->busyCycles / window : 0.0);
+    }
+    printf("\n== latency histogram (us) ==\n");
+    for(i = 0; i < deviceCount; i++)
+    {
+        Device *d = &devices[i];
+        uint32_t peak = 1;
+        printf("bus %u addr 0x%02X\n", d->bus, d->addr);
+        for(b = 0; b < HISTOGRAM_BUCKETS; b++)
+        {
+            if(d->histogram[b] > peak)
+                peak = d->histogram[b];
+        }
+        for(b = 0; b < HISTOGRAM_BUCKETS; b++)
+        {
+            int bar;
+            if(!d->histogram[b])
+                continue;
+            if(b == 0)
+                printf("  %12s ", "<1");
+            else if(b == HISTOGRAM_BUCKETS - 1)
+                printf("  %5s%-7u ", ">=", 1u << (b - 1));
+            else
+                printf("  %5u~%-6u ", 1u << (b - 1), 1u << b);
+            printf("%8u ", d->histogram[b]);
+            for(bar = d->histogram[b] * 40 / peak; bar; bar--)
+                putchar('#');
+            putchar('\n');
+        }
+    }
+}
+
+static void PrintSites()
+{
+    int i;
+
+    qsort(sites, siteCount, sizeof(Site), CompareSite);
+    printf("\n== slowest call sites (by total time) ==\n");
+    printf("%-32s %8s %9s %11s %9s %9s\n", "caller", "calls", "bytes", "total(us)", "avg(us)", "max(us)");
+    for(i = 0; i < siteCount && i < TOP_SITES; i++)
+    {
+        Site *s = &sites[i];
+        printf("%-32s %8u %9llu %11.0f %9.1f %9.1f\n", Symbolize(s->caller), s->calls, (unsigned long long)s->bytes,
+               CyclesToUs(s->totalCycles), CyclesToUs(s->totalCycles) / s->calls, CyclesToUs(s->maxCycles));
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    FILE *fp;
+    uint8_t *data;
+    long size;
+    uint32_t records, firstStart = 0, lastEnd = 0, lost = 0;
+
+    if(argc < 2)
+    {
+        fprintf(stderr, "usage: %s <capture.bin> [car.map]\n", argv[0]);
+        return 1;
+    }
+    fp = fopen(argv[1], "rb");
+    if(!fp)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    fseek(fp, 0, SEEK_END);
+    size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    data = malloc(size > 0 ? size : 1);
+    if(!data || fread(data, 1, size, fp) != (size_t)size)
+    {
+        fprintf(stderr, "failed to read %s\n", argv[1]);
+        return 1;
+    }
+    fclose(fp);
+    if(argc > 2)
+        printf("%d functions loaded from %s\n", LoadMap(argv[2]), argv[2]);
+
+    records = ParseCapture(data, size, &firstStart, &lastEnd, &lost);
+    if(!records)
+    {
+        fprintf(stderr, "no trace found\n");
+        return 1;
+    }
+    printf("%u records, %u overwritten on target, core clock %u Hz, window %.3f ms\n\n",
+           records, lost, coreClock, CyclesToUs(lastEnd - firstStart) / 1000);
+    PrintDevices(lastEnd - firstStart);
+    PrintSites();
+    free(data);
+    free(symbols);
+    return 0;
+}
@@ -0,0 +1,586 @@
+/**
+ * @file    iichost.c
+ * @author  Miaow
+ * @version 0.1.1
+ * @date    2026/10/16
+ * @brief
+ *          Host implementation of the bsp_iic.h API for mpusim:
+ *              1. Transfers go to the MPU model instead of GPIO or I2C1
+ *              2. Simulated clock advanced by bus time and delay_xx
+ *              3. Asynchronous queue and PendSV emulated by IICHOST_RunBackground
+ *              4. Calls, bytes and bus time per API and register
+ * @note
+ *          Minimum version of header file:
+ *              0.1.0
+ *          Every bus is connected to the same MPU model. The backend of the
+ *          bus is ignored, hardware and software buses behave the same.
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#include "iichost.h"
+#include "mpumodel.h"
+#include "delay.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Ĭ
+ */
+IIC_BusTypedef IIC_DefaultBus = IIC_BUS_INIT(IIC_BACKEND_SOFTWARE, IIC_SCL_PORT, IIC_SCL_PIN, IIC_SDA_PORT, IIC_SDA_PIN, IIC_SPEED);
+GPIO_TypeDef SIM_GpioPorts[9] = {{0}, {1}, {2}, {3}, {4}, {5}, {6}, {7}, {8}};
+
+/**
+ * @brief һֵõͳ: ͬһӿ, ͬһͬһĴ, ͬһ
+ */
+typedef struct {
+    const char *api;
+    uint8_t addr;
+    uint8_t reg;
+    uint8_t isRead;
+    uint32_t transfers;
+    uint32_t errors;
+    uint64_t bytes;//ϵֽ
+    uint64_t busNs;
+}Site;
+
+/**
+ * @brief Ĵ, ڴӡͳ
+ */
+typedef struct {
+    uint8_t addr;
+    uint8_t reg;
+    const char *name;
+}RegName;
+
+static const RegName iicRegNames[] = {
+    {MPUMODEL_ADDR, 0x0D, "SELF_TEST_X"},
+    {MPUMODEL_ADDR, 0x19, "SMPLRT_DIV"},
+    {MPUMODEL_ADDR, 0x1A, "CONFIG"},
+    {MPUMODEL_ADDR, 0x1B, "GYRO_CONFIG"},
+    {MPUMODEL_ADDR, 0x1C, "ACCEL_CONFIG"},
+    {MPUMODEL_ADDR, 0x1D, "ACCEL_CONFIG2"},
+    {MPUMODEL_ADDR, 0x1E, "LP_ACCEL_ODR"},
+    {MPUMODEL_ADDR, 0x23, "FIFO_EN"},
+    {MPUMODEL_ADDR, 0x24, "I2C_MST_CTRL"},
+    {MPUMODEL_ADDR, 0x25, "I2C_SLV0_ADDR"},
+    {MPUMODEL_ADDR, 0x26, "I2C_SLV0_REG"},
+    {MPUMODEL_ADDR, 0x27, "I2C_SLV0_CTRL"},
+    {MPUMODEL_ADDR, 0x28, "I2C_SLV1_ADDR"},
+    {MPUMODEL_ADDR, 0x29, "I2C_SLV1_REG"},
+    {MPUMODEL_ADDR, 0x2A, "I2C_SLV1_CTRL"},
+    {MPUMODEL_ADDR, 0x34, "I2C_SLV4_CTRL"},
+    {MPUMODEL_ADDR, 0x37, "INT_PIN_CFG"},
+    {MPUMODEL_ADDR, 0x38, "INT_ENABLE"},
+    {MPUMODEL_ADDR, 0x3A, "INT_STATUS"},
+    {MPUMODEL_ADDR, 0x3B, "ACCEL_XOUT_H"},
+    {MPUMODEL_ADDR, 0x41, "TEMP_OUT_H"},
+    {MPUMODEL_ADDR, 0x43, "GYRO_XOUT_H"},
+    {MPUMODEL_ADDR, 0x49, "EXT_SENS_DATA"},
+    {MPUMODEL_ADDR, 0x64, "I2C_SLV1_DO"},
+    {MPUMODEL_ADDR, 0x67, "I2C_MST_DELAY"},
+    {MPUMODEL_ADDR, 0x6A, "USER_CTRL"},
+    {MPUMODEL_ADDR, 0x6B, "PWR_MGMT_1"},
+    {MPUMODEL_ADDR, 0x6C, "PWR_MGMT_2"},
+    {MPUMODEL_ADDR, 0x6D, "BANK_SEL"},
+    {MPUMODEL_ADDR, 0x6E, "MEM_START_ADDR"},
+    {MPUMODEL_ADDR, 0x6F, "MEM_R_W"},
+    {MPUMODEL_ADDR, 0x70, "PRGM_START_H"},
+    {MPUMODEL_ADDR, 0x72, "FIFO_COUNT_H"},
+    {MPUMODEL_ADDR, 0x74, "FIFO_R_W"},
+    {MPUMODEL_ADDR, 0x75, "WHO_AM_I"},
+    {MPUMODEL_ADDR, 0x77, "XA_OFFSET_H"},
+    {MPUMODEL_AK8963_ADDR, 0x00, "AK_WIA"},
+    {MPUMODEL_AK8963_ADDR, 0x02, "AK_ST1"},
+    {MPUMODEL_AK8963_ADDR, 0x03, "AK_HXL"},
+    {MPUMODEL_AK8963_ADDR, 0x09, "AK_ST2"},
+    {MPUMODEL_AK8963_ADDR, 0x0A, "AK_CNTL1"},
+    {MPUMODEL_AK8963_ADDR, 0x0B, "AK_CNTL2"},
+    {MPUMODEL_AK8963_ADDR, 0x0C, "AK_ASTC"},
+    {MPUMODEL_AK8963_ADDR, 0x10, "AK_ASAX"}
+};
+
+static uint64_t iicNow = 0;//ģʱ(ns)
+static IIC_BusTypedef *iicBuses[IIC_MAX_BUSES];
+static uint8_t iicBusCount = 0;
+static uint8_t iicPendSV = 0;//PendSV
+static uint8_t iicInBackground = 0;
+static Site iicSites[IICHOST_MAX_SITES];
+static uint16_t iicSiteCount = 0;
+static IICHOST_TotalsTypedef iicTotals;
+static uint8_t iicBuffer[65536];//ֶζȶٷַ
+
+/**
+ * @brief ģʱ任DWT, bsp_iic.cĶͳƵλͬ
+ */
+static inline uint32_t IICHOST_Cycles(uint64_t ns)
+{
+    return (uint32_t)(ns * (IICHOST_CORE_CLOCK / 1000000) / 1000);
+}
+
+uint64_t IICHOST_Now(void)
+{
+    return iicNow;
+}
+
+/**
+ * @brief ƽģʱ, ģ֮
+ */
+static void IICHOST_Advance(uint64_t ns)
+{
+    iicNow += ns;
+    MPUMODEL_Advance(iicNow);
+}
+
+void IICHOST_Idle(uint64_t until)
+{
+    if(until > iicNow)
+        IICHOST_Advance(until - iicNow);
+}
+
+/**
+ * @brief ҵ½һֵõͳ
+ */
+static Site *IICHOST_Site(const char *api, uint8_t addr, uint8_t reg, uint8_t isRead)
+{
+    uint16_t i;
+    for(i = 0; i < iicSiteCount; i++)
+    {
+        if(iicSites[i].api == api && iicSites[i].addr == addr && iicSites[i].reg == reg && iicSites[i].isRead == isRead)
+            return &iicSites[i];
+    }
+    if(iicSiteCount == IICHOST_MAX_SITES)
+        return &iicSites[IICHOST_MAX_SITES - 1];//˼һ
+    iicSites[iicSiteCount].api = api;
+    iicSites[iicSiteCount].addr = addr;
+    iicSites[iicSiteCount].reg = reg;
+    iicSites[iicSiteCount].isRead = isRead;
+    return &iicSites[iicSiteCount++];
+}
+
+/**
+ * @brief һʼֹͣĴ, ģͲʱ
+ * @param api ӿڵ, ͳ
+ * @param len ֽ, д0ֽʱֻͼĴַ
+ * @return 0-; 1-Ӧ
+ */
+static uint8_t IICHOST_Transfer(IIC_BusTypedef *bus, const char *api, uint8_t addr, uint8_t reg, uint16_t len, uint8_t *data, uint8_t isRead)
+{
+    Site *site = IICHOST_Site(api, addr, reg, isRead);
+    uint8_t res = isRead ? MPUMODEL_Read(addr, reg, data, len) : MPUMODEL_Write(addr, reg, data, len);
+    //ַӦʱֻʼ, 1ֽںֹͣ; һظʼ1ַֽ
+    uint32_t bytes = res ? 1 : (isRead ? 3u + len : 2u + len);
+    uint32_t bits = bytes * 9 + 2 + (isRead && !res);
+    uint64_t ns = (uint64_t)bits * 1000000000u / bus->speed;
+    site->transfers++;
+    site->errors += res;
+    site->bytes += bytes;
+    site->busNs += ns;
+    iicTotals.transfers++;
+    iicTotals.errors += res;
+    iicTotals.bytes += bytes;
+    iicTotals.dataBytes += res ? 0 : len;
+    iicTotals.busNs += ns;
+    IICHOST_Advance(ns);
+    return res;
+}
+
+uint8_t IIC_BusInit(IIC_BusTypedef *bus)
+{
+    if(bus->isInitialized)
+        return 0;
+    if(iicBusCount >= IIC_MAX_BUSES)
+        return 1;
+    iicBuses[iicBusCount++] = bus;
+    bus->isInitialized = 1;
+    return 0;
+}
+
+uint8_t IIC_BusWriteRegByte(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint8_t data)
+{
+    iicTotals.calls++;
+    return IICHOST_Transfer(bus, "WriteRegByte", addr, reg, 1, &data, 0);
+}
+
+uint8_t IIC_BusReadRegByte(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg)
+{
+    uint8_t res = 0;
+    iicTotals.calls++;
+    IICHOST_Transfer(bus, "ReadRegByte", addr, reg, 1, &res, 1);
+    return res;
+}
+
+uint8_t IIC_BusWriteRegBytes(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint8_t len, uint8_t *data)
+{
+    iicTotals.calls++;
+    return IICHOST_Transfer(bus, "WriteRegBytes", addr, reg, len, data, 0);
+}
+
+uint8_t IIC_BusReadRegBytes(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint8_t len, uint8_t *data)
+{
+    iicTotals.calls++;
+    return IICHOST_Transfer(bus, "ReadRegBytes", addr, reg, len, data, 1);
+}
+
+uint8_t IIC_BusReadRegBytesLong(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint16_t len, uint8_t *data)
+{
+    iicTotals.calls++;
+    return IICHOST_Transfer(bus, "ReadRegBytesLong", addr, reg, len, data, 1);
+}
+
+/**
+ * @brief ֶζ, ȶiicBufferٰθ
+ */
+static uint8_t IICHOST_Scatter(IIC_BusTypedef *bus, const char *api, uint8_t addr, uint8_t reg, const IIC_SegmentTypedef *segments, uint8_t count)
+{
+    uint32_t len = 0;
+    uint8_t i;
+    for(i = 0; i < count; i++)
+        len += segments[i].len;
+    if(len > 0xFFFF)
+        return 1;
+    if(IICHOST_Transfer(bus, api, addr, reg, len, iicBuffer, 1))
+        return 1;
+    for(len = 0, i = 0; i < count; len += segments[i++].len)
+        memcpy(segments[i].data, iicBuffer + len, segments[i].len);
+    return 0;
+}
+
+uint8_t IIC_BusReadRegScatter(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, const IIC_SegmentTypedef *segments, uint8_t count)
+{
+    iicTotals.calls++;
+    return IICHOST_Scatter(bus, "ReadRegScatter", addr, reg, segments, count);
+}
+
+uint8_t IIC_BusWriteBulk(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint16_t len, uint8_t *data)
+{
+    uint16_t chunk;
+    iicTotals.calls++;
+    while(len)
+    {
+        chunk = len > IIC_CHUNK_SIZE ? IIC_CHUNK_SIZE : len;
+        if(IICHOST_Transfer(bus, "WriteBulk", addr, reg, chunk, data, 0))
+            return 1;
+        data += chunk;
+        len -= chunk;
+    }
+    return 0;
+}
+
+uint8_t IIC_BusBenchmark(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint8_t len, uint8_t *data, IIC_BenchmarkTypedef *result)
+{
+    uint64_t begin = iicNow;
+    uint8_t res;
+    iicTotals.calls++;
+    res = IICHOST_Transfer(bus, "Benchmark", addr, reg, len, data, 1);
+    result->totalCycles = IICHOST_Cycles(iicNow - begin);
+    result->cpuCycles = result->totalCycles;
+    return res;
+}
+
+uint8_t IIC_BusSetSpeed(IIC_BusTypedef *bus, uint32_t speed)
+{
+    if(!speed || speed > IIC_SPEED_FAST_PLUS)
+        return 1;
+    bus->speed = speed;
+    return 0;
+}
+
+uint32_t IIC_BusMeasureThroughput(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint8_t len, uint8_t times)
+{
+    uint64_t begin = iicNow;
+    uint8_t data[255], i;
+    iicTotals.calls++;
+    for(i = 0; i < times; i++)
+    {
+        if(IICHOST_Transfer(bus, "MeasureThroughput", addr, reg, len, data, 1))
+            return 0;
+    }
+    if(iicNow == begin)
+        return 0;
+    return (uint32_t)((uint64_t)len * times * 1000000000u / (iicNow - begin));
+}
+
+/**
+ * @brief ִгʼPOLL/PROBE
+ * @return 0-; 1-ʱ
+ */
+static uint8_t IICHOST_InitPoll(IIC_BusTypedef *bus, const IIC_InitEntryTypedef *entry)
+{
+    uint64_t begin = iicNow;
+    uint8_t value;
+    while(1)
+    {
+        if(entry->op == IIC_INIT_OP_PROBE)
+        {
+            if(!IICHOST_Transfer(bus, "RunInitTable", entry->addr, entry->reg, 0, NULL, 0))
+                return 0;
+        }
+        else if(!IICHOST_Transfer(bus, "RunInitTable", entry->addr, entry->reg, 1, &value, 1)
+            && (value & entry->data[0]) == entry->data[1])
+            return 0;
+        if(iicNow - begin >= (uint64_t)entry->delayMs * 1000000)
+            return 1;
+        IICHOST_Advance(IIC_INIT_POLL_INTERVAL_US * 1000);
+    }
+}
+
+/**
+ * @brief ִгʼ, ϲbsp_iic.cͬ
+ */
+uint16_t IIC_BusRunInitTable(IIC_BusTypedef *bus, const IIC_InitEntryTypedef *table, uint16_t count)
+{
+    uint8_t burst[IIC_CHUNK_SIZE];
+    const IIC_InitEntryTypedef *first, *entry;
+    uint16_t i = 0, delayMs;
+    uint8_t len, j, mergeable;
+    iicTotals.calls++;
+    while(i < count)
+    {
+        first = &table[i];
+        if(first->op == IIC_INIT_OP_POLL || first->op == IIC_INIT_OP_PROBE)
+        {
+            if(IICHOST_InitPoll(bus, first))
+                return i + 1;
+            i++;
+            continue;
+        }
+        len = 0;
+        do
+        {
+            for(j = 0; j < table[i].len; j++)
+                burst[len++] = table[i].data[j];
+            delayMs = table[i++].delayMs;
+            entry = &table[i];
+            mergeable = i < count && entry->op == first->op && entry->addr == first->addr && len + entry->len <= IIC_CHUNK_SIZE
+                && entry->reg == (first->op == IIC_INIT_OP_STREAM ? first->reg : (uint8_t)(first->reg + len));
+        }while(!delayMs && mergeable);
+        if(IICHOST_Transfer(bus, "RunInitTable", first->addr, first->reg, len, burst, 0))
+            return first - table + 1;
+        if(delayMs)
+            IICHOST_Advance((uint64_t)delayMs * 1000000);
+    }
+    return 0;
+}
+
+uint8_t IIC_QueuePush(IIC_BusTypedef *bus, IIC_TransferTypedef *transfer)
+{
+    uint8_t p = transfer->priority < IIC_PRIORITIES ? transfer->priority : IIC_PRIORITY_LOW;
+    if(bus->queueCount[p] >= IIC_QUEUE_SIZE)
+    {
+        bus->stats[p].rejected++;
+        return 1;
+    }
+    transfer->submitCycles = IICHOST_Cycles(iicNow);
+    bus->queue[p][(bus->queueHead[p] + bus->queueCount[p]) % IIC_QUEUE_SIZE] = transfer;
+    bus->queueCount[p]++;
+    bus->stats[p].submitted++;
+    if(bus->queueCount[p] > bus->stats[p].maxDepth)
+        bus->stats[p].maxDepth = bus->queueCount[p];
+    return 0;
+}
+
+IIC_TransferTypedef *IIC_QueuePop(IIC_BusTypedef *bus)
+{
+    IIC_TransferTypedef *transfer;
+    uint32_t wait;
+    uint8_t p;
+    for(p = 0; p < IIC_PRIORITIES; p++)
+    {
+        if(!bus->queueCount[p])
+            continue;
+        transfer = bus->queue[p][bus->queueHead[p]];
+        bus->queueHead[p] = (bus->queueHead[p] + 1) % IIC_QUEUE_SIZE;
+        bus->queueCount[p]--;
+        wait = IICHOST_Cycles(iicNow) - transfer->submitCycles;
+        bus->stats[p].started++;
+        bus->stats[p].totalWaitCycles += wait;
+        if(wait > bus->stats[p].maxWaitCycles)
+            bus->stats[p].maxWaitCycles = wait;
+        return transfer;
+    }
+    return NULL;
+}
+
+uint8_t IIC_BusSubmit(IIC_BusTypedef *bus, IIC_TransferTypedef *transfer)
+{
+    iicTotals.calls++;
+    transfer->status = IIC_STATUS_PENDING;
+    if(IIC_QueuePush(bus, transfer))
+    {
+        transfer->status = IIC_STATUS_ERROR;
+        return 1;
+    }
+    iicPendSV = 1;
+    return 0;
+}
+
+void IIC_BusGetStatistics(IIC_BusTypedef *bus, IIC_PriorityTypedef priority, IIC_QueueStatisticsTypedef *stats)
+{
+    if(priority >= IIC_PRIORITIES)
+        return;
+    *stats = bus->stats[priority];
+    stats->depth = bus->queueCount[priority];
+}
+
+void IIC_BusResetStatistics(IIC_BusTypedef *bus)
+{
+    uint8_t p;
+    for(p = 0; p < IIC_PRIORITIES; p++)
+    {
+        memset(&bus->stats[p], 0, sizeof(bus->stats[p]));
+        bus->stats[p].maxDepth = bus->queueCount[p];
+    }
+}
+
+void IICHOST_RunBackground(void)
+{
+    IIC_TransferTypedef *transfer;
+    uint8_t i, res;
+    if(iicInBackground)
+        return;//PendSVǶ
+    iicInBackground = 1;
+    while(iicPendSV)
+    {
+        iicPendSV = 0;
+        for(i = 0; i < iicBusCount; i++)
+        {
+            while((transfer = IIC_QueuePop(iicBuses[i])) != NULL)
+            {
+                if(transfer->isRead && transfer->segments)
+                    res = IICHOST_Scatter(iicBuses[i], "Submit", transfer->addr, transfer->reg, transfer->segments, transfer->segmentCount);
+                else
+                    res = IICHOST_Transfer(iicBuses[i], "Submit", transfer->addr, transfer->reg, transfer->len, transfer->data, transfer->isRead);
+                transfer->status = res ? IIC_STATUS_ERROR : IIC_STATUS_OK;
+                if(transfer->callback)
+                    transfer->callback(transfer);
+            }
+        }
+    }
+    iicInBackground = 0;
+}
+
+void IICHOST_GetTotals(IICHOST_TotalsTypedef *totals)
+{
+    *totals = iicTotals;
+}
+
+void IICHOST_ResetStatistics(void)
+{
+    uint8_t i;
+    iicSiteCount = 0;
+    memset(iicSites, 0, sizeof(iicSites));
+    memset(&iicTotals, 0, sizeof(iicTotals));
+    for(i = 0; i < iicBusCount; i++)
+        IIC_BusResetStatistics(iicBuses[i]);
+}
+
+/**
+ * @brief ʱӶൽ
+ */
+static int IICHOST_CompareSites(const void *a, const void *b)
+{
+    const Site *x = a, *y = b;
+    return x->busNs < y->busNs ? 1 : x->busNs > y->busNs ? -1 : 0;
+}
+
+static const char *IICHOST_RegName(uint8_t addr, uint8_t reg)
+{
+    static char name[8];
+    uint16_t i;
+    for(i = 0; i < sizeof(iicRegNames) / sizeof(iicRegNames[0]); i++)
+    {
+        if(iicRegNames[i].addr == addr && iicRegNames[i].reg == reg)
+            return iicRegNames[i].name;
+    }
+    snprintf(name, sizeof(name), "0x%02X", reg);
+    return name;
+}
+
+void IICHOST_PrintStatistics(const char *title)
+{
+    uint16_t i;
+    printf("\n%s\n", title);
+    printf("%-18s %-5s %-15s %-3s %9s %7s %10s %12s %10s\n",
+        "api", "dev", "register", "dir", "transfers", "errors", "bytes", "bus time us", "avg us");
+    qsort(iicSites, iicSiteCount, sizeof(Site), IICHOST_CompareSites);
+    for(i = 0; i < iicSiteCount; i++)
+    {
+        printf("%-18s 0x%02X  %-15s %-3s %9u %7u %10llu %12.1f %10.1f\n",
+            iicSites[i].api, iicSites[i].addr, IICHOST_RegName(iicSites[i].addr, iicSites[i].reg),
+            iicSites[i].isRead ? "R" : "W", iicSites[i].transfers, iicSites[i].errors,
+            (unsigned long long)iicSites[i].bytes, iicSites[i].busNs / 1e3,
+            iicSites[i].busNs / 1e3 / iicSites[i].transfers);
+    }
+    printf("%-18s %-5s %-15s %-3s %9u %7u %10llu %12.1f\n", "total", "", "", "",
+        iicTotals.transfers, iicTotals.errors, (unsigned long long)iicTotals.bytes, iicTotals.busNs / 1e3);
+}
+
+//delay.h, ʱֻƽģʱ
+void delay_init(u8 SYSCLK)
+{
+    (void)SYSCLK;
+}
+
+void delay_ms(u16 nms)
+{
+    IICHOST_Advance((uint64_t)nms * 1000000);
+}
+
+void delay_us(u32 nus)
+{
+    IICHOST_Advance((uint64_t)nus * 1000);
+}
+
+//sys.h, û
+void RCC_AHB1PeriphClockCmd(uint32_t periph, FunctionalState state)
+{
+    (void)periph;
+    (void)state;
+}
+
+void RCC_APB2PeriphClockCmd(uint32_t periph, FunctionalState state)
+{
+    (void)periph;
+    (void)state;
+}
+
+void GPIO_Init(GPIO_TypeDef *port, GPIO_InitTypeDef *init)
+{
+    (void)port;
+    (void)init;
+}
+
+void SYSCFG_EXTILineConfig(uint8_t portSource, uint8_t pinSource)
+{
+    (void)portSource;
+    (void)pinSource;
+}
+
+void EXTI_Init(EXTI_InitTypeDef *init)
+{
+    (void)init;
+}
+
+ITStatus EXTI_GetITStatus(uint32_t line)
+{
+    (void)line;
+    return SET;//ֻģͲжʱŵжϷ
+}
+
+void EXTI_ClearITPendingBit(uint32_t line)
+{
+    (void)line;
+}
+
+void NVIC_Init(NVIC_InitTypeDef *init)
+{
+    (void)init;
+}
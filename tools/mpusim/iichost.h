@@ -0,0 +1,78 @@
+/**
+ * @file    iichost.h
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2026/10/16
+ * @brief
+ *          Host implementation of the bsp_iic.h API for mpusim:
+ *              1. Transfers go to the MPU model instead of GPIO or I2C1
+ *              2. Simulated clock advanced by bus time and delay_xx
+ *              3. Asynchronous queue and PendSV emulated by IICHOST_RunBackground
+ *              4. Calls, bytes and bus time per API and register
+ * @note
+ *          Minimum version of source file:
+ *              0.1.0
+ *          Bus time is counted from the bits on the wire at bus->speed:
+ *          9 bits per byte plus start, repeated start and stop. Clock
+ *          stretching and CPU time between transfers are not modelled.
+ *          The bit level functions (IIC_Start, IIC_WriteByte, ...) are not
+ *          provided.
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#ifndef __IICHOST_H
+#define __IICHOST_H
+#include "bsp_iic.h"
+
+#define IICHOST_CORE_CLOCK          168000000//еȴõƵ
+#define IICHOST_MAX_SITES           128//ͳƵĵõ
+
+/**
+ * @brief ϵۼ
+ */
+typedef struct {
+    uint32_t calls;//ӿڵĵô
+    uint32_t transfers;//ʼֹͣĴ
+    uint32_t errors;//ӦĴ
+    uint64_t bytes;//ϵֽ, ַͼĴַ
+    uint64_t dataBytes;//ֽ
+    uint64_t busNs;//ռʱ(ns)
+}IICHOST_TotalsTypedef;
+
+/**
+ * @brief ǰģʱ
+ * @return ģʱ(ns)
+ */
+uint64_t IICHOST_Now(void);
+/**
+ * @brief CPUеָʱ, ڼģͼ
+ * @param until ģʱ(ns), ڵǰʱʱ
+ */
+void IICHOST_Idle(uint64_t until);
+/**
+ * @brief ִһPendSV: ȼߵ첽вûص
+ * @note صύĴҲڱε
+ */
+void IICHOST_RunBackground(void);
+/**
+ * @brief ȡۼ
+ */
+void IICHOST_GetTotals(IICHOST_TotalsTypedef *totals);
+/**
+ * @brief õͳƺۼ
+ */
+void IICHOST_ResetStatistics(void);
+/**
+ * @brief ӡõĵô, ֽʱ
+ * @param title 
+ */
+void IICHOST_PrintStatistics(const char *title);
+
+#endif
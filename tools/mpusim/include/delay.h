@@ -0,0 +1,27 @@
+/**
+ * @file    delay.h
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2026/10/16
+ * @brief
+ *          Host replacement of system/delay.h for mpusim.
+ *          The delays advance the simulated clock instead of waiting.
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#ifndef __DELAY_H
+#define __DELAY_H
+#include <sys.h>
+
+void delay_init(u8 SYSCLK);
+void delay_ms(u16 nms);
+void delay_us(u32 nus);
+
+#endif
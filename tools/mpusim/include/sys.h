@@ -0,0 +1,104 @@
+/**
+ * @file    sys.h
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2026/10/16
+ * @brief
+ *          Host replacement of system/sys.h for mpusim.
+ *          Provides the types, constants and StdPeriph functions that
+ *          bsp_iic.h and the MPU drivers use, nothing else.
+ * @note
+ *          Put tools/mpusim/include in front of the include path so that
+ *          "sys.h" and "delay.h" resolve here instead of system/.
+ *          The peripheral functions are implemented as no-ops in iichost.c.
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#ifndef __SYS_H
+#define __SYS_H
+#include <stdint.h>
+
+#define __IO    volatile
+
+typedef uint32_t  u32;
+typedef uint16_t u16;
+typedef uint8_t  u8;
+
+typedef enum {RESET = 0, SET = !RESET} FlagStatus, ITStatus;
+typedef enum {DISABLE = 0, ENABLE = !DISABLE} FunctionalState;
+
+/**
+ * @brief GPIO˿, ֲֻͬĶ˿
+ */
+typedef struct {
+    uint32_t index;
+}GPIO_TypeDef;
+extern GPIO_TypeDef SIM_GpioPorts[9];
+#define GPIOA                       (&SIM_GpioPorts[0])
+#define GPIOB                       (&SIM_GpioPorts[1])
+#define GPIOC                       (&SIM_GpioPorts[2])
+#define GPIOD                       (&SIM_GpioPorts[3])
+#define GPIOE                       (&SIM_GpioPorts[4])
+
+#define GPIO_Pin_8                  ((uint16_t)0x0100)
+#define GPIO_Pin_9                  ((uint16_t)0x0200)
+#define GPIO_Mode_IN                0x00
+#define GPIO_High_Speed             0x03
+#define GPIO_PuPd_DOWN              0x02
+#define RCC_AHB1Periph_GPIOB        ((uint32_t)0x00000002)
+#define RCC_AHB1Periph_GPIOD        ((uint32_t)0x00000008)
+#define RCC_APB2Periph_SYSCFG       ((uint32_t)0x00004000)
+#define EXTI_PortSourceGPIOD        ((uint8_t)0x03)
+#define EXTI_PinSource8             ((uint8_t)0x08)
+#define EXTI_Line8                  ((uint32_t)0x00100)
+#define EXTI_Mode_Interrupt         0x00
+#define EXTI_Trigger_Rising         0x08
+#define EXTI9_5_IRQn                23
+#define PendSV_IRQn                 (-2)
+
+typedef struct {
+    uint32_t GPIO_Pin;
+    uint32_t GPIO_Mode;
+    uint32_t GPIO_Speed;
+    uint32_t GPIO_OType;
+    uint32_t GPIO_PuPd;
+}GPIO_InitTypeDef;
+
+typedef struct {
+    uint32_t EXTI_Line;
+    uint32_t EXTI_Mode;
+    uint32_t EXTI_Trigger;
+    FunctionalState EXTI_LineCmd;
+}EXTI_InitTypeDef;
+
+typedef struct {
+    uint8_t NVIC_IRQChannel;
+    uint8_t NVIC_IRQChannelPreemptionPriority;
+    uint8_t NVIC_IRQChannelSubPriority;
+    FunctionalState NVIC_IRQChannelCmd;
+}NVIC_InitTypeDef;
+
+void RCC_AHB1PeriphClockCmd(uint32_t periph, FunctionalState state);
+void RCC_APB2PeriphClockCmd(uint32_t periph, FunctionalState state);
+void GPIO_Init(GPIO_TypeDef *port, GPIO_InitTypeDef *init);
+void SYSCFG_EXTILineConfig(uint8_t portSource, uint8_t pinSource);
+void EXTI_Init(EXTI_InitTypeDef *init);
+ITStatus EXTI_GetITStatus(uint32_t line);
+void EXTI_ClearITPendingBit(uint32_t line);
+void NVIC_Init(NVIC_InitTypeDef *init);
+
+/**
+ * @brief ûж, ٽʲôҲ
+ */
+static inline uint32_t __get_PRIMASK(void) { return 0; }
+static inline void __set_PRIMASK(uint32_t primask) { (void)primask; }
+static inline void __disable_irq(void) {}
+
+#endif
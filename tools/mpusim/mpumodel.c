@@ -0,0 +1,715 @@
+/**
+ * @file    mpumodel.c
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2026/10/16
+ * @brief
+ *          Software model of an MPU6050 or MPU9250 on the IIC bus:
+ *              1. Register file with burst auto-increment, reset and sleep
+ *              2. DMP memory banks, firmware start address and verify reads
+ *              3. 1024-byte FIFO fed by raw samples or by DMP packets
+ *              4. Self-test response and an AK8963 behind the MPU9250
+ *              5. Rigid body motion driving accel, gyro, compass and quaternion
+ * @note
+ *          Minimum version of header file:
+ *              0.1.0
+ *          The DMP is not executed. When it is enabled the model writes
+ *          packets at the rate and with the layout the motion driver has
+ *          programmed into DMP memory, the quaternion is the true attitude.
+ *          Factory self-test codes read as 0, so the drivers check the
+ *          self-test response against the absolute limits.
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#include "mpumodel.h"
+#include <string.h>
+#include <math.h>
+
+#define REG_SAMPLE_RATE             0x19
+#define REG_CFG                     0x1A
+#define REG_GYRO_CFG                0x1B
+#define REG_ACCEL_CFG               0x1C
+#define REG_FIFO_EN                 0x23
+#define REG_I2CSLV0_ADDR            0x25
+#define REG_INTBP_CFG               0x37
+#define REG_INT_EN                  0x38
+#define REG_INT_STA                 0x3A
+#define REG_ACCEL_XOUTH             0x3B
+#define REG_TEMP_OUTH               0x41
+#define REG_GYRO_XOUTH              0x43
+#define REG_EXT_SENS_DATA           0x49
+#define REG_EXT_SENS_DATA_END       0x60
+#define REG_I2CSLV0_DO              0x63
+#define REG_USER_CTRL               0x6A
+#define REG_PWR_MGMT1               0x6B
+#define REG_BANK_SEL                0x6D
+#define REG_MEM_START               0x6E
+#define REG_MEM_RW                  0x6F
+#define REG_PRGM_START_L            0x71
+#define REG_FIFO_CNTH               0x72
+#define REG_FIFO_CNTL               0x73
+#define REG_FIFO_RW                 0x74
+#define REG_WHO_AM_I                0x75
+
+#define PWR1_RESET                  0x80
+#define PWR1_SLEEP                  0x40
+#define USER_DMP_EN                 0x80
+#define USER_FIFO_EN                0x40
+#define USER_I2C_MST_EN             0x20
+#define USER_FIFO_RST               0x04
+#define USER_RESET_BITS             0x0F//Զĸλλ
+#define INT_DATA_RDY                0x01
+#define INT_DMP                     0x02
+#define INT_FIFO_OFLOW              0x10
+#define INTBP_BYPASS_EN             0x02
+
+//DMPڴе, inv_mpu_dmp_motion_driver.cͬ
+#define DMP_D_0_22                  (22 + 512)//FIFOʷƵ
+#define DMP_CFG_LP_QUAT             2712
+#define DMP_CFG_8                   2718//6Ԫ
+#define DMP_CFG_15                  2727//ԭʼٶ/
+#define DMP_CFG_27                  2742//
+#define DMP_SAMPLE_RATE             200
+
+#define AK_REG_WIA                  0x00
+#define AK_REG_ST1                  0x02
+#define AK_REG_HXL                  0x03
+#define AK_REG_ST2                  0x09
+#define AK_REG_CNTL1                0x0A
+#define AK_REG_CNTL2                0x0B
+#define AK_REG_ASAX                 0x10
+#define AK_REGS                     0x13
+#define AK_MODE_SINGLE              0x01
+#define AK_MODE_SELF_TEST           0x08
+#define AK_MODE_FUSE_ROM            0x0F
+
+#define SELF_TEST_G                 0.5//Լʱٶȵƫ(g)
+#define SELF_TEST_DPS               80.0//Լʱǵƫ(/s)
+#define TEMPERATURE                 25.0
+#define PACKET_HISTORY              256
+#define NEVER                       UINT64_MAX
+
+/**
+ * @brief FIFOһDMPݰλúʱ̬
+ */
+typedef struct {
+    uint64_t start;//һֽڵۼ
+    uint64_t end;
+    uint64_t time;//дFIFOʱ
+    double quat[4];
+}Packet;
+
+static struct {
+    MPUMODEL_ConfigTypedef config;
+    uint64_t now;
+    uint64_t resetEnd;
+    uint64_t nextSample;
+    uint64_t nextPacket;
+    uint8_t regs[128];
+    uint8_t mem[MPUMODEL_MEM_SIZE];
+    uint8_t dmpLoaded;
+    //FIFO, ֽڰۼż¼, жDMPݰǷ
+    uint8_t fifo[MPUMODEL_FIFO_SIZE];
+    uint16_t fifoHead;
+    uint16_t fifoCount;
+    uint64_t fifoPushed;
+    uint64_t fifoRemoved;
+    uint64_t fifoDroppedTo;//֮ǰֽڱ
+    Packet packets[PACKET_HISTORY];
+    uint16_t packetHead;
+    uint16_t packetCount;
+    Packet readPacket;//һݰ
+    uint8_t hasReadPacket;
+    //˶
+    double quat[4];
+    double rate[3];//rad/s
+    uint8_t interrupt;
+    //AK8963
+    uint8_t ak[AK_REGS];
+    MPUMODEL_StatisticsTypedef stats;
+}model;
+
+/**
+ * @brief ̬ǰٶȻֵָʱ
+ */
+static void MPUMODEL_Integrate(uint64_t time)
+{
+    double dt = (time - model.now) * 1e-9;
+    double w = sqrt(model.rate[0] * model.rate[0] + model.rate[1] * model.rate[1] + model.rate[2] * model.rate[2]);
+    double s, d[4], *q = model.quat, n;
+    model.now = time;
+    if(w * dt == 0.0)
+        return;
+    s = sin(w * dt / 2) / w;
+    d[0] = cos(w * dt / 2);
+    d[1] = model.rate[0] * s;
+    d[2] = model.rate[1] * s;
+    d[3] = model.rate[2] * s;
+    //q = q * d, ٶڻϵ
+    double r[4] = {
+        q[0] * d[0] - q[1] * d[1] - q[2] * d[2] - q[3] * d[3],
+        q[0] * d[1] + q[1] * d[0] + q[2] * d[3] - q[3] * d[2],
+        q[0] * d[2] - q[1] * d[3] + q[2] * d[0] + q[3] * d[1],
+        q[0] * d[3] + q[1] * d[2] - q[2] * d[1] + q[3] * d[0]};
+    n = sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2] + r[3] * r[3]);
+    q[0] = r[0] / n;
+    q[1] = r[1] / n;
+    q[2] = r[2] / n;
+    q[3] = r[3] / n;
+}
+
+/**
+ * @brief ϵתϵ
+ */
+static void MPUMODEL_ToBody(const double world[3], double body[3])
+{
+    double w = model.quat[0], x = model.quat[1], y = model.quat[2], z = model.quat[3];
+    double r[3][3] = {
+        {1 - 2 * (y * y + z * z), 2 * (x * y - w * z), 2 * (x * z + w * y)},
+        {2 * (x * y + w * z), 1 - 2 * (x * x + z * z), 2 * (y * z - w * x)},
+        {2 * (x * z - w * y), 2 * (y * z + w * x), 1 - 2 * (x * x + y * y)}};
+    uint8_t i;
+    for(i = 0; i < 3; i++)
+        body[i] = r[0][i] * world[0] + r[1][i] * world[1] + r[2][i] * world[2];
+}
+
+static int16_t MPUMODEL_Saturate(double value)
+{
+    if(value > 32767.0)
+        return 32767;
+    if(value < -32768.0)
+        return -32768;
+    return (int16_t)lrint(value);
+}
+
+static void MPUMODEL_Put16(uint8_t *data, int16_t value)
+{
+    data[0] = (uint16_t)value >> 8;
+    data[1] = (uint16_t)value & 0xFF;
+}
+
+/**
+ * @brief ǰ̺Լλٶȼƺǵԭʼֵ
+ */
+static void MPUMODEL_Measure(int16_t accel[3], int16_t gyro[3])
+{
+    static const double gravity[3] = {0.0, 0.0, 1.0};
+    double g[3], accelLsb, gyroLsb;
+    uint8_t i;
+    MPUMODEL_ToBody(gravity, g);
+    accelLsb = 16384.0 / (1 << ((model.regs[REG_ACCEL_CFG] >> 3) & 3));
+    gyroLsb = 32768.0 / 250.0 / (1 << ((model.regs[REG_GYRO_CFG] >> 3) & 3));
+    for(i = 0; i < 3; i++)
+    {
+        if(model.regs[REG_ACCEL_CFG] & (0x80 >> i))
+            g[i] += SELF_TEST_G;
+        accel[i] = MPUMODEL_Saturate(g[i] * accelLsb);
+        gyro[i] = MPUMODEL_Saturate((model.rate[i] * 180.0 / M_PI + ((model.regs[REG_GYRO_CFG] & (0x80 >> i)) ? SELF_TEST_DPS : 0.0)) * gyroLsb);
+    }
+}
+
+/**
+ * @brief ֽں, Ѿ뿪FIFODMPݰ
+ */
+static void MPUMODEL_RetirePackets(void)
+{
+    Packet *packet;
+    while(model.packetCount)
+    {
+        packet = &model.packets[model.packetHead];
+        if(packet->end > model.fifoRemoved)
+            break;
+        if(packet->start >= model.fifoDroppedTo)
+        {
+            model.readPacket = *packet;
+            model.hasReadPacket = 1;
+            model.stats.packetsRead++;
+        }
+        else
+            model.stats.packetsDropped++;
+        model.packetHead = (model.packetHead + 1) % PACKET_HISTORY;
+        model.packetCount--;
+    }
+}
+
+static void MPUMODEL_Pulse(uint8_t source)
+{
+    model.regs[REG_INT_STA] |= source;
+    if(model.regs[REG_INT_EN] & source)
+    {
+        model.interrupt = 1;
+        model.stats.interrupts++;
+    }
+}
+
+/**
+ * @brief дFIFO, ˾Ͷֽ
+ */
+static void MPUMODEL_FifoPush(const uint8_t *data, uint16_t len)
+{
+    uint8_t overflow = 0;
+    while(len--)
+    {
+        if(model.fifoCount == MPUMODEL_FIFO_SIZE)
+        {
+            model.fifoHead = (model.fifoHead + 1) % MPUMODEL_FIFO_SIZE;
+            model.fifoCount--;
+            model.fifoRemoved++;
+            model.fifoDroppedTo = model.fifoRemoved;
+            overflow = 1;
+        }
+        model.fifo[(model.fifoHead + model.fifoCount) % MPUMODEL_FIFO_SIZE] = *data++;
+        model.fifoCount++;
+        model.fifoPushed++;
+    }
+    if(model.fifoCount > model.stats.maxFifoCount)
+        model.stats.maxFifoCount = model.fifoCount;
+    if(overflow)
+    {
+        model.stats.overflows++;
+        MPUMODEL_RetirePackets();
+        MPUMODEL_Pulse(INT_FIFO_OFLOW);
+    }
+}
+
+static uint8_t MPUMODEL_FifoPop(void)
+{
+    uint8_t data;
+    if(!model.fifoCount)
+        return 0;
+    data = model.fifo[model.fifoHead];
+    model.fifoHead = (model.fifoHead + 1) % MPUMODEL_FIFO_SIZE;
+    model.fifoCount--;
+    model.fifoRemoved++;
+    MPUMODEL_RetirePackets();
+    return data;
+}
+
+static void MPUMODEL_FifoReset(void)
+{
+    model.fifoRemoved += model.fifoCount;
+    model.fifoDroppedTo = model.fifoRemoved;
+    model.fifoHead = 0;
+    model.fifoCount = 0;
+    MPUMODEL_RetirePackets();
+}
+
+/**
+ * @brief AK8963һ, شų̶ϵ
+ */
+static void MPUMODEL_AkMeasure(uint8_t selfTest)
+{
+    static const double field[3] = {20.0, 0.0, -40.0};//uT
+    double b[3];
+    int16_t value;
+    uint8_t i;
+    MPUMODEL_ToBody(field, b);
+    for(i = 0; i < 3; i++)
+    {
+        value = selfTest ? (i == 2 ? -1500 : 10) : MPUMODEL_Saturate(b[i] / 0.15);//16λ0.15uT/LSB
+        model.ak[AK_REG_HXL + 2 * i] = (uint16_t)value & 0xFF;
+        model.ak[AK_REG_HXL + 2 * i + 1] = (uint16_t)value >> 8;
+    }
+    model.ak[AK_REG_ST1] |= 0x01;
+    model.ak[AK_REG_ST2] = model.ak[AK_REG_CNTL1] & 0x10;
+    model.ak[AK_REG_CNTL1] &= 0x10;//βԼɺصģʽ
+}
+
+static void MPUMODEL_AkReset(void)
+{
+    memset(model.ak, 0, sizeof(model.ak));
+    model.ak[AK_REG_WIA] = 0x48;
+    model.ak[AK_REG_ASAX] = model.ak[AK_REG_ASAX + 1] = model.ak[AK_REG_ASAX + 2] = 128;//ȵϵ1.0
+}
+
+static void MPUMODEL_AkRead(uint8_t reg, uint8_t *data, uint16_t len)
+{
+    while(len--)
+    {
+        *data++ = reg < AK_REGS ? model.ak[reg] : 0;
+        if(reg == AK_REG_ST2)
+            model.ak[AK_REG_ST1] &= ~0x01;//ST2һζȡ
+        reg++;
+    }
+}
+
+static void MPUMODEL_AkWrite(uint8_t reg, const uint8_t *data, uint16_t len)
+{
+    while(len--)
+    {
+        if(reg == AK_REG_CNTL1)
+        {
+            model.ak[reg] = *data;
+            if((*data & 0x0F) == AK_MODE_SINGLE || (*data & 0x0F) == AK_MODE_SELF_TEST)
+                MPUMODEL_AkMeasure((*data & 0x0F) == AK_MODE_SELF_TEST);
+        }
+        else if(reg == AK_REG_CNTL2 && (*data & 0x01))
+            MPUMODEL_AkReset();
+        else if(reg > AK_REG_ST2 && reg < AK_REG_ASAX)
+            model.ak[reg] = *data;
+        data++;
+        reg++;
+    }
+}
+
+/**
+ * @brief IICģʽ, ÿβִдӻ0~3
+ */
+static void MPUMODEL_RunSlaves(void)
+{
+    uint8_t i, addr, reg, ctrl, ext = REG_EXT_SENS_DATA, len;
+    for(i = 0; i < 4; i++)
+    {
+        addr = model.regs[REG_I2CSLV0_ADDR + 3 * i];
+        reg = model.regs[REG_I2CSLV0_ADDR + 3 * i + 1];
+        ctrl = model.regs[REG_I2CSLV0_ADDR + 3 * i + 2];
+        if(!(ctrl & 0x80) || (addr & 0x7F) != MPUMODEL_AK8963_ADDR || model.config.device != MPUMODEL_MPU9250)
+            continue;
+        if(addr & 0x80)
+        {
+            len = ctrl & 0x0F;
+            if(ext + len > REG_EXT_SENS_DATA_END)
+                len = REG_EXT_SENS_DATA_END - ext;
+            MPUMODEL_AkRead(reg, &model.regs[ext], len);
+            ext += len;
+        }
+        else
+            MPUMODEL_AkWrite(reg, &model.regs[REG_I2CSLV0_DO + i], 1);
+    }
+}
+
+/**
+ * @brief һԭʼ: Ĵ, FIFO_ENдFIFO
+ */
+static void MPUMODEL_Sample(void)
+{
+    int16_t accel[3], gyro[3], temp;
+    uint8_t data[14], len = 0, i;
+    uint8_t fifoEnable = model.regs[REG_FIFO_EN];
+    MPUMODEL_Measure(accel, gyro);
+    if(model.config.device == MPUMODEL_MPU9250)
+        temp = MPUMODEL_Saturate((TEMPERATURE - 21.0) * 321.0);
+    else
+        temp = MPUMODEL_Saturate((TEMPERATURE - 35.0) * 340.0 - 521.0);
+    for(i = 0; i < 3; i++)
+    {
+        MPUMODEL_Put16(&model.regs[REG_ACCEL_XOUTH + 2 * i], accel[i]);
+        MPUMODEL_Put16(&model.regs[REG_GYRO_XOUTH + 2 * i], gyro[i]);
+    }
+    MPUMODEL_Put16(&model.regs[REG_TEMP_OUTH], temp);
+    model.stats.samples++;
+    if(model.regs[REG_USER_CTRL] & USER_I2C_MST_EN)
+        MPUMODEL_RunSlaves();
+    if((model.regs[REG_USER_CTRL] & (USER_FIFO_EN | USER_DMP_EN)) == USER_FIFO_EN && fifoEnable)
+    {
+        //д˳Ĵַ˳ͬ
+        if(fifoEnable & 0x08)
+            for(i = 0; i < 3; i++, len += 2)
+                MPUMODEL_Put16(&data[len], accel[i]);
+        if(fifoEnable & 0x80)
+            MPUMODEL_Put16(&data[len], temp), len += 2;
+        for(i = 0; i < 3; i++)
+            if(fifoEnable & (0x40 >> i))
+                MPUMODEL_Put16(&data[len], gyro[i]), len += 2;
+        MPUMODEL_FifoPush(data, len);
+    }
+    MPUMODEL_Pulse(INT_DATA_RDY);
+}
+
+/**
+ * @brief DMPһݰ, ʽmotion driverдDMPڴþ
+ */
+static void MPUMODEL_Packet(void)
+{
+    int16_t accel[3], gyro[3];
+    uint8_t data[32], len = 0, i;
+    int32_t q;
+    Packet *packet;
+    MPUMODEL_Measure(accel, gyro);
+    if(model.mem[DMP_CFG_LP_QUAT] == 0xC0 || model.mem[DMP_CFG_8] == 0x20)
+    {
+        for(i = 0; i < 4; i++, len += 4)
+        {
+            q = (int32_t)lrint(model.quat[i] * 1073741824.0);//q30
+            data[len] = (uint32_t)q >> 24;
+            data[len + 1] = ((uint32_t)q >> 16) & 0xFF;
+            data[len + 2] = ((uint32_t)q >> 8) & 0xFF;
+            data[len + 3] = (uint32_t)q & 0xFF;
+        }
+    }
+    if(model.mem[DMP_CFG_15 + 1] == 0xC0)
+        for(i = 0; i < 3; i++, len += 2)
+            MPUMODEL_Put16(&data[len], accel[i]);
+    if(model.mem[DMP_CFG_15 + 4] == 0xC4)
+        for(i = 0; i < 3; i++, len += 2)
+            MPUMODEL_Put16(&data[len], gyro[i]);
+    if(model.mem[DMP_CFG_27] == 0x20)
+        for(i = 0; i < 4; i++)
+            data[len++] = 0;//û
+    if(!len)
+        return;
+    if(model.packetCount == PACKET_HISTORY)
+    {
+        model.packetHead = (model.packetHead + 1) % PACKET_HISTORY;
+        model.packetCount--;
+    }
+    packet = &model.packets[(model.packetHead + model.packetCount) % PACKET_HISTORY];
+    packet->start = model.fifoPushed;
+    packet->end = model.fifoPushed + len;
+    packet->time = model.now;
+    memcpy(packet->quat, model.quat, sizeof(packet->quat));
+    model.packetCount++;
+    model.stats.packets++;
+    MPUMODEL_FifoPush(data, len);
+    MPUMODEL_Pulse(INT_DMP);
+}
+
+static uint64_t MPUMODEL_SamplePeriod(void)
+{
+    uint8_t lpf = model.regs[REG_CFG] & 0x07;
+    uint32_t base = (lpf == 0 || lpf == 7) ? 8000 : 1000;
+    return 1000000000ULL * (model.regs[REG_SAMPLE_RATE] + 1) / base;
+}
+
+static uint64_t MPUMODEL_PacketPeriod(void)
+{
+    uint16_t div;
+    if(model.config.dmpRate)
+        return 1000000000ULL / model.config.dmpRate;
+    div = ((uint16_t)model.mem[DMP_D_0_22] << 8) | model.mem[DMP_D_0_22 + 1];
+    return 1000000000ULL * (div + 1) / DMP_SAMPLE_RATE;
+}
+
+/**
+ * @brief Ĵı°ŲDMPݰ
+ */
+static void MPUMODEL_Schedule(void)
+{
+    uint8_t awake = !(model.regs[REG_PWR_MGMT1] & PWR1_SLEEP) && model.now >= model.resetEnd;
+    if(!awake)
+        model.nextSample = NEVER;
+    else if(model.nextSample == NEVER)
+        model.nextSample = model.now + MPUMODEL_SamplePeriod();
+    if(!awake || !model.dmpLoaded || (model.regs[REG_USER_CTRL] & (USER_DMP_EN | USER_FIFO_EN)) != (USER_DMP_EN | USER_FIFO_EN))
+        model.nextPacket = NEVER;
+    else if(model.nextPacket == NEVER)
+        model.nextPacket = model.now + MPUMODEL_PacketPeriod();
+}
+
+/**
+ * @brief λмĴ, ˯
+ */
+static void MPUMODEL_Reset(void)
+{
+    memset(model.regs, 0, sizeof(model.regs));
+    memset(model.mem, 0, sizeof(model.mem));
+    model.regs[REG_PWR_MGMT1] = PWR1_SLEEP;
+    model.regs[REG_WHO_AM_I] = model.config.device == MPUMODEL_MPU9250 ? 0x71 : 0x68;
+    model.dmpLoaded = 0;
+    MPUMODEL_FifoReset();
+    MPUMODEL_AkReset();
+    model.nextSample = NEVER;
+    model.nextPacket = NEVER;
+}
+
+void MPUMODEL_Init(const MPUMODEL_ConfigTypedef *config)
+{
+    memset(&model, 0, sizeof(model));
+    model.config = *config;
+    model.quat[0] = 1.0;
+    MPUMODEL_Reset();
+}
+
+void MPUMODEL_SetRate(const double dps[3])
+{
+    uint8_t i;
+    for(i = 0; i < 3; i++)
+        model.rate[i] = dps[i] * M_PI / 180.0;
+}
+
+void MPUMODEL_Advance(uint64_t now)
+{
+    uint64_t time;
+    while(1)
+    {
+        time = model.nextSample < model.nextPacket ? model.nextSample : model.nextPacket;
+        if(time > now)
+            break;
+        MPUMODEL_Integrate(time);
+        if(time == model.nextSample)
+        {
+            MPUMODEL_Sample();
+            model.nextSample += MPUMODEL_SamplePeriod();
+        }
+        if(time == model.nextPacket)
+        {
+            MPUMODEL_Packet();
+            model.nextPacket += MPUMODEL_PacketPeriod();
+        }
+    }
+    MPUMODEL_Integrate(now);
+}
+
+uint64_t MPUMODEL_NextEvent()
+{
+    return model.nextSample < model.nextPacket ? model.nextSample : model.nextPacket;
+}
+
+/**
+ * @brief ǷӦַ
+ */
+static uint8_t MPUMODEL_Acknowledge(uint8_t addr)
+{
+    if(model.now < model.resetEnd)
+        return 0;
+    if(addr == MPUMODEL_ADDR)
+        return 1;
+    return addr == MPUMODEL_AK8963_ADDR && model.config.device == MPUMODEL_MPU9250
+        && (model.regs[REG_INTBP_CFG] & INTBP_BYPASS_EN) && !(model.regs[REG_USER_CTRL] & USER_I2C_MST_EN);
+}
+
+static uint16_t MPUMODEL_MemAddress(void)
+{
+    return ((uint16_t)model.regs[REG_BANK_SEL] << 8 | model.regs[REG_MEM_START]) % MPUMODEL_MEM_SIZE;
+}
+
+uint8_t MPUMODEL_Write(uint8_t addr, uint8_t reg, const uint8_t *data, uint16_t len)
+{
+    if(!MPUMODEL_Acknowledge(addr))
+    {
+        model.stats.nacks++;
+        return 1;
+    }
+    if(addr == MPUMODEL_AK8963_ADDR)
+    {
+        MPUMODEL_AkWrite(reg, data, len);
+        return 0;
+    }
+    for(; len; len--, data++)
+    {
+        switch(reg)
+        {
+        case REG_PWR_MGMT1:
+            if(*data & PWR1_RESET)
+            {
+                MPUMODEL_Reset();
+                model.resetEnd = model.now + model.config.resetUs * 1000ULL;
+                model.stats.resets++;
+                return 0;//λڼ䲻ٽ
+            }
+            model.regs[reg] = *data;
+            break;
+        case REG_USER_CTRL:
+            if(*data & USER_FIFO_RST)
+                MPUMODEL_FifoReset();
+            model.regs[reg] = *data & ~USER_RESET_BITS;
+            break;
+        case REG_MEM_RW:
+            model.mem[MPUMODEL_MemAddress()] = *data;
+            model.regs[REG_MEM_START]++;
+            break;
+        case REG_PRGM_START_L:
+            model.regs[reg] = *data;
+            model.dmpLoaded = 1;
+            break;
+        case REG_FIFO_RW:
+            MPUMODEL_FifoPush(data, 1);
+            break;
+        case REG_INT_STA:
+        case REG_FIFO_CNTH:
+        case REG_FIFO_CNTL:
+        case REG_WHO_AM_I:
+            break;//ֻ
+        default:
+            if(reg < REG_ACCEL_XOUTH || reg > REG_EXT_SENS_DATA_END)
+                model.regs[reg] = *data;
+            break;
+        }
+        if(reg != REG_MEM_RW && reg != REG_FIFO_RW)
+            reg = (reg + 1) & 0x7F;
+    }
+    MPUMODEL_Schedule();
+    return 0;
+}
+
+uint8_t MPUMODEL_Read(uint8_t addr, uint8_t reg, uint8_t *data, uint16_t len)
+{
+    if(!MPUMODEL_Acknowledge(addr))
+    {
+        model.stats.nacks++;
+        return 1;
+    }
+    if(addr == MPUMODEL_AK8963_ADDR)
+    {
+        MPUMODEL_AkRead(reg, data, len);
+        return 0;
+    }
+    for(; len; len--, data++)
+    {
+        switch(reg)
+        {
+        case REG_FIFO_RW:
+            *data = MPUMODEL_FifoPop();
+            break;
+        case REG_MEM_RW:
+            *data = model.mem[MPUMODEL_MemAddress()];
+            model.regs[REG_MEM_START]++;
+            break;
+        case REG_FIFO_CNTH:
+            *data = model.fifoCount >> 8;
+            break;
+        case REG_FIFO_CNTL:
+            *data = model.fifoCount & 0xFF;
+            break;
+        case REG_INT_STA:
+            *data = model.regs[reg];
+            model.regs[reg] = 0;//
+            break;
+        default:
+            *data = model.regs[reg];
+            break;
+        }
+        if(reg != REG_MEM_RW && reg != REG_FIFO_RW)
+            reg = (reg + 1) & 0x7F;
+    }
+    return 0;
+}
+
+uint8_t MPUMODEL_TakeInterrupt()
+{
+    uint8_t interrupt = model.interrupt;
+    model.interrupt = 0;
+    return interrupt;
+}
+
+uint8_t MPUMODEL_GetReadPacket(double quat[4], uint64_t *time)
+{
+    if(!model.hasReadPacket)
+        return 1;
+    memcpy(quat, model.readPacket.quat, sizeof(model.readPacket.quat));
+    *time = model.readPacket.time;
+    return 0;
+}
+
+void MPUMODEL_GetQuaternion(double quat[4])
+{
+    memcpy(quat, model.quat, sizeof(model.quat));
+}
+
+void MPUMODEL_GetStatistics(MPUMODEL_StatisticsTypedef *stats)
+{
+    *stats = model.stats;
+}
+
+void MPUMODEL_ResetStatistics(void)
+{
+    memset(&model.stats, 0, sizeof(model.stats));
+    model.stats.maxFifoCount = model.fifoCount;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file    mpumodel.h
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2026/10/16
+ * @brief
+ *          Software model of an MPU6050 or MPU9250 on the IIC bus:
+ *              1. Register file with burst auto-increment, reset and sleep
+ *              2. DMP memory banks, firmware start address and verify reads
+ *              3. 1024-byte FIFO fed by raw samples or by DMP packets
+ *              4. Self-test response and an AK8963 behind the MPU9250
+ *              5. Rigid body motion driving accel, gyro, compass and quaternion
+ * @note
+ *          Minimum version of source file:
+ *              0.1.0
+ *          Time is in nanoseconds of simulated time, see MPUMODEL_Advance.
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#ifndef __MPUMODEL_H
+#define __MPUMODEL_H
+#include <stdint.h>
+
+#define MPUMODEL_ADDR               0x68
+#define MPUMODEL_AK8963_ADDR        0x0C
+#define MPUMODEL_FIFO_SIZE          1024
+#define MPUMODEL_MEM_SIZE           4096
+
+/**
+ * @brief ģ
+ */
+typedef enum {
+    MPUMODEL_MPU6050 = 0,
+    MPUMODEL_MPU9250//MPU6500 + AK8963
+}MPUMODEL_DeviceTypedef;
+
+/**
+ * @brief ģ
+ */
+typedef struct {
+    MPUMODEL_DeviceTypedef device;
+    uint32_t resetUs;//DEVICE_RESETλΪ1ʱ, ڼӦ
+    uint16_t dmpRate;//DMP(Hz), 0-ʹdmp_set_fifo_rateдDMPڴֵ
+}MPUMODEL_ConfigTypedef;
+
+/**
+ * @brief ģͳ
+ */
+typedef struct {
+    uint32_t samples;//ԭʼ
+    uint32_t packets;//DMPɵݰ
+    uint32_t packetsRead;//ݰ
+    uint32_t packetsDropped;//FIFOλݰ
+    uint32_t overflows;//FIFO
+    uint32_t interrupts;//INT
+    uint32_t nacks;//δӦĴ
+    uint16_t maxFifoCount;//FIFO(ֽ)
+    uint32_t resets;//DEVICE_RESET
+}MPUMODEL_StatisticsTypedef;
+
+/**
+ * @brief ϵ, мĴDMPڴָĬֵ, ̬
+ * @param config ģ
+ */
+void MPUMODEL_Init(const MPUMODEL_ConfigTypedef *config);
+/**
+ * @brief ûϵµĽٶ, ӵǰʱ̿ʼЧ
+ * @param dps x, y, zٶ(/s)
+ */
+void MPUMODEL_SetRate(const double dps[3]);
+/**
+ * @brief ƽָʱ, ڼĲDMPݰдĴFIFO
+ * @param now ģʱ(ns), ܻ
+ */
+void MPUMODEL_Advance(uint64_t now);
+/**
+ * @brief һβDMPݰʱ
+ * @return ģʱ(ns), ûд¼ʱUINT64_MAX
+ */
+uint64_t MPUMODEL_NextEvent(void);
+/**
+ * @brief һIICд: Ĵַlenֽ
+ * @param addr 7λַ
+ * @return 0-Ӧ; 1-ڻڸλ
+ */
+uint8_t MPUMODEL_Write(uint8_t addr, uint8_t reg, const uint8_t *data, uint16_t len);
+/**
+ * @brief һIIC: дĴַظʼ, lenֽ
+ * @param addr 7λַ
+ * @return 0-Ӧ; 1-ڻڸλ, data
+ */
+uint8_t MPUMODEL_Read(uint8_t addr, uint8_t reg, uint8_t *data, uint16_t len);
+/**
+ * @brief ȡINTŵ
+ * @return ϴεINTŲʱ1
+ */
+uint8_t MPUMODEL_TakeInterrupt(void);
+/**
+ * @brief һDMPݰ
+ * @param quat Ԫw, x, y, z
+ * @param time дFIFOʱ(ns)
+ * @return 0-; 1-ûݰ
+ */
+uint8_t MPUMODEL_GetReadPacket(double quat[4], uint64_t *time);
+/**
+ * @brief ǰʵ̬Ԫ
+ * @param quat w, x, y, z
+ */
+void MPUMODEL_GetQuaternion(double quat[4]);
+/**
+ * @brief ȡͳϢ
+ */
+void MPUMODEL_GetStatistics(MPUMODEL_StatisticsTypedef *stats);
+/**
+ * @brief ͳϢ
+ */
+void MPUMODEL_ResetStatistics(void);
+
+#endif
@@ -0,0 +1,394 @@
+/**
+ * @file    mpusim.c
+ * @author  Miaow
+ * @version 0.4.0
+ * @date    2026/10/16
+ * @brief
+ *          Runs the unmodified MPU6050 or MPU9250 drivers on the host against
+ *          a software model of the sensor and prints:
+ *              1. Result, simulated duration and bus traffic of the DMP initialization
+ *              2. Updates delivered to the application and their latency
+ *              3. Attitude error between the driver output and the model
+ *              4. Bus traffic and utilisation while streaming
+ *              5. Bus traffic of repeated DMP on/off and bypass switching (optional)
+ *              6. The same for the raw FIFO and Mahony fusion path of the MPU6050 (optional)
+ *              7. Consistency of MPU6050_Set* with the configuration cached by inv_mpu (optional)
+ * @note
+ *          Build from the repository root (MPU6050, asynchronous read):
+ *              gcc -std=gnu99 -O2 -m32 -Itools/mpusim/include -Itools/mpusim -Iuser -Iuser/mpu6050 \
+ *                  -o mpusim tools/mpusim/mpusim.c tools/mpusim/iichost.c tools/mpusim/mpumodel.c \
+ *                  user/mpu6050/inv_mpu.c user/mpu6050/inv_mpu_dmp_motion_driver.c user/mpu6050/mpu6050.c user/attitude.c -lm
+ *          MPU9250:
+ *              gcc -std=gnu99 -O2 -m32 -DMPUSIM_MPU9250 -Itools/mpusim/include -Itools/mpusim -Iuser -Iuser/mpu9250 \
+ *                  -o mpusim9250 tools/mpusim/mpusim.c tools/mpusim/iichost.c tools/mpusim/mpumodel.c \
+ *                  user/mpu9250/inv_mpu.c user/mpu9250/inv_mpu_dmp_motion_driver.c user/mpu9250/mpu9250.c user/attitude.c -lm
+ *          -m32 gives long the same width as on the Cortex-M. The motion driver
+ *          builds the q30 quaternion with (long)byte << 24, which loses the
+ *          sign of negative components where long is 64 bits; without -m32
+ *          only the still and tilt motions, whose quaternion stays positive,
+ *          are decoded correctly.
+ *          Usage:
+ *              mpusim [-t seconds] [-k bus Hz] [-r DMP Hz] [-R reset us] [-m still|tilt|spin] [-c cycles] [-f] [-s]
+ *          -c runs the reconfiguration cycles between initialization and streaming.
+ *          -s changes the ranges and the low pass filter of the MPU6050 through
+ *          MPU6050_Set* after initialization, restores them through inv_mpu and
+ *          checks that the registers of the model and the configuration cached
+ *          by inv_mpu agree after each step. With -f the gyroscope is left at
+ *          1000 dps, so streaming checks the new scale.
+ *          -f initializes with MPU6050_InitWithFusion instead of the DMP and
+ *          compares MPU6050_GetFusionData with the model at the time of the
+ *          call, within FUSION_TOLERANCE_DEG. No quaternion is decoded from
+ *          the FIFO, so every motion runs correctly without -m32.
+ *          Exit code is 0 when the initialization succeeds, at least one update
+ *          is delivered and every update is read without error and matches the model.
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include "iichost.h"
+#include "mpumodel.h"
+#include "inv_mpu.h"
+#ifdef MPUSIM_MPU9250
+#include "mpu9250.h"
+#define MPU_InitWithDmp             MPU9250_InitWithDmp
+#define MPU_GetDmpData              MPU9250_GetDmpData
+#define MPU_DEVICE                  MPUMODEL_MPU9250
+#define MPU_NAME                    "MPU9250"
+#else
+#include "mpu6050.h"
+#define MPU_InitWithDmp             MPU6050_InitWithDmp
+#define MPU_GetDmpData              MPU6050_GetDmpData
+#define MPU_DEVICE                  MPUMODEL_MPU6050
+#define MPU_NAME                    "MPU6050"
+#endif
+
+#define TOLERANCE_DEG               0.01//ģ͵
+#define FUSION_TOLERANCE_DEG        0.5//-fʱںϽģ͵, ˲ͺ
+#define MOTION_PHASE_NS             2000000000ull//tiltÿ˶ʱ
+
+void EXTI9_5_IRQHandler(void);
+
+/**
+ * @brief ˶
+ */
+typedef enum {
+    MOTION_STILL = 0,
+    MOTION_TILT,//x, yת20ת, ԪС0
+    MOTION_SPIN//z90/s, ͬʱxڶ
+}Motion;
+
+static struct {
+    uint32_t updates;//صõĴ
+    uint32_t driverErrors;//GetDmpDataط0
+    uint32_t mismatches;//TOLERANCE_DEG
+    uint32_t noPacket;//ģͻûбݰ
+    double maxError;
+    uint64_t totalLatency;//ݰдFIFOصʱ(ns)
+    uint64_t maxLatency;
+}sim;
+
+/**
+ * @brief ͬԪתŷǹʽ, ˫, õATTITUDE_QuatToEulerĽ
+ */
+static void MPUSIM_QuatToEuler(const double *q, double euler[3])
+{
+    euler[0] = asin(2 * q[0] * q[2] - 2 * q[1] * q[3]) * 57.29577951;
+    euler[1] = atan2(2 * q[2] * q[3] + 2 * q[0] * q[1], 1 - 2 * q[1] * q[1] - 2 * q[2] * q[2]) * 57.29577951;
+    euler[2] = atan2(2 * q[1] * q[2] + 2 * q[0] * q[3], q[0] * q[0] + q[1] * q[1] - q[2] * q[2] - q[3] * q[3]) * 57.29577951;
+}
+
+/**
+ * @brief ӦóĻص, ̬ݰȽ
+ */
+static void MPUSIM_OnData(void)
+{
+    float pitch, roll, yaw;
+    double quat[4], euler[3], error, e;
+    uint64_t time, latency;
+    uint8_t i;
+    sim.updates++;
+    if(MPU_GetDmpData(&pitch, &roll, &yaw))
+    {
+        sim.driverErrors++;
+        return;
+    }
+    if(MPUMODEL_GetReadPacket(quat, &time))
+    {
+        sim.noPacket++;
+        return;
+    }
+    MPUSIM_QuatToEuler(quat, euler);
+    euler[0] -= pitch;
+    euler[1] -= roll;
+    euler[2] -= yaw;
+    for(error = 0, i = 0; i < 3; i++)
+    {
+        e = fabs(remainder(euler[i], 360.0));//180㴦ĻƲ
+        if(e > error)
+            error = e;
+    }
+    if(error > sim.maxError)
+        sim.maxError = error;
+    if(error > TOLERANCE_DEG)
+        sim.mismatches++;
+    latency = IICHOST_Now() - time;
+    sim.totalLatency += latency;
+    if(latency > sim.maxLatency)
+        sim.maxLatency = latency;
+}
+
+#ifndef MPUSIM_MPU9250
+/**
+ * @brief -fʱӦóĻص, ںϵ̬ģ͵ǰ̬Ƚ
+ */
+static void MPUSIM_OnFusion(void)
+{
+    float pitch, roll, yaw;
+    double quat[4], euler[3], error, e;
+    uint8_t i;
+    sim.updates++;
+    if(MPU6050_GetFusionData(&pitch, &roll, &yaw))
+    {
+        sim.driverErrors++;
+        return;
+    }
+    MPUMODEL_GetQuaternion(quat);
+    MPUSIM_QuatToEuler(quat, euler);
+    euler[0] -= pitch;
+    euler[1] -= roll;
+    euler[2] -= yaw;
+    for(error = 0, i = 0; i < 3; i++)
+    {
+        e = fabs(remainder(euler[i], 360.0));
+        if(e > error)
+            error = e;
+    }
+    if(error > sim.maxError)
+        sim.maxError = error;
+    if(error > FUSION_TOLERANCE_DEG)
+        sim.mismatches++;
+}
+#endif
+
+/**
+ * @brief ˶ʽõǰʱ̵Ľٶ
+ */
+static void MPUSIM_SetMotion(Motion motion, uint64_t now)
+{
+    double dps[3] = {0.0, 0.0, 0.0};
+    uint32_t phase = now / MOTION_PHASE_NS % 4;
+    if(motion == MOTION_TILT)
+        dps[phase / 2] = phase % 2 ? -10.0 : 10.0;
+    else if(motion == MOTION_SPIN)
+    {
+        dps[0] = phase % 2 ? -30.0 : 30.0;
+        dps[2] = 90.0;
+    }
+    MPUMODEL_SetRate(dps);
+}
+
+/**
+ * @brief ظرDMP, л·ģʽ, ٴDMP, ÿζḴλFIFO
+ * @return 0-ɹ; 1-ʧ
+ */
+static uint8_t MPUSIM_Reconfigure(uint32_t cycles)
+{
+    while(cycles--)
+    {
+        if(mpu_set_dmp_state(0) || mpu_set_bypass(1) || mpu_set_bypass(0) || mpu_set_dmp_state(1))
+            return 1;
+    }
+    return 0;
+}
+
+#ifndef MPUSIM_MPU9250
+/**
+ * @brief ģе̺͵ͨ˲, inv_mpuñȽ
+ * @return 0-һ; 1-һ
+ */
+static uint8_t MPUSIM_CompareConfig(unsigned short gyroFsr, unsigned char accelFsr, unsigned short lpf)
+{
+    static const unsigned short lpfHz[8] = {0, 188, 98, 42, 20, 10, 5, 0};
+    unsigned short invGyro, invLpf;
+    unsigned char invAccel, regs[3];//CONFIG, GYRO_CONFIG, ACCEL_CONFIG
+    if(MPUMODEL_Read(MPU6050_ADDR, 0x1A, regs, 3) || mpu_get_gyro_fsr(&invGyro) ||
+        mpu_get_accel_fsr(&invAccel) || mpu_get_lpf(&invLpf))
+        return 1;
+    printf("  register: gyro %4u dps, accel %2u g, LPF %3u Hz; inv_mpu: %4u dps, %2u g, %3u Hz\n",
+        250u << ((regs[1] >> 3) & 3), 2u << ((regs[2] >> 3) & 3), lpfHz[regs[0] & 7], invGyro, invAccel, invLpf);
+    return (250u << ((regs[1] >> 3) & 3)) != gyroFsr || (2u << ((regs[2] >> 3) & 3)) != accelFsr ||
+        lpfHz[regs[0] & 7] != lpf || invGyro != gyroFsr || invAccel != accelFsr || invLpf != lpf;
+}
+
+/**
+ * @brief MPU6050_Set*޸̺͵ͨ˲, ֱinv_mpuĻ,
+ *        ĴʱĻinv_mpuд
+ * @param fusion 1-ٰΪ1000dps, ںҪµ̻
+ * @return 0-ɹ; 1-ʧ
+ */
+static uint8_t MPUSIM_CheckSetters(int fusion)
+{
+    unsigned short lpf;
+    if(mpu_get_lpf(&lpf))
+        return 1;
+    if(MPU6050_SetGyroFsr(MPU6050_FSR_500DPS) || MPU6050_SetAccelFsr(MPU6050_FSR_4G) || MPU6050_SetLPF(MPU6050_FILTER_10HZ))
+        return 1;
+    if(MPUSIM_CompareConfig(500, 4, 10))
+        return 1;
+    if(mpu_set_gyro_fsr(2000) || mpu_set_accel_fsr(2) || mpu_set_lpf(lpf))
+        return 1;
+    if(MPUSIM_CompareConfig(2000, 2, lpf))
+        return 1;
+    if(fusion && (MPU6050_SetGyroFsr(MPU6050_FSR_1000DPS) || MPUSIM_CompareConfig(1000, 2, lpf)))
+        return 1;
+    return 0;
+}
+#endif
+
+static void MPUSIM_Usage(void)
+{
+    fprintf(stderr, "usage: mpusim [-t seconds] [-k bus Hz] [-r DMP Hz] [-R reset us] [-m still|tilt|spin] [-c cycles] [-f] [-s]\n");
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    MPUMODEL_ConfigTypedef config = {MPU_DEVICE, 50000, 0};
+    MPUMODEL_StatisticsTypedef stats;
+    IICHOST_TotalsTypedef totals;
+    Motion motion = MOTION_TILT;
+    double seconds = 10.0;
+    uint32_t cycles = 0;
+    uint64_t begin, end, next;
+    int res, opt, fusion = 0, setters = 0;
+    while((opt = getopt(argc, argv, "t:k:r:R:m:c:fs")) != -1)
+    {
+        switch(opt)
+        {
+            case 't': seconds = atof(optarg); break;
+            case 'k':
+                if(IIC_SetSpeed(strtoul(optarg, NULL, 0)))
+                {
+                    fprintf(stderr, "unsupported bus speed %s\n", optarg);
+                    return 2;
+                }
+                break;
+            case 'r': config.dmpRate = atoi(optarg); break;
+            case 'R': config.resetUs = atoi(optarg); break;
+            case 'c': cycles = strtoul(optarg, NULL, 0); break;
+            case 'f': fusion = 1; break;
+            case 's': setters = 1; break;
+            case 'm':
+                if(!strcmp(optarg, "still"))
+                    motion = MOTION_STILL;
+                else if(!strcmp(optarg, "tilt"))
+                    motion = MOTION_TILT;
+                else if(!strcmp(optarg, "spin"))
+                    motion = MOTION_SPIN;
+                else
+                    MPUSIM_Usage();
+                break;
+            default: MPUSIM_Usage();
+        }
+    }
+#ifdef MPUSIM_MPU9250
+    if(fusion || setters)
+    {
+        fprintf(stderr, "-f and -s are only available for the MPU6050\n");
+        return 2;
+    }
+#endif
+    if(motion == MOTION_SPIN && !fusion && sizeof(long) != 4)
+        fprintf(stderr, "warning: long is %u bytes, negative quaternion components will not decode, build with -m32\n", (unsigned)sizeof(long));
+    MPUMODEL_Init(&config);
+
+    //ʼ
+#ifndef MPUSIM_MPU9250
+    if(fusion)
+        res = MPU6050_InitWithFusion(MPUSIM_OnFusion);
+    else
+#endif
+        res = MPU_InitWithDmp(MPUSIM_OnData);
+    printf("%s_InitWith%s returned %d after %.3f ms simulated, bus %.0f Hz\n",
+        MPU_NAME, fusion ? "Fusion" : "Dmp", res, IICHOST_Now() / 1e6, (double)IIC_DefaultBus.speed);
+    IICHOST_PrintStatistics("initialization traffic");
+    IICHOST_GetTotals(&totals);
+    printf("%u calls, %llu data bytes, bus busy %.3f ms\n",
+        totals.calls, (unsigned long long)totals.dataBytes, totals.busNs / 1e6);
+    if(res)
+        return 1;
+
+    //
+    if(cycles)
+    {
+        IICHOST_ResetStatistics();
+        begin = IICHOST_Now();
+        res = MPUSIM_Reconfigure(cycles);
+        IICHOST_PrintStatistics("reconfiguration traffic");
+        IICHOST_GetTotals(&totals);
+        printf("%u cycles %s, %.1f transfers and %.1f us bus time per cycle, %.3f ms simulated\n",
+            cycles, res ? "failed" : "done", (double)totals.transfers / cycles,
+            totals.busNs / 1e3 / cycles, (IICHOST_Now() - begin) / 1e6);
+        if(res)
+            return 1;
+    }
+
+#ifndef MPUSIM_MPU9250
+    //MPU6050_Set*޸
+    if(setters)
+    {
+        printf("MPU6050_Set* against the inv_mpu configuration:\n");
+        res = MPUSIM_CheckSetters(fusion);
+        printf("setters %s\n", res ? "disagree with inv_mpu" : "agree with inv_mpu");
+        if(res)
+            return 1;
+    }
+#endif
+
+    //
+    IICHOST_ResetStatistics();
+    MPUMODEL_ResetStatistics();
+    MPUMODEL_TakeInterrupt();//ʼڼEXTIú֮ǰ, ᴥж
+    begin = IICHOST_Now();
+    end = begin + (uint64_t)(seconds * 1e9);
+    while(IICHOST_Now() < end)
+    {
+        MPUSIM_SetMotion(motion, IICHOST_Now() - begin);
+        next = MPUMODEL_NextEvent();
+        IICHOST_Idle(next < end ? next : end);
+        if(MPUMODEL_TakeInterrupt())
+            EXTI9_5_IRQHandler();
+        IICHOST_RunBackground();
+    }
+    IICHOST_PrintStatistics("streaming traffic");
+    IICHOST_GetTotals(&totals);
+    MPUMODEL_GetStatistics(&stats);
+    printf("\n%.3f s simulated, bus utilisation %.2f%%, %.1f calls/s\n",
+        (end - begin) / 1e9, 100.0 * totals.busNs / (end - begin), totals.calls / ((end - begin) / 1e9));
+    printf("model: %u samples, %u packets, %u read, %u dropped, %u overflows, %u interrupts, max FIFO %u bytes, %u NACKs\n",
+        stats.samples, stats.packets, stats.packetsRead, stats.packetsDropped, stats.overflows,
+        stats.interrupts, stats.maxFifoCount, stats.nacks);
+    printf("driver: %u updates, %u errors, %u without packet, %u mismatches, max error %.4f deg\n",
+        sim.updates, sim.driverErrors, sim.noPacket, sim.mismatches, sim.maxError);
+    if(!fusion && sim.updates > sim.driverErrors + sim.noPacket)
+        printf("latency: avg %.1f us, max %.1f us\n",
+            sim.totalLatency / 1e3 / (sim.updates - sim.driverErrors - sim.noPacket), sim.maxLatency / 1e3);
+    if(!sim.updates || sim.mismatches || sim.driverErrors || sim.noPacket)
+    {
+        printf("FAIL\n");
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,226 @@
+/**
+ * @file    oledasset.c
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2026/10/16
+ * @brief
+ *          Host tool that compresses OLED bitmaps and glyphs for oled_asset.c:
+ *              1. Reads page-major bitmap bytes written as 0x.. in C source
+ *              2. XORs every column with the previous one of the same page
+ *              3. Run-length encodes the result and checks it decodes back
+ *              4. Prints const arrays ready to paste into oled_font.h/oled_bmp.h
+ * @note
+ *          Build with any C99 compiler on the host:
+ *              gcc -std=gnu99 -O2 -o oledasset oledasset.c
+ *          Usage:
+ *              oledasset -w width [-g bytes] [-n name] < bitmap.h
+ *          -w is the width in pixels of the bitmap or of each glyph, at most
+ *          the 128 columns of the screen. With -g
+ *          the input is split into glyphs of that many bytes, each glyph is
+ *          compressed on its own and an offset table name##Offsets is added,
+ *          so that one glyph can be decoded without the others.
+ *          Only tokens starting with 0x are read, comments may contain numbers.
+ *          Stream format, see OLED_AssetRead:
+ *              0x00~0x7F n: n + 1 literal bytes follow
+ *              0x80~0xFF n: the next byte is repeated (n & 0x7F) + 2 times
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <ctype.h>
+#include <unistd.h>
+
+#define MAX_INPUT               65536
+#define MAX_GLYPHS              4096
+#define MAX_WIDTH               128//Ļ, OLED_AssetTypedef.widthֻ8λ
+#define MAX_LITERAL             128
+#define MAX_REPEAT              129
+
+static uint8_t input[MAX_INPUT];
+static uint8_t output[MAX_INPUT * 2];
+
+/**
+ * @brief ȡ׼0xͷ
+ * @return ֽ
+ */
+static size_t ReadHex(void)
+{
+    size_t count = 0;
+    int c, previous = 0;
+    while((c = getchar()) != EOF)
+    {
+        if(previous == '0' && (c == 'x' || c == 'X'))
+        {
+            unsigned value = 0, digits = 0;
+            while(isxdigit(c = getchar()) && digits < 2)
+            {
+                value = (value << 4) | (isdigit(c) ? c - '0' : (tolower(c) - 'a' + 10));
+                digits++;
+            }
+            if(digits && count < MAX_INPUT)
+                input[count++] = (uint8_t)value;
+        }
+        previous = c;
+    }
+    return count;
+}
+
+/**
+ * @brief ѹһΰҳŵĵ
+ * @return ѹֽ
+ */
+static size_t Encode(const uint8_t *raw, size_t len, unsigned width, uint8_t *out)
+{
+    uint8_t delta[MAX_INPUT];
+    size_t i, n = 0, literal = 0, run;
+    for(i = 0; i < len; i++)
+        delta[i] = raw[i] ^ (i % width ? raw[i - 1] : 0);
+    for(i = 0; i < len; )
+    {
+        for(run = 1; i + run < len && run < MAX_REPEAT && delta[i + run] == delta[i]; run++);
+        if(run >= 3 || (run == 2 && !literal))
+        {
+            if(literal)
+            {
+                out[n++] = (uint8_t)(literal - 1);
+                memcpy(out + n, delta + i - literal, literal);
+                n += literal;
+                literal = 0;
+            }
+            out[n++] = (uint8_t)(0x80 | (run - 2));
+            out[n++] = delta[i];
+            i += run;
+        }
+        else
+        {
+            i++;
+            if(++literal == MAX_LITERAL)
+            {
+                out[n++] = (uint8_t)(literal - 1);
+                memcpy(out + n, delta + i - literal, literal);
+                n += literal;
+                literal = 0;
+            }
+        }
+    }
+    if(literal)
+    {
+        out[n++] = (uint8_t)(literal - 1);
+        memcpy(out + n, delta + i - literal, literal);
+        n += literal;
+    }
+    return n;
+}
+
+/**
+ * @brief OLED_AssetReadͬĽ
+ */
+static size_t Decode(const uint8_t *in, size_t len, unsigned width, uint8_t *raw, size_t max)
+{
+    size_t i = 0, n = 0, run;
+    uint8_t previous = 0;
+    while(i < len && n < max)
+    {
+        uint8_t c = in[i++];
+        run = c & 0x80 ? (c & 0x7F) + 2u : c + 1u;
+        while(run-- && n < max)
+        {
+            uint8_t delta = c & 0x80 ? in[i] : in[i++];
+            previous = delta ^ (n % width ? previous : 0);
+            raw[n++] = previous;
+        }
+        if(c & 0x80)
+            i++;
+    }
+    return n;
+}
+
+static void PrintArray(const char *type, const char *name, const uint8_t *data, size_t len)
+{
+    size_t i;
+    printf("const %s %s[%u] = {", type, name, (unsigned)len);
+    for(i = 0; i < len; i++)
+        printf("%s0x%02X%s", i % 16 ? "" : "\n    ", data[i], i + 1 < len ? "," : "");
+    printf("\n};\n");
+}
+
+static void Usage(void)
+{
+    fprintf(stderr, "usage: oledasset -w width [-g bytes] [-n name] < bitmap.h\n");
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    static uint16_t offsets[MAX_GLYPHS + 1];
+    static uint8_t check[MAX_INPUT];
+    const char *name = "asset";
+    unsigned width = 0, glyphBytes = 0, glyphs, g;
+    size_t len, total = 0, size;
+    int opt;
+    while((opt = getopt(argc, argv, "w:g:n:")) != -1)
+    {
+        switch(opt)
+        {
+            case 'w': width = strtoul(optarg, NULL, 0); break;
+            case 'g': glyphBytes = strtoul(optarg, NULL, 0); break;
+            case 'n': name = optarg; break;
+            default: Usage();
+        }
+    }
+    if(!width)
+        Usage();
+    if(width > MAX_WIDTH)
+    {
+        fprintf(stderr, "width %u is wider than the screen, at most %u\n", width, MAX_WIDTH);
+        return 1;
+    }
+    len = ReadHex();
+    if(!glyphBytes)
+        glyphBytes = len;
+    if(!len || len % glyphBytes || glyphBytes % width)
+    {
+        fprintf(stderr, "%u bytes do not split into glyphs of %u bytes and %u columns\n", (unsigned)len, glyphBytes, width);
+        return 1;
+    }
+    glyphs = len / glyphBytes;
+    if(glyphs > MAX_GLYPHS)
+    {
+        fprintf(stderr, "too many glyphs\n");
+        return 1;
+    }
+    for(g = 0; g < glyphs; g++)
+    {
+        offsets[g] = (uint16_t)total;
+        size = Encode(input + g * glyphBytes, glyphBytes, width, output + total);
+        if(Decode(output + total, size, width, check, glyphBytes) != glyphBytes || memcmp(check, input + g * glyphBytes, glyphBytes))
+        {
+            fprintf(stderr, "glyph %u does not decode back\n", g);
+            return 1;
+        }
+        total += size;
+    }
+    offsets[glyphs] = (uint16_t)total;
+    printf("//%u bytes compressed to %u bytes, %u x %u pixels%s\n", (unsigned)len, (unsigned)total,
+        width, glyphBytes / width * 8, glyphs > 1 ? " per glyph" : "");
+    PrintArray("unsigned char", name, output, total);
+    if(glyphs > 1)
+    {
+        printf("const unsigned short %sOffsets[%u] = {", name, glyphs + 1);
+        for(g = 0; g <= glyphs; g++)
+            printf("%s%u%s", g % 16 ? "" : "\n    ", offsets[g], g < glyphs ? "," : "");
+        printf("\n};\n");
+    }
+    fprintf(stderr, "%s: %u -> %u bytes\n", name, (unsigned)len, (unsigned)total);
+    return 0;
+}
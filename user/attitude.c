@@ -0,0 +1,442 @@
+/**
+ * @file    attitude.c
+ * @author  Miaow
+ * @version 0.2.0
+ * @date    2026/10/16
+ * @brief
+ *          This file provides functions to manage the following
+ *          functionalities of attitude math:
+ *              1. Single precision atan2 and asin with polynomial approximations
+ *              2. q30 quaternion to Euler angles, or to yaw only
+ *              3. q30 quaternion to floating point quaternion
+ *              4. Cycle and accuracy benchmark against the double precision C library
+ *              5. Mahony filter fusing raw gyroscope and accelerometer samples
+ * @note
+ *          Minimum version of header file:
+ *              0.2.0
+ *          atan(t) on 0~1 is a minimax polynomial in t^2, |t| > 1 is folded
+ *          with atan(t) = /2 - atan(1/t), so atan2 costs one division.
+ *          asin(x) = atan2(x, sqrt((1 - x)(1 + x))), sqrt is the VSQRT instruction.
+ *          The Mahony update normalises with 1/sqrt, one VSQRT and one VDIV
+ *          each for the accelerometer and the quaternion, no other division.
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#include "attitude.h"
+#ifdef ATTITUDE_USE_BENCHMARK
+#include "cyclecounter.h"
+#include "math.h"
+#endif
+
+#define ATTITUDE_PI                 3.14159265f
+#define ATTITUDE_HALF_PI            1.57079633f
+
+#if defined(__CC_ARM)
+#define ATTITUDE_SQRT(x)            __sqrtf(x)
+#elif defined(__GNUC__)
+#define ATTITUDE_SQRT(x)            __builtin_sqrtf(x)
+#else
+#include "math.h"
+#define ATTITUDE_SQRT(x)            sqrtf(x)
+#endif
+
+/**
+ * @brief atanʽϵ, 0~1ϵľһ±ƽ
+ */
+#if ATTITUDE_ATAN_TERMS == 3
+#define ATTITUDE_ATAN_POLY(s)       (0.99535725f + (s) * (-0.28868621f + (s) * 0.07933485f))
+#define ATTITUDE_ERROR_BOUND        0.04f
+#elif ATTITUDE_ATAN_TERMS == 4
+#define ATTITUDE_ATAN_POLY(s)       (0.99921372f + (s) * (-0.32117395f + (s) * (0.14626193f + (s) * -0.03898478f)))
+#define ATTITUDE_ERROR_BOUND        0.006f
+#elif ATTITUDE_ATAN_TERMS == 5
+#define ATTITUDE_ATAN_POLY(s)       (0.99986632f + (s) * (-0.33030456f + (s) * (0.18015832f + (s) * (-0.08515482f + (s) * 0.02084433f))))
+#define ATTITUDE_ERROR_BOUND        0.001f
+#elif ATTITUDE_ATAN_TERMS == 6
+#define ATTITUDE_ATAN_POLY(s)       (0.99997722f + (s) * (-0.33262278f + (s) * (0.19354006f + (s) * (-0.11642566f + (s) * (0.05264642f + (s) * -0.01171876f)))))
+#define ATTITUDE_ERROR_BOUND        0.0005f
+#else
+#error ATTITUDE_ATAN_TERMS must be 3, 4, 5 or 6.
+#endif
+
+/**
+ * @brief atan2, ̬
+ */
+static inline float ATTITUDE_Atan2Fast(float y, float x)
+{
+    float absY = y < 0.0f ? -y : y, absX = x < 0.0f ? -x : x, t, angle;
+    if(absX >= absY)
+    {
+        if(absX == 0.0f)
+            return 0.0f;
+        t = absY / absX;
+        angle = t * ATTITUDE_ATAN_POLY(t * t);
+    }
+    else
+    {
+        t = absX / absY;
+        angle = ATTITUDE_HALF_PI - t * ATTITUDE_ATAN_POLY(t * t);
+    }
+    if(x < 0.0f)
+        angle = ATTITUDE_PI - angle;
+    return y < 0.0f ? -angle : angle;
+}
+
+/**
+ * @brief asin, ̬
+ */
+static inline float ATTITUDE_AsinFast(float x)
+{
+    if(x >= 1.0f)
+        return ATTITUDE_HALF_PI;
+    if(x <= -1.0f)
+        return -ATTITUDE_HALF_PI;
+    return ATTITUDE_Atan2Fast(x, ATTITUDE_SQRT((1.0f - x) * (1.0f + x)));
+}
+
+/**
+ * @brief atan2
+ * @param y 
+ * @param x 
+ * @return , Χ -~, x, yΪ0ʱ0
+ */
+float ATTITUDE_Atan2(float y, float x)
+{
+    return ATTITUDE_Atan2Fast(y, x);
+}
+
+/**
+ * @brief asin
+ * @param x ֵ, -1~1ʱȡ߽
+ * @return , Χ -/2~/2
+ */
+float ATTITUDE_Asin(float x)
+{
+    return ATTITUDE_AsinFast(x);
+}
+
+/**
+ * @brief q30ʽԪתΪŷ
+ * @param quat q30ʽԪ, ˳Ϊw, x, y, z
+ * @param pitch ()
+ * @param roll ()
+ * @param yaw ()
+ * @note ˻q60, Ϊatan2Ĳ; asinĲ2^-59, 22^-60
+ */
+void ATTITUDE_QuatToEuler(const long *quat, float *pitch, float *roll, float *yaw)
+{
+    float q0 = (float)quat[0], q1 = (float)quat[1], q2 = (float)quat[2], q3 = (float)quat[3];
+    float q00 = q0 * q0, q11 = q1 * q1, q22 = q2 * q2, q33 = q3 * q3;
+    *pitch = ATTITUDE_AsinFast((q0 * q2 - q1 * q3) * (2.0f / ATTITUDE_Q30 / ATTITUDE_Q30)) * ATTITUDE_RAD_TO_DEG;
+    *roll = ATTITUDE_Atan2Fast(q2 * q3 + q0 * q1, 0.5f * (q00 - q11 - q22 + q33)) * ATTITUDE_RAD_TO_DEG;
+    *yaw = ATTITUDE_Atan2Fast(q1 * q2 + q0 * q3, 0.5f * (q00 + q11 - q22 - q33)) * ATTITUDE_RAD_TO_DEG;
+}
+
+/**
+ * @brief q30ʽԪתΪ, 㸩Ǻͺ
+ * @param quat q30ʽԪ, ˳Ϊw, x, y, z
+ * @return ()
+ */
+float ATTITUDE_QuatToYaw(const long *quat)
+{
+    float q0 = (float)quat[0], q1 = (float)quat[1], q2 = (float)quat[2], q3 = (float)quat[3];
+    return ATTITUDE_Atan2Fast(q1 * q2 + q0 * q3, 0.5f * (q0 * q0 + q1 * q1 - q2 * q2 - q3 * q3)) * ATTITUDE_RAD_TO_DEG;
+}
+
+/**
+ * @brief q30ʽԪתΪ
+ * @param quat q30ʽԪ, ˳Ϊw, x, y, z
+ * @param q , ˳ͬquat
+ * @note 2^-30Ǿȷ, ó
+ */
+void ATTITUDE_QuatFromQ30(const long *quat, float *q)
+{
+    q[0] = (float)quat[0] * (1.0f / ATTITUDE_Q30);
+    q[1] = (float)quat[1] * (1.0f / ATTITUDE_Q30);
+    q[2] = (float)quat[2] * (1.0f / ATTITUDE_Q30);
+    q[3] = (float)quat[3] * (1.0f / ATTITUDE_Q30);
+}
+
+/**
+ * @brief ԪתΪŷ
+ * @param q λԪ, ˳Ϊw, x, y, z
+ * @param pitch ()
+ * @param roll ()
+ * @param yaw ()
+ */
+void ATTITUDE_QuatToEulerf(const float *q, float *pitch, float *roll, float *yaw)
+{
+    float q00 = q[0] * q[0], q11 = q[1] * q[1], q22 = q[2] * q[2], q33 = q[3] * q[3];
+    *pitch = ATTITUDE_AsinFast(2.0f * (q[0] * q[2] - q[1] * q[3])) * ATTITUDE_RAD_TO_DEG;
+    *roll = ATTITUDE_Atan2Fast(q[2] * q[3] + q[0] * q[1], 0.5f * (q00 - q11 - q22 + q33)) * ATTITUDE_RAD_TO_DEG;
+    *yaw = ATTITUDE_Atan2Fast(q[1] * q[2] + q[0] * q[3], 0.5f * (q00 + q11 - q22 - q33)) * ATTITUDE_RAD_TO_DEG;
+}
+
+/**
+ * @brief ɹһȷʼ̬, Ϊ0
+ * @note ǵֱӿõ, Ǻ
+ */
+static void ATTITUDE_MahonyAlign(ATTITUDE_MahonyTypedef *filter, float ax, float ay, float az)
+{
+    float cosPitch = ATTITUDE_SQRT(ay * ay + az * az), cosRoll, cr, sr, cp, sp;
+    cosRoll = cosPitch > 0.0f ? az / cosPitch : 1.0f;
+    cr = ATTITUDE_SQRT(0.5f * (1.0f + cosRoll));
+    sr = ATTITUDE_SQRT(0.5f * (1.0f - cosRoll));
+    if(ay < 0.0f)
+        sr = -sr;
+    cp = ATTITUDE_SQRT(0.5f * (1.0f + cosPitch));
+    sp = ATTITUDE_SQRT(0.5f * (1.0f - cosPitch));
+    if(ax > 0.0f)
+        sp = -sp;
+    filter->q[0] = cr * cp;
+    filter->q[1] = sr * cp;
+    filter->q[2] = cr * sp;
+    filter->q[3] = -sr * sp;
+    filter->__aligned = 1;
+}
+
+/**
+ * @brief һǺͼٶȼݸMahony˲
+ * @param filter ˲
+ * @param gyro ٶ(rad/s), ˳Ϊx, y, z
+ * @param accel ٶ, λ, ˳Ϊx, y, z; ȫΪ0ʱֻ
+ * @param dt (s)
+ * @note ΪõԪĲ
+ */
+void ATTITUDE_MahonyUpdate(ATTITUDE_MahonyTypedef *filter, const float *gyro, const float *accel, float dt)
+{
+    float q0 = filter->q[0], q1 = filter->q[1], q2 = filter->q[2], q3 = filter->q[3];
+    float gx = gyro[0], gy = gyro[1], gz = gyro[2];
+    float ax = accel[0], ay = accel[1], az = accel[2];
+    float norm = ax * ax + ay * ay + az * az, vx, vy, vz, ex, ey, ez;
+
+    if(norm > 0.0f)
+    {
+        norm = 1.0f / ATTITUDE_SQRT(norm);
+        ax *= norm;
+        ay *= norm;
+        az *= norm;
+        if(!filter->__aligned)
+        {
+            ATTITUDE_MahonyAlign(filter, ax, ay, az);
+            return;
+        }
+        vx = 2.0f * (q1 * q3 - q0 * q2);
+        vy = 2.0f * (q0 * q1 + q2 * q3);
+        vz = q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3;
+        ex = ay * vz - az * vy;
+        ey = az * vx - ax * vz;
+        ez = ax * vy - ay * vx;
+        if(filter->ki > 0.0f)
+        {
+            filter->__integral[0] += filter->ki * ex * dt;
+            filter->__integral[1] += filter->ki * ey * dt;
+            filter->__integral[2] += filter->ki * ez * dt;
+        }
+        gx += filter->kp * ex;
+        gy += filter->kp * ey;
+        gz += filter->kp * ez;
+    }
+    gx += filter->__integral[0];
+    gy += filter->__integral[1];
+    gz += filter->__integral[2];
+
+    dt *= 0.5f;
+    gx *= dt;
+    gy *= dt;
+    gz *= dt;
+    q0 = filter->q[0] - q1 * gx - q2 * gy - q3 * gz;
+    q1 = filter->q[1] + filter->q[0] * gx + q2 * gz - q3 * gy;
+    q2 = filter->q[2] + filter->q[0] * gy - filter->q[1] * gz + q3 * gx;
+    q3 = filter->q[3] + filter->q[0] * gz + filter->q[1] * gy - filter->q[2] * gx;
+    norm = 1.0f / ATTITUDE_SQRT(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
+    filter->q[0] = q0 * norm;
+    filter->q[1] = q1 * norm;
+    filter->q[2] = q2 * norm;
+    filter->q[3] = q3 * norm;
+}
+
+/**
+ * @brief Mahony˲̬, һθ¶׼
+ * @param filter ˲
+ */
+void ATTITUDE_MahonyReset(ATTITUDE_MahonyTypedef *filter)
+{
+    filter->q[0] = 1.0f;
+    filter->q[1] = filter->q[2] = filter->q[3] = 0.0f;
+    filter->__integral[0] = filter->__integral[1] = filter->__integral[2] = 0.0f;
+    filter->__aligned = 0;
+}
+
+#ifdef ATTITUDE_USE_BENCHMARK
+#define ATTITUDE_BENCHMARK_BLOCK    16//ÿμʱ̬
+#define ATTITUDE_BENCHMARK_RUNS     3//ÿȡ3ٵ
+#define ATTITUDE_BENCHMARK_PITCHES  9//-80~80
+#define ATTITUDE_BENCHMARK_ROLLS    12
+#define ATTITUDE_BENCHMARK_YAWS     8
+#define ATTITUDE_BENCHMARK_SAMPLES  (ATTITUDE_BENCHMARK_PITCHES * ATTITUDE_BENCHMARK_ROLLS * ATTITUDE_BENCHMARK_YAWS)
+
+/**
+ * @brief ԭMPU6050_GetDmpDataеĻ, ΪʱĻ׼
+ */
+static void ATTITUDE_QuatToEulerReference(const long *quat, float *pitch, float *roll, float *yaw)
+{
+    float q0, q1, q2, q3;
+    q0 = quat[0] / ATTITUDE_Q30;
+    q1 = quat[1] / ATTITUDE_Q30;
+    q2 = quat[2] / ATTITUDE_Q30;
+    q3 = quat[3] / ATTITUDE_Q30;
+    *pitch = asin(2 * q0 * q2 - 2 * q1 * q3) * 57.3;
+    *roll = atan2(2 * q2 * q3 + 2 * q0 * q1, 1 - 2 * q1 * q1 - 2 * q2 * q2) * 57.3;
+    *yaw = atan2(2 * q1 * q2 + 2 * q0 * q3, q0 * q0 + q1 * q1 - q2 * q2 - q3 * q3) * 57.3;
+}
+
+/**
+ * @brief index̬q30Ԫ
+ * @note Ƕȱܿ, ޺atan2֧õ
+ */
+static void ATTITUDE_BenchmarkQuat(uint16_t index, long *quat)
+{
+    double pitch = (-80.0 + 20.0 * (index / (ATTITUDE_BENCHMARK_ROLLS * ATTITUDE_BENCHMARK_YAWS)) + 0.37) / 114.59155903;
+    double roll = (-172.3 + 30.0 * (index / ATTITUDE_BENCHMARK_YAWS % ATTITUDE_BENCHMARK_ROLLS)) / 114.59155903;
+    double yaw = (-161.9 + 45.0 * (index % ATTITUDE_BENCHMARK_YAWS)) / 114.59155903;
+    double cp = cos(pitch), sp = sin(pitch), cr = cos(roll), sr = sin(roll), cy = cos(yaw), sy = sin(yaw);
+    quat[0] = (long)((cr * cp * cy + sr * sp * sy) * (double)ATTITUDE_Q30);
+    quat[1] = (long)((sr * cp * cy - cr * sp * sy) * (double)ATTITUDE_Q30);
+    quat[2] = (long)((cr * sp * cy + sr * cp * sy) * (double)ATTITUDE_Q30);
+    quat[3] = (long)((cr * cp * sy - sr * sp * cy) * (double)ATTITUDE_Q30);
+}
+
+/**
+ * @brief ˫ȵŷ, ΪĻ׼
+ */
+static void ATTITUDE_BenchmarkExact(const long *quat, double *euler)
+{
+    double q0 = quat[0], q1 = quat[1], q2 = quat[2], q3 = quat[3];
+    double norm = q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3;
+    euler[0] = asin(2 * (q0 * q2 - q1 * q3) / norm) * 57.29577951;
+    euler[1] = atan2(2 * (q2 * q3 + q0 * q1), q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3) * 57.29577951;
+    euler[2] = atan2(2 * (q1 * q2 + q0 * q3), q0 * q0 + q1 * q1 - q2 * q2 - q3 * q3) * 57.29577951;
+}
+
+/**
+ * @brief Ƕ֮ľֵ, ǡ180㴦
+ */
+static float ATTITUDE_BenchmarkError(float angle, double exact)
+{
+    double error = fabs((double)angle - exact);
+    return (float)(error > 180.0 ? 360.0 - error : error);
+}
+
+/**
+ * @brief һ̬
+ * @param function 0-ԭĻ; 1-ATTITUDE_QuatToEuler; 2-ATTITUDE_QuatToYaw; 3-ATTITUDE_QuatFromQ30
+ * @param quat 
+ * @param out , ÿ̬4
+ */
+static uint32_t ATTITUDE_BenchmarkBlock(uint8_t function, long (*quat)[4], float (*out)[4])
+{
+    uint32_t begin, cycles, best = 0xFFFFFFFF;
+    uint8_t run, i;
+    for(run = 0; run < ATTITUDE_BENCHMARK_RUNS; run++)
+    {
+        begin = CYCLECOUNTER_Read();
+        switch(function)
+        {
+            case 0:
+                for(i = 0; i < ATTITUDE_BENCHMARK_BLOCK; i++)
+                    ATTITUDE_QuatToEulerReference(quat[i], &out[i][0], &out[i][1], &out[i][2]);
+                break;
+            case 1:
+                for(i = 0; i < ATTITUDE_BENCHMARK_BLOCK; i++)
+                    ATTITUDE_QuatToEuler(quat[i], &out[i][0], &out[i][1], &out[i][2]);
+                break;
+            case 2:
+                for(i = 0; i < ATTITUDE_BENCHMARK_BLOCK; i++)
+                    out[i][2] = ATTITUDE_QuatToYaw(quat[i]);
+                break;
+            default:
+                for(i = 0; i < ATTITUDE_BENCHMARK_BLOCK; i++)
+                    ATTITUDE_QuatFromQ30(quat[i], out[i]);
+                break;
+        }
+        cycles = CYCLECOUNTER_Read() - begin;
+        if(cycles < best)
+            best = cycles;
+    }
+    return best;
+}
+
+/**
+ * @brief ȽATTITUDE_QuatToEulerԭ˫Ȼĺʱ
+ * @param result ͳƽ
+ * @return 0-ATTITUDE_ATAN_TERMSӦķΧ; 1-
+ * @note Ԫֵ˫ȻΪ׼, q30
+ */
+uint8_t ATTITUDE_Benchmark(ATTITUDE_BenchmarkTypedef *result)
+{
+    long quat[ATTITUDE_BENCHMARK_BLOCK][4];
+    float out[ATTITUDE_BENCHMARK_BLOCK][4], error;
+    uint32_t cycles[4] = {0, 0, 0, 0};
+    double exact[3];
+    uint16_t index;
+    uint8_t i, j;
+
+    CYCLECOUNTER_Init();
+    result->maxError[0] = result->maxError[1] = result->maxError[2] = result->referenceError = 0.0f;
+    for(index = 0; index < ATTITUDE_BENCHMARK_SAMPLES; index += ATTITUDE_BENCHMARK_BLOCK)
+    {
+        for(i = 0; i < ATTITUDE_BENCHMARK_BLOCK; i++)
+            ATTITUDE_BenchmarkQuat(index + i, quat[i]);
+        cycles[0] += ATTITUDE_BenchmarkBlock(0, quat, out);
+        for(i = 0; i < ATTITUDE_BENCHMARK_BLOCK; i++)
+        {
+            ATTITUDE_BenchmarkExact(quat[i], exact);
+            for(j = 0; j < 3; j++)
+            {
+                error = ATTITUDE_BenchmarkError(out[i][j], exact[j]);
+                if(error > result->referenceError)
+                    result->referenceError = error;
+            }
+        }
+        cycles[1] += ATTITUDE_BenchmarkBlock(1, quat, out);
+        for(i = 0; i < ATTITUDE_BENCHMARK_BLOCK; i++)
+        {
+            ATTITUDE_BenchmarkExact(quat[i], exact);
+            for(j = 0; j < 3; j++)
+            {
+                error = ATTITUDE_BenchmarkError(out[i][j], exact[j]);
+                if(error > result->maxError[j])
+                    result->maxError[j] = error;
+            }
+        }
+        cycles[2] += ATTITUDE_BenchmarkBlock(2, quat, out);
+        for(i = 0; i < ATTITUDE_BENCHMARK_BLOCK; i++)
+        {
+            ATTITUDE_BenchmarkExact(quat[i], exact);
+            error = ATTITUDE_BenchmarkError(out[i][2], exact[2]);
+            if(error > result->maxError[2])
+                result->maxError[2] = error;
+        }
+        cycles[3] += ATTITUDE_BenchmarkBlock(3, quat, out);
+    }
+    result->samples = ATTITUDE_BENCHMARK_SAMPLES;
+    result->referenceCycles = cycles[0] / ATTITUDE_BENCHMARK_SAMPLES;
+    result->eulerCycles = cycles[1] / ATTITUDE_BENCHMARK_SAMPLES;
+    result->yawCycles = cycles[2] / ATTITUDE_BENCHMARK_SAMPLES;
+    result->quaternionCycles = cycles[3] / ATTITUDE_BENCHMARK_SAMPLES;
+    for(j = 0; j < 3; j++)
+    {
+        if(result->maxError[j] > ATTITUDE_ERROR_BOUND)
+            return 1;
+    }
+    return 0;
+}
+#endif
@@ -0,0 +1,164 @@
+/**
+ * @file    attitude.h
+ * @author  Miaow
+ * @version 0.2.0
+ * @date    2026/10/16
+ * @brief
+ *          This file provides functions to manage the following
+ *          functionalities of attitude math:
+ *              1. Single precision atan2 and asin with polynomial approximations
+ *              2. q30 quaternion to Euler angles, or to yaw only
+ *              3. q30 quaternion to floating point quaternion
+ *              4. Cycle and accuracy benchmark against the double precision C library
+ *              5. Mahony filter fusing raw gyroscope and accelerometer samples
+ * @note
+ *          Minimum version of source file:
+ *              0.2.0
+ *          Only float operations are used, each of them is a single FPU
+ *          instruction on the Cortex-M4, nothing is promoted to double.
+ *          The q30 integers are converted to float without scaling: the
+ *          arguments of atan2 are ratios, so the 2^60 of the products cancels;
+ *          only the argument of asin is scaled, by a constant power of 2.
+ *          The benchmark also builds on the host, see tools/attitudebench.
+ *          The Mahony filter has no hardware dependency either, recorded
+ *          IMU logs can be replayed through it on the host, see tools/fusionlog.
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#ifndef __ATTITUDE_H
+#define __ATTITUDE_H
+
+#include "stdint.h"
+
+/**
+ * @brief atanʽ(3~6), ԽԽȷ, ÿһγ˼
+ * @note   atan
+ *         3    0.035
+ *         4    0.0047
+ *         5    0.00066
+ *         6    0.0001
+ *       asinatan2Ϳõ, ͬ; DMPԪľԼ0.1
+ */
+#ifndef ATTITUDE_ATAN_TERMS
+#define ATTITUDE_ATAN_TERMS         4
+#endif
+/**
+ * @brief ATTITUDE_Benchmark, C˫asin, atan2, sin, cos
+ */
+//#define ATTITUDE_USE_BENCHMARK
+
+#define ATTITUDE_RAD_TO_DEG         57.2957795f
+#define ATTITUDE_DEG_TO_RAD         0.0174532925f
+#define ATTITUDE_Q30                1073741824.0f
+
+/**
+ * @brief Mahony˲Ĭ
+ * @note kpԽԽżٶȼ, 쵫Ӱ; kiƫ, 0ʾ
+ */
+#define ATTITUDE_MAHONY_KP          1.0f
+#define ATTITUDE_MAHONY_KI          0.01f
+
+/**
+ * @brief ʱ,  @ref ATTITUDE_Benchmark
+ * @note Ϊÿ̬ƽֵ
+ */
+typedef struct {
+    uint32_t referenceCycles;//ԭĻ: Q30, ˫asin, atan2
+    uint32_t eulerCycles;//ATTITUDE_QuatToEuler
+    uint32_t yawCycles;//ATTITUDE_QuatToYaw
+    uint32_t quaternionCycles;//ATTITUDE_QuatFromQ30
+    float maxError[3];//pitch, roll, yaw˫Ƚ()
+    float referenceError;//ԭĻ(), Ҫ57.3
+    uint16_t samples;//Ե̬
+}ATTITUDE_BenchmarkTypedef;
+
+/**
+ * @brief Mahony˲
+ * @note kp, kiΪ, ʱ޸
+ */
+typedef struct {
+    float kp;//
+    float ki;//
+    float q[4];//̬Ԫ, ˳Ϊw, x, y, z
+    float __integral[3];//, Ƶƫ(rad/s)
+    uint8_t __aligned;//üٶȼȷʼ̬
+}ATTITUDE_MahonyTypedef;
+
+/**
+ * @brief Mahony˲ʼֵ
+ */
+#define ATTITUDE_MAHONY_INIT(kp, ki) \
+    {(kp), (ki), {1.0f, 0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, 0}
+
+/**
+ * @brief atan2
+ * @param y 
+ * @param x 
+ * @return , Χ -~, x, yΪ0ʱ0
+ */
+float ATTITUDE_Atan2(float y, float x);
+/**
+ * @brief asin
+ * @param x ֵ, -1~1ʱȡ߽
+ * @return , Χ -/2~/2
+ */
+float ATTITUDE_Asin(float x);
+/**
+ * @brief q30ʽԪתΪŷ
+ * @param quat q30ʽԪ, ˳Ϊw, x, y, z
+ * @param pitch (), Χ -90~90
+ * @param roll (), Χ -180~180
+ * @param yaw (), Χ -180~180
+ */
+void ATTITUDE_QuatToEuler(const long *quat, float *pitch, float *roll, float *yaw);
+/**
+ * @brief q30ʽԪתΪ, 㸩Ǻͺ
+ * @param quat q30ʽԪ, ˳Ϊw, x, y, z
+ * @return (), Χ -180~180
+ */
+float ATTITUDE_QuatToYaw(const long *quat);
+/**
+ * @brief q30ʽԪתΪ
+ * @param quat q30ʽԪ, ˳Ϊw, x, y, z
+ * @param q , ˳ͬquat
+ */
+void ATTITUDE_QuatFromQ30(const long *quat, float *q);
+/**
+ * @brief ԪתΪŷ
+ * @param q λԪ, ˳Ϊw, x, y, z
+ * @param pitch (), Χ -90~90
+ * @param roll (), Χ -180~180
+ * @param yaw (), Χ -180~180
+ */
+void ATTITUDE_QuatToEulerf(const float *q, float *pitch, float *roll, float *yaw);
+/**
+ * @brief һǺͼٶȼݸMahony˲
+ * @param filter ˲
+ * @param gyro ٶ(rad/s), ˳Ϊx, y, z
+ * @param accel ٶ, λ, ˳Ϊx, y, z; ȫΪ0ʱֻ
+ * @param dt (s)
+ * @note һٶȼֱȷǺͺ, Ǵ0ʼ;
+ *       ûд, ֻǻ, ỺƯ
+ */
+void ATTITUDE_MahonyUpdate(ATTITUDE_MahonyTypedef *filter, const float *gyro, const float *accel, float dt);
+/**
+ * @brief Mahony˲̬, һθ¶׼
+ * @param filter ˲
+ */
+void ATTITUDE_MahonyReset(ATTITUDE_MahonyTypedef *filter);
+/**
+ * @brief ȽATTITUDE_QuatToEulerԭ˫Ȼĺʱ
+ * @param result ͳƽ
+ * @return 0-ATTITUDE_ATAN_TERMSӦķΧ; 1-
+ * @note 趨ATTITUDE_USE_BENCHMARK, ȡ-80~80, ܿ
+ */
+uint8_t ATTITUDE_Benchmark(ATTITUDE_BenchmarkTypedef *result);
+
+#endif
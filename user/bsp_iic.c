@@ -1,7 +1,7 @@
 /**
  * @file    bsp_iic.c
  * @author  Miaow
- * @version 0.1.0
+ * @version 0.10.0
  * @date    2018/08/30
  * @brief   
  *          This file provides functions to manage the following 
@@ -9,9 +9,18 @@
  *              1. Initialization
  *              2. Write and read one byte
  *              3. Write and read registers of slave
+ *              4. Asynchronous transfer queue with callbacks
+ *              5. Bus speed setting and throughput measurement
+ *              6. Multiple bus instances
+ *              7. Transfer priorities, chunked bulk writes and queue statistics
+ *              8. Transfer tracing with binary dump over USART
+ *              9. Long reads and scatter-gather reads in one transaction
+ *              10. Register init tables with burst writes and status polling
  * @note
  *          Minimum version of header file:
- *              0.1.0
+ *              0.10.0
+ *          Hardware IIC is implemented in bsp_iic_hw.c
+ *          Timer+DMA waveform IIC is implemented in bsp_iic_wave.c
  *          Recommanded pin connection:
  *               
  *               PB8SCL     
@@ -29,278 +38,1077 @@
  */
 
 #include "bsp_iic.h"
+#include "cyclecounter.h"
 
-static void IIC_DelayUs(uint32_t us);
-static uint8_t isInitialized = 0;
+/**
+ * @brief Ĭ
+ */
+#if defined(IIC_USE_HARDWARE)
+IIC_BusTypedef IIC_DefaultBus = IIC_BUS_INIT(IIC_BACKEND_HARDWARE, IIC_SCL_PORT, IIC_SCL_PIN, IIC_SDA_PORT, IIC_SDA_PIN, IIC_SPEED);
+#elif defined(IIC_USE_WAVE)
+IIC_BusTypedef IIC_DefaultBus = IIC_BUS_INIT(IIC_BACKEND_WAVE, IIC_SCL_PORT, IIC_SCL_PIN, IIC_SDA_PORT, IIC_SDA_PIN, IIC_SPEED);
+#else
+IIC_BusTypedef IIC_DefaultBus = IIC_BUS_INIT(IIC_BACKEND_SOFTWARE, IIC_SCL_PORT, IIC_SCL_PIN, IIC_SDA_PORT, IIC_SDA_PIN, IIC_SPEED);
+#endif
+
+/**
+ * @brief ѳʼ, PendSVδ
+ */
+static IIC_BusTypedef *iicBuses[IIC_MAX_BUSES];
+static uint8_t iicBusCount = 0;
+
+#ifdef IIC_USE_TRACE
+/**
+ * @brief ټ¼Ļλ
+ */
+static struct {
+    IIC_TraceRecordTypedef records[IIC_TRACE_SIZE];
+    uint32_t total;//ۼƼ¼, һrecords[(total - 1) % IIC_TRACE_SIZE]
+    uint8_t paused;//ڼ䲻¼
+}iicTrace;
+#endif
+
+//GPIO
+#define IIC_In(bus)             (bus)->sdaPort->MODER &= ~(bus)->sdaModerMask//ģʽ
+#define IIC_Out(bus)            (bus)->sdaPort->MODER = ((bus)->sdaPort->MODER & ~(bus)->sdaModerMask) | (bus)->sdaModerOut//ģʽ
+#define IIC_SclHigh(bus)        (bus)->sclPort->BSRRL = (bus)->sclPin
+#define IIC_SclLow(bus)         (bus)->sclPort->BSRRH = (bus)->sclPin
+#define IIC_SdaHigh(bus)        (bus)->sdaPort->BSRRL = (bus)->sdaPin
+#define IIC_SdaLow(bus)         (bus)->sdaPort->BSRRH = (bus)->sdaPin
+#define IIC_SdaRead(bus)        ((bus)->sdaPort->IDR & (bus)->sdaPin)
+
+/**
+ * @brief , IICʹ
+ * @return 0-ɹ; 1-
+ * @note ڶжͬʱ, ڹжϵ²
+ */
+uint8_t IIC_QueuePush(IIC_BusTypedef *bus, IIC_TransferTypedef *transfer)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint8_t p = transfer->priority < IIC_PRIORITIES ? transfer->priority : IIC_PRIORITY_LOW;
+    uint8_t res = 1;
+    __disable_irq();
+    if(bus->queueCount[p] < IIC_QUEUE_SIZE)
+    {
+        transfer->submitCycles = CYCLECOUNTER_Read();
+        bus->queue[p][(bus->queueHead[p] + bus->queueCount[p]) % IIC_QUEUE_SIZE] = transfer;
+        bus->queueCount[p]++;
+        bus->stats[p].submitted++;
+        if(bus->queueCount[p] > bus->stats[p].maxDepth)
+            bus->stats[p].maxDepth = bus->queueCount[p];
+        res = 0;
+    }
+    else
+        bus->stats[p].rejected++;
+    __set_PRIMASK(primask);
+    return res;
+}
+
+/**
+ * @brief , IICʹ
+ * @return ȼߵķǿնеĶ, жΪʱNULL
+ */
+IIC_TransferTypedef *IIC_QueuePop(IIC_BusTypedef *bus)
+{
+    uint32_t primask = __get_PRIMASK();
+    IIC_TransferTypedef *transfer = NULL;
+    uint32_t wait;
+    uint8_t p;
+    __disable_irq();
+    for(p = 0; p < IIC_PRIORITIES; p++)
+    {
+        if(!bus->queueCount[p])
+            continue;
+        transfer = bus->queue[p][bus->queueHead[p]];
+        bus->queueHead[p] = (bus->queueHead[p] + 1) % IIC_QUEUE_SIZE;
+        bus->queueCount[p]--;
+        wait = CYCLECOUNTER_Read() - transfer->submitCycles;
+        bus->stats[p].started++;
+        bus->stats[p].totalWaitCycles += wait;
+        if(wait > bus->stats[p].maxWaitCycles)
+            bus->stats[p].maxWaitCycles = wait;
+        break;
+    }
+    __set_PRIMASK(primask);
+    return transfer;
+}
 
 /**
- * @brief ׼΢뼶ʱ
+ * @brief ɵĴصбPendSV, IICжʹ
+ * @note ûлصĴֱӺ
  */
-static inline void IIC_DelayUs(uint32_t us)
+void IIC_DonePush(IIC_BusTypedef *bus, IIC_TransferTypedef *transfer)
 {
-    us <<= 2;
-    while(us--);
+    uint32_t primask;
+    if(!transfer->callback)
+        return;
+    primask = __get_PRIMASK();
+    __disable_irq();
+    transfer->next = NULL;
+    if(bus->doneTail)
+        bus->doneTail->next = transfer;
+    else
+        bus->doneHead = transfer;
+    bus->doneTail = transfer;
+    __set_PRIMASK(primask);
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
 }
+
 /**
- * @brief ʼIIC
+ * @brief εɴĻص, PendSV
  */
-void IIC_Init()
+static void IIC_DoneProcess(IIC_BusTypedef *bus)
 {
-    if(isInitialized)
+    IIC_TransferTypedef *transfer;
+
+    while(1)
+    {
+        __disable_irq();
+        transfer = bus->doneHead;
+        if(transfer)
+        {
+            bus->doneHead = transfer->next;
+            if(!bus->doneHead)
+                bus->doneTail = NULL;
+        }
+        __enable_irq();
+        if(!transfer)
+            break;
+        transfer->callback(transfer);
+    }
+}
+
+/**
+ * @brief ȡͳϢ
+ * @param bus ʵ
+ * @param priority ȼ
+ * @param stats ͳϢ
+ * @note IICд, ͳ; ӲIICдȼ
+ */
+void IIC_BusGetStatistics(IIC_BusTypedef *bus, IIC_PriorityTypedef priority, IIC_QueueStatisticsTypedef *stats)
+{
+    uint32_t primask = __get_PRIMASK();
+    if(priority >= IIC_PRIORITIES)
         return;
+    __disable_irq();
+    *stats = bus->stats[priority];
+    stats->depth = bus->queueCount[priority];
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief ͳϢ, ǰȲ
+ * @param bus ʵ
+ */
+void IIC_BusResetStatistics(IIC_BusTypedef *bus)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint8_t p;
+    __disable_irq();
+    for(p = 0; p < IIC_PRIORITIES; p++)
+    {
+        bus->stats[p].submitted = 0;
+        bus->stats[p].rejected = 0;
+        bus->stats[p].started = 0;
+        bus->stats[p].maxDepth = bus->queueCount[p];
+        bus->stats[p].maxWaitCycles = 0;
+        bus->stats[p].totalWaitCycles = 0;
+    }
+    __set_PRIMASK(primask);
+}
+
+#ifdef IIC_USE_TRACE
+/**
+ * @brief һټ¼, IICʹ
+ * @param bus ʵ
+ * @param transfer ѽĴ, ¼ַ, , ״̬͵
+ * @param start ʼʱ, ʱȡǰʱ
+ * @note IICжϺPendSVͬʱ, ڹжϵ²
+ */
+void IIC_TraceAdd(IIC_BusTypedef *bus, IIC_TransferTypedef *transfer, uint32_t start)
+{
+    uint32_t primask = __get_PRIMASK();
+    IIC_TraceRecordTypedef *record;
+    uint8_t index = 0;
+
+    while(index < iicBusCount && iicBuses[index] != bus)
+        index++;
+    __disable_irq();
+    if(!iicTrace.paused)
+    {
+        record = &iicTrace.records[iicTrace.total++ % IIC_TRACE_SIZE];
+        record->start = start;
+        record->end = CYCLECOUNTER_Read();
+        record->caller = transfer->caller;
+        record->len = transfer->len;
+        record->addr = transfer->addr;
+        record->reg = transfer->reg;
+        record->flags = (transfer->status & IIC_TRACE_FLAG_STATUS) | (transfer->isRead ? IIC_TRACE_FLAG_READ : 0) | ((index & 0x03) << IIC_TRACE_FLAG_BUS_POS);
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief ոټ¼
+ */
+void IIC_TraceClear()
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    iicTrace.total = 0;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 1ֽڲУ
+ */
+static void IIC_TraceSendByte(uint8_t data, uint16_t *checksum)
+{
+    while(!(IIC_TRACE_USART->SR & USART_SR_TC));//ȴһֽڷ
+    IIC_TRACE_USART->DR = data;
+    *checksum += data;
+}
+
+/**
+ * @brief С˷ֽ
+ */
+static void IIC_TraceSend(uint32_t value, uint8_t size, uint16_t *checksum)
+{
+    while(size--)
+    {
+        IIC_TraceSendByte(value & 0xFF, checksum);
+        value >>= 8;
+    }
+}
+
+/**
+ * @brief ԶƸʽIIC_TRACE_USARTиټ¼, Ȼ
+ * @note ڼͣ¼, ݿԺprintfıһ, ʱħ
+ *       ʽ(С):
+ *          "IICT"      ħ
+ *          uint8_t     ʽ汾, ǰΪ2
+ *          uint8_t     ÿ¼ֽ, ǰΪ20
+ *          uint16_t    ¼n
+ *          uint32_t    ںʱƵ(Hz)
+ *          uint32_t    ۼƼ¼, ȥnǵ
+ *          n¼     Ӿɵ, ÿΪstart, end, caller, len, addr, reg, flags, 3ֽڱ
+ *          uint16_t    ֽڵۼӺ
+ */
+void IIC_TraceDump()
+{
+    IIC_TraceRecordTypedef *record;
+    uint16_t checksum = 0;
+    uint32_t total, count, i;
+
+    iicTrace.paused = 1;
+    total = iicTrace.total;
+    count = total < IIC_TRACE_SIZE ? total : IIC_TRACE_SIZE;
+    IIC_TraceSend('I' | 'I' << 8 | 'C' << 16 | (uint32_t)'T' << 24, 4, &checksum);
+    IIC_TraceSend(2, 1, &checksum);
+    IIC_TraceSend(sizeof(IIC_TraceRecordTypedef), 1, &checksum);
+    IIC_TraceSend(count, 2, &checksum);
+    IIC_TraceSend(CYCLECOUNTER_CORE_CLOCK, 4, &checksum);
+    IIC_TraceSend(total, 4, &checksum);
+    for(i = total - count; i != total; i++)
+    {
+        record = &iicTrace.records[i % IIC_TRACE_SIZE];
+        IIC_TraceSend(record->start, 4, &checksum);
+        IIC_TraceSend(record->end, 4, &checksum);
+        IIC_TraceSend(record->caller, 4, &checksum);
+        IIC_TraceSend(record->len, 2, &checksum);
+        IIC_TraceSend(record->addr, 1, &checksum);
+        IIC_TraceSend(record->reg, 1, &checksum);
+        IIC_TraceSend(record->flags, 1, &checksum);
+        IIC_TraceSend(0, 3, &checksum);
+    }
+    IIC_TraceSend(checksum, 2, &checksum);
+    iicTrace.total = 0;
+    iicTrace.paused = 0;
+}
+#endif
+
+/**
+ * @brief ǷʹӲIIC
+ */
+static inline uint8_t IIC_IsHardware(IIC_BusTypedef *bus)
+{
+#ifdef IIC_USE_HARDWARE
+    return bus->backend == IIC_BACKEND_HARDWARE;
+#else
+    return 0;//δӲIICʱIIC
+#endif
+}
+
+/**
+ * @brief ǷʹòIIC
+ */
+static inline uint8_t IIC_IsWave(IIC_BusTypedef *bus)
+{
+#ifdef IIC_USE_WAVE
+    return bus->backend == IIC_BACKEND_WAVE;
+#else
+    return 0;//δIICʱIIC
+#endif
+}
+
+/**
+ * @brief һεƽ仯ʼȴָ, Ȼµǰʱ
+ * @param bus ʵ
+ * @param cycles 
+ * @note εȴ֮GPIOĺʱѰ, Żȼ޹
+ */
+static inline void IIC_Wait(IIC_BusTypedef *bus, uint32_t cycles)
+{
+    while(CYCLECOUNTER_Read() - bus->edge < cycles);
+    bus->edge = CYCLECOUNTER_Read();
+}
+
+/**
+ * @brief ʼSCL͵ƽ͸ߵƽ
+ * @note 60%:40%, ¶tLOWtHIGHСֵ
+ */
+static inline void IIC_SoftSetTiming(IIC_BusTypedef *bus, uint32_t speed)
+{
+    bus->speed = speed;
+    bus->lowCycles = CYCLECOUNTER_CORE_CLOCK / speed * 3 / 5;
+    bus->highCycles = CYCLECOUNTER_CORE_CLOCK / speed * 2 / 5;
+}
+
+/**
+ * @brief ʼIICGPIO
+ */
+static void IIC_SoftInit(IIC_BusTypedef *bus)
+{
     GPIO_InitTypeDef GPIO_InitStructure;
-    RCC_AHB1PeriphClockCmd(IIC_SCL_GPIO_CLK | IIC_SDA_GPIO_CLK, ENABLE);//ʹGPIOʱ
+    uint8_t sdaIndex = 0;
+
+    while(!(bus->sdaPin & (1 << sdaIndex)))
+        sdaIndex++;
+    bus->sdaModerMask = 0x3UL << (sdaIndex * 2);
+    bus->sdaModerOut = 0x1UL << (sdaIndex * 2);
+    IIC_SoftSetTiming(bus, bus->speed ? bus->speed : IIC_SPEED);
+    RCC_AHB1PeriphClockCmd(IIC_GpioClock(bus->sclPort) | IIC_GpioClock(bus->sdaPort), ENABLE);//ʹGPIOʱ
     //SCL, SDAʼ
-    GPIO_InitStructure.GPIO_Pin = IIC_SCL_PIN;
+    GPIO_InitStructure.GPIO_Pin = bus->sclPin;
     GPIO_InitStructure.GPIO_Mode = GPIO_Mode_OUT;//ͨģʽ
     GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;//
     GPIO_InitStructure.GPIO_Speed = GPIO_Fast_Speed;//50MHz
     GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_UP;//
-    GPIO_Init(IIC_SCL_PORT, &GPIO_InitStructure);//ʼ
-    GPIO_InitStructure.GPIO_Pin = IIC_SDA_PIN;
-    GPIO_Init(IIC_SDA_PORT, &GPIO_InitStructure);//ʼ
-    IIC_SCL_PORT->BSRRL = IIC_SCL_PIN;//IIC_SCL=1
-    IIC_SDA_PORT->BSRRL = IIC_SDA_PIN;//IIC_SDA=1
-    isInitialized = 1;
+    GPIO_Init(bus->sclPort, &GPIO_InitStructure);//ʼ
+    GPIO_InitStructure.GPIO_Pin = bus->sdaPin;
+    GPIO_Init(bus->sdaPort, &GPIO_InitStructure);//ʼ
+    IIC_SclHigh(bus);//IIC_SCL=1
+    IIC_SdaHigh(bus);//IIC_SDA=1
+    bus->edge = CYCLECOUNTER_Read();
 }
+
 /**
- * @brief ʼź
+ * @brief ʼ, ظ
+ * @param bus ʵ
+ * @return 0-; 1-IIC_MAX_BUSES, ûгʼ
  */
-void IIC_Start()
+uint8_t IIC_BusInit(IIC_BusTypedef *bus)
 {
-    IIC_Out();//sda
-    IIC_SDA_PORT->BSRRL = IIC_SDA_PIN;//IIC_SDA=1      
-    IIC_SCL_PORT->BSRRL = IIC_SCL_PIN;//IIC_SCL=1
-    IIC_DelayUs(4);
-    IIC_SDA_PORT->BSRRH = IIC_SDA_PIN;//IIC_SDA=0 START:when CLK is high,DATA change form high to low 
-    IIC_DelayUs(4);
-    IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//ǯסI2Cߣ׼ͻ 
+    if(bus->isInitialized)
+        return 0;
+    if(iicBusCount >= IIC_MAX_BUSES)
+        return 1;//PendSVֻǼǹ, ߶вᱻִ
+    CYCLECOUNTER_Init();
+#ifdef IIC_USE_HARDWARE
+    if(IIC_IsHardware(bus))
+        IIC_HwInit(bus);
+    else
+#endif
+#ifdef IIC_USE_WAVE
+    if(IIC_IsWave(bus))
+        IIC_WaveInit(bus);
+    else
+#endif
+        IIC_SoftInit(bus);
+    iicBuses[iicBusCount++] = bus;
+    NVIC_SetPriority(IIC_BACKGROUND_IRQCHANNEL, 0x0F);//첽ȼ
+    bus->isInitialized = 1;
+    return 0;
+}
+
+/**
+ * @brief 
+ * @param bus ʵ
+ * @param speed (Hz), IIC_SPEED_STANDARD, IIC_SPEED_FAST, IIC_SPEED_FAST_PLUS
+ * @return 0-; 1-ָ֧
+ * @note IIC֧1MHzڵ, ʵGPIOתٶ
+ */
+uint8_t IIC_BusSetSpeed(IIC_BusTypedef *bus, uint32_t speed)
+{
+#ifdef IIC_USE_HARDWARE
+    if(IIC_IsHardware(bus))
+        return IIC_HwSetSpeed(bus, speed);
+#endif
+#ifdef IIC_USE_WAVE
+    if(IIC_IsWave(bus))
+        return IIC_WaveSetSpeed(bus, speed);
+#endif
+    if(speed == 0 || speed > IIC_SPEED_FAST_PLUS)
+        return 1;
+    IIC_SoftSetTiming(bus, speed);
+    return 0;
+}
+
+/**
+ * @brief ʼź, IIC
+ * @param bus ʵ
+ */
+void IIC_BusStart(IIC_BusTypedef *bus)
+{
+    IIC_Out(bus);//sda
+    IIC_SdaHigh(bus);//IIC_SDA=1      
+    IIC_Wait(bus, bus->lowCycles);//ظʼǰSCLΪ
+    IIC_SclHigh(bus);//IIC_SCL=1
+    IIC_Wait(bus, bus->highCycles);//tSU;STA
+    IIC_SdaLow(bus);//IIC_SDA=0 START:when CLK is high,DATA change form high to low 
+    IIC_Wait(bus, bus->highCycles);//tHD;STA
+    IIC_SclLow(bus);//ǯסI2Cߣ׼ͻ 
 }      
 /**
- * @brief ֹͣź
+ * @brief ֹͣź, IIC
+ * @param bus ʵ
  */
-void IIC_Stop()
+void IIC_BusStop(IIC_BusTypedef *bus)
 {
-    IIC_Out();//sda
-    IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0
-    IIC_SDA_PORT->BSRRH = IIC_SDA_PIN;//IIC_SDA=0 STOP:when CLK is high DATA change form low to high
-    IIC_DelayUs(4);
-    IIC_SCL_PORT->BSRRL = IIC_SCL_PIN;//IIC_SCL=1
-    IIC_SDA_PORT->BSRRL = IIC_SDA_PIN;//IIC_SDA=1 I2C߽ź
-    IIC_DelayUs(4);                                   
+    IIC_Out(bus);//sda
+    IIC_SclLow(bus);//IIC_SCL=0
+    IIC_SdaLow(bus);//IIC_SDA=0 STOP:when CLK is high DATA change form low to high
+    IIC_Wait(bus, bus->lowCycles);
+    IIC_SclHigh(bus);//IIC_SCL=1
+    IIC_Wait(bus, bus->highCycles);//tSU;STO
+    IIC_SdaHigh(bus);//IIC_SDA=1 I2C߽ź
+    IIC_Wait(bus, bus->lowCycles);//tBUF
 }
 /**
- * @brief ȴӦź
+ * @brief ȴӦź, IIC
+ * @param bus ʵ
  * @return 1-Ӧʧ; 0-Ӧɹ
  */
-uint8_t IIC_WaitAck()
+uint8_t IIC_BusWaitAck(IIC_BusTypedef *bus)
 {
     uint8_t ucErrTime=0;
-    IIC_In();//SDAΪ  
-    IIC_SDA_PORT->BSRRL = IIC_SDA_PIN;//IIC_SDA=1
-    IIC_DelayUs(1);       
-    IIC_SCL_PORT->BSRRL = IIC_SCL_PIN;//IIC_SCL=1
-    IIC_DelayUs(1);     
-    while(IIC_SDA_PORT->IDR & IIC_SDA_PIN)
+    IIC_In(bus);//SDAΪ  
+    IIC_SdaHigh(bus);//IIC_SDA=1
+    IIC_Wait(bus, bus->lowCycles);
+    IIC_SclHigh(bus);//IIC_SCL=1
+    IIC_Wait(bus, bus->highCycles);
+    while(IIC_SdaRead(bus))
     {
         ucErrTime++;
         if(ucErrTime>250)
         {
-            IIC_Stop();
+            IIC_BusStop(bus);
             return 1;
         }
     }
-    IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0 ʱ0        
+    IIC_SclLow(bus);//IIC_SCL=0 ʱ0        
+    bus->edge = CYCLECOUNTER_Read();
     return 0;  
 } 
 /**
- * @brief Ӧź
+ * @brief Ӧź, IIC
+ * @param bus ʵ
  */
-void IIC_Ack()
+void IIC_BusAck(IIC_BusTypedef *bus)
 {
-    IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0
-    IIC_Out();
-    IIC_SDA_PORT->BSRRH = IIC_SDA_PIN;//IIC_SDA=0
-    IIC_DelayUs(2);
-    IIC_SCL_PORT->BSRRL = IIC_SCL_PIN;//IIC_SCL=1
-    IIC_DelayUs(2);
-    IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0
+    IIC_SclLow(bus);//IIC_SCL=0
+    IIC_Out(bus);
+    IIC_SdaLow(bus);//IIC_SDA=0
+    IIC_Wait(bus, bus->lowCycles);
+    IIC_SclHigh(bus);//IIC_SCL=1
+    IIC_Wait(bus, bus->highCycles);
+    IIC_SclLow(bus);//IIC_SCL=0
 }
 /**
- * @brief Ӧź
+ * @brief Ӧź, IIC
+ * @param bus ʵ
  */           
-void IIC_NAck()
-{
-    IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0
-    IIC_Out();
-    IIC_SDA_PORT->BSRRL = IIC_SDA_PIN;//IIC_SDA=1
-    IIC_DelayUs(2);
-    IIC_SCL_PORT->BSRRL = IIC_SCL_PIN;//IIC_SCL=1
-    IIC_DelayUs(2);
-    IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0
+void IIC_BusNAck(IIC_BusTypedef *bus)
+{
+    IIC_SclLow(bus);//IIC_SCL=0
+    IIC_Out(bus);
+    IIC_SdaHigh(bus);//IIC_SDA=1
+    IIC_Wait(bus, bus->lowCycles);
+    IIC_SclHigh(bus);//IIC_SCL=1
+    IIC_Wait(bus, bus->highCycles);
+    IIC_SclLow(bus);//IIC_SCL=0
 }                                          
 /**
- * @brief IICһֽ
- * @return 1-Ack; 0-Ack
+ * @brief һֽ, IIC
+ * @param bus ʵ
+ * @param data Ҫ͵ֽ
  */      
-void IIC_WriteByte(uint8_t data)
+void IIC_BusWriteByte(IIC_BusTypedef *bus, uint8_t data)
 {                        
     uint8_t i;   
-    IIC_Out();         
-    IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0 ʱӿʼݴ
+    IIC_Out(bus);         
+    IIC_SclLow(bus);//IIC_SCL=0 ʱӿʼݴ
     for(i = 0; i < 8; i++)
     {            
         if((data & 0x80) >> 7)
-            IIC_SDA_PORT->BSRRL = IIC_SDA_PIN;//IIC_SDA=1
+            IIC_SdaHigh(bus);//IIC_SDA=1
         else
-            IIC_SDA_PORT->BSRRH = IIC_SDA_PIN;//IIC_SDA=0
+            IIC_SdaLow(bus);//IIC_SDA=0
         data <<= 1;       
-        IIC_DelayUs(2);   //TEA5767ʱǱ
-        IIC_SCL_PORT->BSRRL = IIC_SCL_PIN;//IIC_SCL=1
-        IIC_DelayUs(2); 
-        IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0
-        IIC_DelayUs(2);
+        IIC_Wait(bus, bus->lowCycles);
+        IIC_SclHigh(bus);//IIC_SCL=1
+        IIC_Wait(bus, bus->highCycles);
+        IIC_SclLow(bus);//IIC_SCL=0
     }     
 }         
 /**
- * @brief 1ֽ
+ * @brief 1ֽ, IIC
+ * @param bus ʵ
  * @param ack
  *          1-Ӧ
  *          0-ͷӦ
  * @return ضȡһֽ
  */ 
-uint8_t IIC_ReadByte(uint8_t ack)
+uint8_t IIC_BusReadByte(IIC_BusTypedef *bus, uint8_t ack)
 {
     uint8_t i, receive = 0;
-    IIC_In();//SDAΪ
+    IIC_In(bus);//SDAΪ
     for(i = 0; i < 8; i++)
     {
-        IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0 
-        IIC_DelayUs(2);
-        IIC_SCL_PORT->BSRRL = IIC_SCL_PIN;//IIC_SCL=1
+        IIC_SclLow(bus);//IIC_SCL=0 
+        IIC_Wait(bus, bus->lowCycles);
+        IIC_SclHigh(bus);//IIC_SCL=1
+        IIC_Wait(bus, bus->highCycles);
         receive <<= 1;
-        if(IIC_SDA_PORT->IDR & IIC_SDA_PIN)
+        if(IIC_SdaRead(bus))//ߵƽĩβ
             receive++;   
-        IIC_DelayUs(1); 
     }                     
     if (!ack)
-        IIC_NAck();//nACK
+        IIC_BusNAck(bus);//nACK
     else
-        IIC_Ack(); //ACK   
+        IIC_BusAck(bus); //ACK   
     return receive;
 }
 /**
- * @brief IICд1ֽڵĴ
+ * @brief IICд
+ * @param bus ʵ
  * @param addr ַ
  * @param reg Ĵַ
+ * @param len дֽ
  * @param data Ҫд
  * @return 0-; 1-
  */
-uint8_t IIC_WriteRegByte(uint8_t addr, uint8_t reg, uint8_t data)
+static uint8_t IIC_SoftWriteRegBytes(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint16_t len, uint8_t *data)
+{
+    uint16_t i; 
+    IIC_BusStart(bus); 
+    IIC_BusWriteByte(bus, addr << 1);//ַ+д    
+    if(IIC_BusWaitAck(bus))//ȴӦ
+    {
+        IIC_BusStop(bus);         
+        return 1;        
+    }
+    IIC_BusWriteByte(bus, reg);//дĴַ
+    IIC_BusWaitAck(bus);//ȴӦ
+    for(i = 0; i < len; i++)
+    {
+        IIC_BusWriteByte(bus, data[i]);//
+        if(IIC_BusWaitAck(bus))//ȴACK
+        {
+            IIC_BusStop(bus);     
+            return 1;         
+        }        
+    }    
+    IIC_BusStop(bus);     
+    return 0;    
+} 
+/**
+ * @brief IICֶζ, ֮䲻ֹͣ
+ * @param bus ʵ
+ * @param addr ַ
+ * @param reg Ĵַ
+ * @param segments εĻֽ
+ * @param count 
+ * @return 0-; 1-
+ */
+static uint8_t IIC_SoftReadRegSegments(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, const IIC_SegmentTypedef *segments, uint8_t count)
 { 
-    IIC_Start(); 
-	IIC_WriteByte(addr << 1);//ַ+д	
-	if(IIC_WaitAck())	//ȴӦ
-	{
-		IIC_Stop();		 
-		return 1;		
-	}
-    IIC_WriteByte(reg);	//дĴַ
-    IIC_WaitAck();		//ȴӦ 
-	IIC_WriteByte(data);//
-	if(IIC_WaitAck())	//ȴACK
-	{
-		IIC_Stop();	 
-		return 1;		 
-	}		 
-    IIC_Stop();	 
-	return 0;
-}
-/**
- * @brief IIC1ֽڵĴ
+    uint8_t *data;
+    uint16_t len;
+    IIC_BusStart(bus); 
+    IIC_BusWriteByte(bus, addr<<1);//ַ+д    
+    if(IIC_BusWaitAck(bus))//ȴӦ
+    {
+        IIC_BusStop(bus);         
+        return 1;        
+    }
+    IIC_BusWriteByte(bus, reg);//дĴַ
+    IIC_BusWaitAck(bus);//ȴӦ
+    IIC_BusStart(bus);
+    IIC_BusWriteByte(bus, (addr << 1) | 1);//ַ+    
+    IIC_BusWaitAck(bus);//ȴӦ 
+    while(count--)
+    {
+        data = segments->data;
+        len = segments->len;
+        segments++;
+        while(len)
+        {
+            if(len == 1 && !count)
+                *data=IIC_BusReadByte(bus, 0);//һεһֽ,nACK 
+            else
+                *data=IIC_BusReadByte(bus, 1);//,ACK  
+            len--;
+            data++; 
+        }
+    }    
+    IIC_BusStop(bus);//һֹͣ 
+    return 0;    
+}
+
+/**
+ * @brief IICִһ
+ * @param bus ʵ
+ * @param transfer 
+ * @return 0-; 1-
+ */
+static uint8_t IIC_SoftExecute(IIC_BusTypedef *bus, IIC_TransferTypedef *transfer)
+{
+    IIC_SegmentTypedef segment;
+    if(!transfer->isRead)
+        return IIC_SoftWriteRegBytes(bus, transfer->addr, transfer->reg, transfer->len, transfer->data);
+    if(transfer->segments)
+        return IIC_SoftReadRegSegments(bus, transfer->addr, transfer->reg, transfer->segments, transfer->segmentCount);
+    segment.data = transfer->data;
+    segment.len = transfer->len;
+    return IIC_SoftReadRegSegments(bus, transfer->addr, transfer->reg, &segment, 1);
+}
+
+/**
+ * @brief дʼ, ֹPendSVڴڼ䴦ߵĶ
+ */
+static inline void IIC_Lock(IIC_BusTypedef *bus)
+{
+    bus->lock++;
+}
+
+/**
+ * @brief д, ϱƳٵĶд
+ */
+static inline void IIC_Unlock(IIC_BusTypedef *bus)
+{
+    if(--bus->lock == 0 && bus->deferred)
+    {
+        bus->deferred = 0;
+        SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+    }
+}
+
+/**
+ * @brief ִһ, ݺ˷ַ
+ * @param bus ʵ
+ * @param transfer addr, reg, isRead, len, data, segments, caller
+ * @return 0-; 1-
+ */
+static uint8_t IIC_BusExecute(IIC_BusTypedef *bus, IIC_TransferTypedef *transfer)
+{
+    uint8_t res;
+#ifdef IIC_USE_TRACE
+    uint32_t start = CYCLECOUNTER_Read();
+#endif
+    transfer->priority = IIC_PRIORITY_LOW;
+    transfer->callback = NULL;
+#ifdef IIC_USE_HARDWARE
+    if(IIC_IsHardware(bus))
+        return IIC_HwTransfer(bus, transfer);//ӲIIC˼¼
+#endif
+#ifdef IIC_USE_WAVE
+    if(IIC_IsWave(bus))
+        return IIC_WaveTransfer(bus, transfer);//ɲIIC˼¼
+#endif
+    if(bus->lock && __get_IPSR())
+    {
+        //жϴ˸ϽеĴ, ȴ, ʱ
+        transfer->status = IIC_STATUS_ERROR;
+        return 1;
+    }
+    IIC_Lock(bus);
+    res = IIC_SoftExecute(bus, transfer);
+    IIC_Unlock(bus);
+    transfer->status = res ? IIC_STATUS_ERROR : IIC_STATUS_OK;
+#ifdef IIC_USE_TRACE
+    IIC_TraceAdd(bus, transfer, start);
+#endif
+    return res;
+}
+
+/**
+ * @brief һ
+ * @param caller ӿڵĵߵַ, ڸ
+ * @return 0-; 1-
+ */
+static uint8_t IIC_BusTransfer(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint16_t len, uint8_t *data, uint8_t isRead, uint32_t caller)
+{
+    IIC_TransferTypedef transfer;
+    transfer.addr = addr;
+    transfer.reg = reg;
+    transfer.isRead = isRead;
+    transfer.len = len;
+    transfer.data = data;
+    transfer.segments = NULL;
+    transfer.segmentCount = 0;
+    transfer.caller = caller;
+    return IIC_BusExecute(bus, &transfer);
+}
+
+/**
+ * @brief д1ֽڵĴ
+ * @param bus ʵ
+ * @param addr ַ
+ * @param reg Ĵַ
+ * @param data Ҫд
+ * @return 0-; 1-
+ */
+uint8_t IIC_BusWriteRegByte(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint8_t data)
+{
+    return IIC_BusTransfer(bus, addr, reg, 1, &data, 0, IIC_CALLER());
+}
+
+/**
+ * @brief 1ֽڼĴ
+ * @param bus ʵ
  * @param addr ַ
  * @param reg Ĵַ
  * @return Ҫȡ
  */
-uint8_t IIC_ReadRegByte(uint8_t addr, uint8_t reg)
+uint8_t IIC_BusReadRegByte(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg)
 {
-	uint8_t res;
-    IIC_Start(); 
-	IIC_WriteByte(addr << 1);//ַ+д	
-	IIC_WaitAck();//ȴӦ 
-    IIC_WriteByte(reg);//дĴַ
-    IIC_WaitAck();//ȴӦ
-    IIC_Start();
-	IIC_WriteByte((addr << 1) | 1);//ַ+	
-    IIC_WaitAck();//ȴӦ 
-	res = IIC_ReadByte(0);//ȡ,nACK 
-    IIC_Stop();//һֹͣ 
-	return res;		
+    uint8_t res = 0;
+    IIC_BusTransfer(bus, addr, reg, 1, &res, 1, IIC_CALLER());
+    return res;
 }
 
 /**
- * @brief IICд
+ * @brief д
+ * @param bus ʵ
  * @param addr ַ
  * @param reg Ĵַ
  * @param len дֽ
  * @param data Ҫд
  * @return 0-; 1-
  */
-uint8_t IIC_WriteRegBytes(uint8_t addr, uint8_t reg, uint8_t len, uint8_t *data)
+uint8_t IIC_BusWriteRegBytes(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint8_t len, uint8_t *data)
 {
-    uint8_t i; 
-    IIC_Start(); 
-    IIC_WriteByte(addr << 1);//ַ+д    
-    if(IIC_WaitAck())//ȴӦ
+    return IIC_BusTransfer(bus, addr, reg, len, data, 0, IIC_CALLER());
+}
+
+/**
+ * @brief 
+ * @param bus ʵ
+ * @param addr ַ
+ * @param reg Ĵַ
+ * @param len ȡֽ
+ * @param data Ҫȡ
+ * @return 0-; 1-
+ */
+uint8_t IIC_BusReadRegBytes(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint8_t len, uint8_t *data)
+{
+    return IIC_BusTransfer(bus, addr, reg, len, data, 1, IIC_CALLER());
+}
+
+/**
+ * @brief , ȿɳ255ֽ
+ * @param bus ʵ
+ * @param addr ַ
+ * @param reg Ĵַ
+ * @param len ȡֽ
+ * @param data Ҫȡ
+ * @return 0-; 1-
+ */
+uint8_t IIC_BusReadRegBytesLong(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint16_t len, uint8_t *data)
+{
+    return IIC_BusTransfer(bus, addr, reg, len, data, 1, IIC_CALLER());
+}
+
+/**
+ * @brief ֶζ, һδ(һʼ/ֹͣź)ζ
+ * @param bus ʵ
+ * @param addr ַ
+ * @param reg Ĵַ
+ * @param segments εĻֽ, ÿ1ֽ
+ * @param count 
+ * @return 0-; 1-
+ * @note һζFIFOеĶݰ, ŵĻ, ֽ65535
+ */
+uint8_t IIC_BusReadRegScatter(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, const IIC_SegmentTypedef *segments, uint8_t count)
+{
+    IIC_TransferTypedef transfer;
+    uint8_t i;
+    if(!count)
+        return 1;
+    transfer.addr = addr;
+    transfer.reg = reg;
+    transfer.isRead = 1;
+    transfer.len = 0;
+    for(i = 0; i < count; i++)
+        transfer.len += segments[i].len;
+    transfer.data = segments[0].data;
+    transfer.segments = segments;
+    transfer.segmentCount = count;
+    transfer.caller = IIC_CALLER();
+    return IIC_BusExecute(bus, &transfer);
+}
+
+/**
+ * @brief ֿд, Դȴ
+ * @param bus ʵ
+ * @param addr ַ
+ * @param reg Ĵַ, ÿ鶼·
+ * @param len дֽ
+ * @param data Ҫд
+ * @return 0-; 1-
+ * @note ÿһζ, ֮:
+ *       IICͷ, ƳٵPendSVִжеĴ;
+ *       ӲIICдǵȼ, ȼеĴȿʼ
+ */
+uint8_t IIC_BusWriteBulk(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint16_t len, uint8_t *data)
+{
+    uint32_t caller = IIC_CALLER();
+    uint8_t chunk;
+    while(len)
     {
-        IIC_Stop();         
-        return 1;        
+        chunk = len > IIC_CHUNK_SIZE ? IIC_CHUNK_SIZE : len;
+        if(IIC_BusTransfer(bus, addr, reg, chunk, data, 0, caller))
+            return 1;
+        data += chunk;
+        len -= chunk;
     }
-    IIC_WriteByte(reg);//дĴַ
-    IIC_WaitAck();//ȴӦ
-    for(i = 0; i < len; i++)
+    return 0;
+}
+
+/**
+ * @brief æȴ΢, DWTڼʱ
+ */
+static void IIC_DelayUs(uint32_t us)
+{
+    uint32_t begin = CYCLECOUNTER_Read();
+    uint32_t cycles = us * (CYCLECOUNTER_CORE_CLOCK / 1000000);
+    while(CYCLECOUNTER_Read() - begin < cycles);
+}
+
+/**
+ * @brief ִгʼPOLL/PROBE
+ * @param caller ӿڵĵߵַ, ڸ
+ * @return 0-; 1-ʱ
+ */
+static uint8_t IIC_InitPoll(IIC_BusTypedef *bus, const IIC_InitEntryTypedef *entry, uint32_t caller)
+{
+    uint32_t begin = CYCLECOUNTER_Read();
+    uint32_t timeout = (uint32_t)entry->delayMs * (CYCLECOUNTER_CORE_CLOCK / 1000);
+    uint8_t value;
+    while(1)
     {
-        IIC_WriteByte(data[i]);//
-        if(IIC_WaitAck())//ȴACK
+        if(entry->op == IIC_INIT_OP_PROBE)
         {
-            IIC_Stop();     
-            return 1;         
-        }        
-    }    
-    IIC_Stop();     
-    return 0;    
-} 
+            if(!IIC_BusTransfer(bus, entry->addr, entry->reg, 0, NULL, 0, caller))
+                return 0;
+        }
+        else if(!IIC_BusTransfer(bus, entry->addr, entry->reg, 1, &value, 1, caller)
+            && (value & entry->data[0]) == entry->data[1])
+            return 0;
+        if(CYCLECOUNTER_Read() - begin >= timeout)
+            return 1;
+        IIC_DelayUs(IIC_INIT_POLL_INTERVAL_US);
+    }
+}
+
+/**
+ * @brief жϳʼһܷںϲд
+ * @param first ϲĵһ
+ * @param entry ϲ
+ * @param len Ѻϲֽ
+ * @return 0-ܺϲ; 1-Ժϲ
+ */
+static inline uint8_t IIC_InitMergeable(const IIC_InitEntryTypedef *first, const IIC_InitEntryTypedef *entry, uint8_t len)
+{
+    if(entry->op != first->op || entry->addr != first->addr || len + entry->len > IIC_CHUNK_SIZE)
+        return 0;
+    if(first->op == IIC_INIT_OP_STREAM)
+        return entry->reg == first->reg;
+    return entry->reg == (uint8_t)(first->reg + len);
+}
+
+/**
+ * @brief ִгʼ
+ * @param bus ʵ
+ * @param table ʼ
+ * @param count 
+ * @return 0-; Ϊ+1, ϲдʱΪϲĵһ
+ */
+uint16_t IIC_BusRunInitTable(IIC_BusTypedef *bus, const IIC_InitEntryTypedef *table, uint16_t count)
+{
+    uint8_t burst[IIC_CHUNK_SIZE];
+    uint32_t caller = IIC_CALLER();
+    const IIC_InitEntryTypedef *first;
+    uint16_t i = 0, delayMs;
+    uint8_t len, j;
+    CYCLECOUNTER_Init();
+    while(i < count)
+    {
+        first = &table[i];
+        if(first->op == IIC_INIT_OP_POLL || first->op == IIC_INIT_OP_PROBE)
+        {
+            if(IIC_InitPoll(bus, first, caller))
+                return i + 1;
+            i++;
+            continue;
+        }
+        len = 0;
+        do
+        {
+            for(j = 0; j < table[i].len; j++)
+                burst[len++] = table[i].data[j];
+            delayMs = table[i++].delayMs;
+        }while(!delayMs && i < count && IIC_InitMergeable(first, &table[i], len));
+        if(IIC_BusTransfer(bus, first->addr, first->reg, len, burst, 0, caller))
+            return first - table + 1;
+        if(delayMs)
+            IIC_DelayUs((uint32_t)delayMs * 1000);
+    }
+    return 0;
+}
+
 /**
- * @brief IIC
+ * @brief һĺʱ, ڱȽIICӲIIC
+ * @param bus ʵ
  * @param addr ַ
  * @param reg Ĵַ
  * @param len ȡֽ
  * @param data Ҫȡ
+ * @param result ͳƽ
  * @return 0-; 1-
+ * @note IICȫռCPU, cpuCyclestotalCycles;
+ *       ӲIICͲIICֻͳжϷ
  */
-uint8_t IIC_ReadRegBytes(uint8_t addr, uint8_t reg, uint8_t len, uint8_t *data)
-{ 
-    IIC_Start(); 
-    IIC_WriteByte(addr<<1);//ַ+д    
-    if(IIC_WaitAck())//ȴӦ
+uint8_t IIC_BusBenchmark(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint8_t len, uint8_t *data, IIC_BenchmarkTypedef *result)
+{
+    uint32_t begin;
+    uint8_t res;
+    CYCLECOUNTER_Init();
+#ifdef IIC_USE_HARDWARE
+    uint32_t busyCycles = IIC_HwBusyCycles();
+#endif
+#ifdef IIC_USE_WAVE
+    uint32_t waveCycles = IIC_WaveBusyCycles();
+#endif
+    begin = CYCLECOUNTER_Read();
+    res = IIC_BusReadRegBytes(bus, addr, reg, len, data);
+    result->totalCycles = CYCLECOUNTER_Read() - begin;
+    result->cpuCycles = result->totalCycles;
+#ifdef IIC_USE_HARDWARE
+    if(IIC_IsHardware(bus))
+        result->cpuCycles = IIC_HwBusyCycles() - busyCycles;
+#endif
+#ifdef IIC_USE_WAVE
+    if(IIC_IsWave(bus))
+        result->cpuCycles = IIC_WaveBusyCycles() - waveCycles;
+#endif
+    return res;
+}
+
+/**
+ * @brief , ȡɴβͳÿֽ
+ * @param bus ʵ
+ * @param addr ַ
+ * @param reg Ĵַ
+ * @param len ÿζȡֽ
+ * @param times ȡ
+ * @return ֽ/, ַͼĴַ; ʱ0
+ */
+uint32_t IIC_BusMeasureThroughput(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint8_t len, uint8_t times)
+{
+    uint8_t buffer[255];
+    uint32_t begin, cycles;
+    uint8_t i;
+    if(!len || !times)
+        return 0;
+    CYCLECOUNTER_Init();
+    begin = CYCLECOUNTER_Read();
+    for(i = 0; i < times; i++)
     {
-        IIC_Stop();         
-        return 1;        
+        if(IIC_BusReadRegBytes(bus, addr, reg, len, buffer))
+            return 0;
     }
-    IIC_WriteByte(reg);//дĴַ
-    IIC_WaitAck();//ȴӦ
-    IIC_Start();
-    IIC_WriteByte((addr << 1) | 1);//ַ+    
-    IIC_WaitAck();//ȴӦ 
-    while(len)
+    cycles = CYCLECOUNTER_Read() - begin;
+    return (uint64_t)len * times * CYCLECOUNTER_CORE_CLOCK / cycles;
+}
+
+/**
+ * @brief ύһ첽, 
+ * @param bus ʵ
+ * @param transfer , addr, reg, isRead, len, data, priority, callback
+ * @return 0-Ѽ; 1-
+ * @note IICĴPendSVн, صҲPendSVִ
+ *       ÿִһ䶼´Ӹȼȡ, صύĸȼŵǰ
+ */
+uint8_t IIC_BusSubmit(IIC_BusTypedef *bus, IIC_TransferTypedef *transfer)
+{
+    transfer->caller = IIC_CALLER();
+#ifdef IIC_USE_HARDWARE
+    if(IIC_IsHardware(bus))
+        return IIC_HwSubmit(bus, transfer);
+#endif
+#ifdef IIC_USE_WAVE
+    if(IIC_IsWave(bus))
+        return IIC_WaveSubmit(bus, transfer);
+#endif
+    transfer->status = IIC_STATUS_PENDING;
+    if(IIC_QueuePush(bus, transfer))
     {
-        if(len == 1)
-            *data=IIC_ReadByte(0);//,nACK 
+        transfer->status = IIC_STATUS_ERROR;
+        return 1;
+    }
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;//̨
+    return 0;
+}
+
+/**
+ * @brief ִIIC߶еĴ䲢ûص
+ * @note ϵдʱƳٵִ
+ */
+static void IIC_SoftProcess(IIC_BusTypedef *bus)
+{
+    IIC_TransferTypedef *transfer;
+    if(bus->lock)
+    {
+        bus->deferred = 1;
+        return;
+    }
+    while((transfer = IIC_QueuePop(bus)) != NULL)
+    {
+        IIC_Lock(bus);//PendSVжϲڴ;д
+        transfer->status = IIC_SoftExecute(bus, transfer) ? IIC_STATUS_ERROR : IIC_STATUS_OK;
+        IIC_Unlock(bus);
+#ifdef IIC_USE_TRACE
+        IIC_TraceAdd(bus, transfer, transfer->submitCycles);
+#endif
+        if(transfer->callback)
+            transfer->callback(transfer);
+    }
+}
+
+/**
+ * @brief 첽ĺ̨, ȼ
+ * @note IICִжеĴ; ӲIICͲIICߵĴж, ֻûص
+ */
+void IIC_BACKGROUND_IRQHANDLER()
+{
+    uint8_t i;
+    for(i = 0; i < iicBusCount; i++)
+    {
+        if(IIC_IsHardware(iicBuses[i]) || IIC_IsWave(iicBuses[i]))
+            IIC_DoneProcess(iicBuses[i]);
         else
-            *data=IIC_ReadByte(1);//,ACK  
-        len--;
-        data++; 
-    }    
-    IIC_Stop();//һֹͣ 
-    return 0;    
+            IIC_SoftProcess(iicBuses[i]);
+    }
 }
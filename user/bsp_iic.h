@@ -1,7 +1,7 @@
 /**
  * @file    bsp_iic.h
  * @author  Miaow
- * @version 0.1.0
+ * @version 0.10.0
  * @date    2018/08/30
  * @brief   
  *          This file provides functions to manage the following 
@@ -9,7 +9,18 @@
  *              1. Initialization
  *              2. Write and read one byte
  *              3. Write and read registers of slave
+ *              4. Hardware IIC with DMA (optional)
+ *              5. Asynchronous transfer queue with callbacks
+ *              6. Bus speed setting and throughput measurement
+ *              7. Multiple bus instances
+ *              8. Transfer priorities, chunked bulk writes and queue statistics
+ *              9. Transfer tracing with binary dump over USART
+ *              10. Long reads and scatter-gather reads in one transaction
+ *              11. Register init tables with burst writes and status polling
+ *              12. Timer+DMA generated waveform instead of bit-banging (optional)
  * @note
+ *          Minimum version of source file:
+ *              0.10.0
  *          Recommanded pin connection:
  *               
  *               PB8SCL     
@@ -29,95 +40,594 @@
 #ifndef __BSP_IIC_H
 #define __BSP_IIC_H
 #include "sys.h"
+#include "stddef.h"
+#include "stdint.h"
 
-//GPIO
+//ĬߵGPIO, inv_mpu.cʹõIIC_xxx
 #define IIC_SCL_PORT        GPIOB
 #define IIC_SCL_PIN         GPIO_Pin_8
-#define IIC_SCL_GPIO_CLK    RCC_AHB1Periph_GPIOB
 #define IIC_SDA_PORT        GPIOB
 #define IIC_SDA_PIN         GPIO_Pin_9
-#define IIC_SDA_GPIO_CLK    RCC_AHB1Periph_GPIOB
-#define IIC_In()            IIC_SDA_PORT->MODER &= ~0x000C0000;IIC_SDA_PORT->MODER |= 0x00000000//ģʽ
-#define IIC_Out()           IIC_SDA_PORT->MODER &= ~0x000C0000;IIC_SDA_PORT->MODER |= 0x00040000//ģʽ
 
 /**
- * @brief ûнյӦźţ򷵻1
+ * @brief 
  */
-#define IIC_IF_NOT_ACK_RETURN_1     if(IIC_WaitAck()) {IIC_Stop(); return 1;}
+#define IIC_SPEED_STANDARD          100000//׼ģʽ
+#define IIC_SPEED_FAST              400000//ģʽ
+#define IIC_SPEED_FAST_PLUS         1000000//ǿģʽ, IICͲIIC֧
+/**
+ * @brief ϵĬϵ, ʱIIC_SetSpeed޸
+ */
+#define IIC_SPEED                   IIC_SPEED_FAST
+
 /**
- * @brief ʼź
+ * @brief ĬʹӲIIC+DMAģIIC
+ * @note ӲIIC̶ΪI2C1(PB8-SCL, PB9-SDA), 400KHz, ڼжϺDMA, ռCPU
+ *       ֻһʹӲIIC, ԿIIC
+ *       IIC_Start/IIC_WriteByteλ, ʹIIC_xxxRegByte(s)
  */
-void IIC_Start(void);
+//#define IIC_USE_HARDWARE
+
+//ӲIIC
+#define IIC_HW_I2C                  I2C1
+#define IIC_HW_I2C_CLK              RCC_APB1Periph_I2C1
+#define IIC_HW_GPIO_AF              GPIO_AF_I2C1
+#define IIC_HW_SCL_GPIO_CLK         RCC_AHB1Periph_GPIOB
+#define IIC_HW_SDA_GPIO_CLK         RCC_AHB1Periph_GPIOB
+#define IIC_HW_SCL_PINSOURCE        GPIO_PinSource8
+#define IIC_HW_SDA_PINSOURCE        GPIO_PinSource9
+#define IIC_HW_EV_IRQCHANNEL        I2C1_EV_IRQn
+#define IIC_HW_EV_IRQHANDLER        I2C1_EV_IRQHandler
+#define IIC_HW_ER_IRQCHANNEL        I2C1_ER_IRQn
+#define IIC_HW_ER_IRQHANDLER        I2C1_ER_IRQHandler
+#define IIC_HW_TIMEOUT_US           10000//δ䳬ʱʱ
+//DMA
+#define IIC_HW_DMA_CLK              RCC_AHB1Periph_DMA1
+#define IIC_HW_DMA_CHANNEL          DMA_Channel_1
+#define IIC_HW_DMA_RX_STREAM        DMA1_Stream0
+#define IIC_HW_DMA_RX_IRQCHANNEL    DMA1_Stream0_IRQn
+#define IIC_HW_DMA_RX_IRQHANDLER    DMA1_Stream0_IRQHandler
+#define IIC_HW_DMA_RX_IT_TC         DMA_IT_TCIF0
+#define IIC_HW_DMA_RX_IT_TE         DMA_IT_TEIF0
+#define IIC_HW_DMA_RX_FLAG_ALL      (DMA_FLAG_TCIF0 | DMA_FLAG_HTIF0 | DMA_FLAG_TEIF0 | DMA_FLAG_DMEIF0 | DMA_FLAG_FEIF0)
+#define IIC_HW_DMA_TX_STREAM        DMA1_Stream6
+#define IIC_HW_DMA_TX_IRQCHANNEL    DMA1_Stream6_IRQn
+#define IIC_HW_DMA_TX_IRQHANDLER    DMA1_Stream6_IRQHandler
+#define IIC_HW_DMA_TX_IT_TC         DMA_IT_TCIF6
+#define IIC_HW_DMA_TX_IT_TE         DMA_IT_TEIF6
+#define IIC_HW_DMA_TX_FLAG_ALL      (DMA_FLAG_TCIF6 | DMA_FLAG_HTIF6 | DMA_FLAG_TEIF6 | DMA_FLAG_DMEIF6 | DMA_FLAG_FEIF6)
+
 /**
- * @brief ֹͣź
+ * @brief Ĭʹöʱ+DMAĲδģIIC
+ * @note ÿһλSCL/SDAƽ仯ԤȱGPIO BSRR, TIM8ÿ¼DMAдһֵBSRR,
+ *       TIM8ͨ1Ƚ¼һ·DMAIDR, DMAжȡӦλͶݲλ
+ *       SCLɶʱ֤, ڼCPUֻÿIIC_WAVE_HALF_UNITSλһж
+ *       , SCLSDAͬһGPIO˿; ִ֧ӻSCL(ʱչ)
+ *       ֻһʹòIIC, ͬʱIIC_USE_HARDWAREʱĬʹӲIIC
+ *       ĬߵIIC_Start/IIC_WriteByteλ, ʹIIC_xxxRegByte(s)
  */
-void IIC_Stop(void);
+//#define IIC_USE_WAVE
+
+//IICĶʱ, ÿλ5ʱ: SCL͵ƽ3, ߵƽ2
+#define IIC_WAVE_TIM                TIM8
+#define IIC_WAVE_TIM_CLK            RCC_APB2Periph_TIM8
+#define IIC_WAVE_TIM_CLOCK          168000000//APB2ʱʱ
+#define IIC_WAVE_HALF_UNITS         36//ÿλ, ռԼ2.2KB RAM
+//DMA, ·DMA2ͨ7(TIM8_UP, TIM8_CH1), DMA1ܷGPIO
+#define IIC_WAVE_DMA_CLK            RCC_AHB1Periph_DMA2
+#define IIC_WAVE_DMA_CHANNEL        DMA_Channel_7
+#define IIC_WAVE_DMA_OUT_STREAM     DMA2_Stream1
+#define IIC_WAVE_DMA_OUT_FLAG_ALL   (DMA_FLAG_TCIF1 | DMA_FLAG_HTIF1 | DMA_FLAG_TEIF1 | DMA_FLAG_DMEIF1 | DMA_FLAG_FEIF1)
+#define IIC_WAVE_DMA_IN_STREAM      DMA2_Stream2
+#define IIC_WAVE_DMA_IN_IRQCHANNEL  DMA2_Stream2_IRQn
+#define IIC_WAVE_DMA_IN_IRQHANDLER  DMA2_Stream2_IRQHandler
+#define IIC_WAVE_DMA_IN_IT_HT       DMA_IT_HTIF2
+#define IIC_WAVE_DMA_IN_IT_TC       DMA_IT_TCIF2
+#define IIC_WAVE_DMA_IN_IT_TE       DMA_IT_TEIF2
+#define IIC_WAVE_DMA_IN_FLAG_ALL    (DMA_FLAG_TCIF2 | DMA_FLAG_HTIF2 | DMA_FLAG_TEIF2 | DMA_FLAG_DMEIF2 | DMA_FLAG_FEIF2)
+
 /**
- * @brief ȴӦź
- * @return 1-Ӧʧ; 0-Ӧɹ
+ * @brief ÿδַ, Ĵ, , ״̬, ֹʱ̺͵
+ * @note ¼ڻλ, ˸ɵļ¼
+ *       IIC_TraceDumpIIC_TRACE_USART, tools/iictrace
+ */
+//#define IIC_USE_TRACE
+#define IIC_TRACE_SIZE              256//¼, ÿ20ֽ
+#define IIC_TRACE_USART             USART1//ȵuart_init
+
+/**
+ * @brief ʱͳ,  @ref IIC_Benchmark
+ */
+typedef struct {
+    uint32_t totalCycles;//ӵõؾ
+    uint32_t cpuCycles;//CPUIICռõ
+}IIC_BenchmarkTypedef;
+
+/**
+ * @brief ÿÿȼ첽г
+ */
+#define IIC_QUEUE_SIZE              8
+/**
+ * @brief IIC_BusWriteBulkÿδֽ
+ * @note 400KHz32ֽԼ0.8ms, ȼȴô
+ */
+#define IIC_CHUNK_SIZE              32
+/**
+ * @brief Գʼ
+ * @note PendSVֻǼǹ, ʱIIC_BusInit1, ʼ
  */
-uint8_t IIC_WaitAck(void);
+#define IIC_MAX_BUSES               4
 /**
- * @brief Ӧź
+ * @brief 첽ĺ̨, ɻصִ
+ * @note ʹPendSV, ȼΪ, ;
  */
-void IIC_Ack(void);
+#define IIC_BACKGROUND_IRQCHANNEL   PendSV_IRQn
+#define IIC_BACKGROUND_IRQHANDLER   PendSV_Handler
+
+/**
+ * @brief 첽״̬
+ */
+typedef enum {
+    IIC_STATUS_OK = 0,
+    IIC_STATUS_ERROR,//Ӧߴ
+    IIC_STATUS_PENDING,
+    IIC_STATUS_TIMEOUT//ӲIICʱ
+}IIC_StatusTypedef;
+
 /**
- * @brief Ӧź
- */  
-void IIC_NAck(void);
+ * @brief ȼ
+ * @note ߿ʱִиȼеĴ, ͬһȼύ˳ִ
+ *       ڽеĴ䲻ᱻ, ԵȼĴIIC_BusWriteBulkֿ
+ */
+typedef enum {
+    IIC_PRIORITY_HIGH = 0,//ȶӳеĴ, ĬΪȼ
+    IIC_PRIORITY_LOW,//ʾȴ, ӲIICͲIICдҲʹøȼ
+    IIC_PRIORITIES
+}IIC_PriorityTypedef;
 
 /**
- * @brief ʼIIC
+ * @brief һȼеͳϢ,  @ref IIC_BusGetStatistics
+ * @note ȴʱָӵʼ侭
  */
-void IIC_Init(void);
+typedef struct {
+    uint32_t submitted;//Ӵ
+    uint32_t rejected;//ܾĴ
+    uint32_t started;//ӿʼĴ
+    uint8_t depth;//ǰ
+    uint8_t maxDepth;//
+    uint32_t maxWaitCycles;//ȴʱ
+    uint64_t totalWaitCycles;//ۼƵȴʱ, startedõƽֵ
+}IIC_QueueStatisticsTypedef;
+
 /**
- * @brief IICһֽ
- * @return 1-Ack; 0-Ack
- */      
-void IIC_WriteByte(uint8_t data);
+ * @brief ֶζһ,  @ref IIC_BusReadRegScatter
+ */
+typedef struct {
+    uint8_t *data;//Ŀ껺
+    uint16_t len;//ֽ, Ϊ1
+}IIC_SegmentTypedef;
+
 /**
- * @brief 1ֽ
+ * @brief 첽,  @ref IIC_BusSubmit
+ * @note ɻصִ֮ǰ, ݻ޸Ļͷ
+ */
+typedef struct IIC_TransferStruct {
+    uint8_t addr;//ַ
+    uint8_t reg;//Ĵַ
+    uint8_t isRead;//1-; 0-д
+    uint16_t len;//ֽ, ֶζʱΪֽ֮
+    uint8_t *data;//ݻ
+    const IIC_SegmentTypedef *segments;//ֶζĸ, ΪNULLʱdata; дΪNULL
+    uint8_t segmentCount;//
+    IIC_PriorityTypedef priority;//ȼ
+    void (* callback)(struct IIC_TransferStruct *transfer);//ɻص, ΪNULL
+    void *context;//صʹ
+    __IO IIC_StatusTypedef status;//״̬, д
+    struct IIC_TransferStruct *next;//ڲʹ
+    uint32_t submitCycles;//ʱ, ڲʹ
+    uint32_t caller;//ύߵĵַ, ڲʹ
+}IIC_TransferTypedef;
+
+/**
+ * @brief ߺ
+ */
+typedef enum {
+    IIC_BACKEND_SOFTWARE = 0,//GPIOģ, 
+    IIC_BACKEND_HARDWARE,//I2C1+DMA, 趨IIC_USE_HARDWARE
+    IIC_BACKEND_WAVE//TIM8+DMA2, , 趨IIC_USE_WAVE
+}IIC_BackendTypedef;
+
+/**
+ * @brief ʵ
+ * @note IIC_BUS_INIT̬ʼò, Աʹ
+ */
+typedef struct {
+    //
+    IIC_BackendTypedef backend;
+    GPIO_TypeDef *sclPort;
+    uint16_t sclPin;
+    GPIO_TypeDef *sdaPort;
+    uint16_t sdaPin;
+    uint32_t speed;//(Hz)
+    //IICʱ
+    uint32_t lowCycles;//SCL͵ƽ
+    uint32_t highCycles;//SCLߵƽ
+    uint32_t edge;//һεƽ仯ʱ
+    uint32_t sdaModerMask;//SDAMODERеλ
+    uint32_t sdaModerOut;//SDAΪʱMODERֵ
+    __IO uint8_t lock;//IICڴĲ(дPendSV), 0ʱPendSVռ, ждֱӳ
+    __IO uint8_t deferred;//PendSV߱ռöƳ˶д
+    uint8_t isInitialized;
+    //첽, ÿȼһ
+    IIC_TransferTypedef *queue[IIC_PRIORITIES][IIC_QUEUE_SIZE];
+    __IO uint8_t queueHead[IIC_PRIORITIES];//λ
+    __IO uint8_t queueCount[IIC_PRIORITIES];//е
+    IIC_QueueStatisticsTypedef stats[IIC_PRIORITIES];
+    IIC_TransferTypedef *doneHead;//ӲIICIIC, ȴûصĴ
+    IIC_TransferTypedef *doneTail;
+}IIC_BusTypedef;
+
+/**
+ * @brief ʵľ̬ʼ
+ * @param type IIC_BACKEND_SOFTWARE, IIC_BACKEND_HARDWAREIIC_BACKEND_WAVE
+ * @param sclGpio SCL˿, GPIOB
+ * @param sclBit SCL, GPIO_Pin_8
+ * @param sdaGpio SDA˿
+ * @param sdaBit SDA
+ * @param rate (Hz)
+ * @note ָԱĳʼ, ԱΪ0
+ */
+#define IIC_BUS_INIT(type, sclGpio, sclBit, sdaGpio, sdaBit, rate) \
+    {.backend = (type), .sclPort = (sclGpio), .sclPin = (sclBit), .sdaPort = (sdaGpio), .sdaPin = (sdaBit), .speed = (rate)}
+
+/**
+ * @brief Ĭ, żIIC_SCL_PORT
+ */
+extern IIC_BusTypedef IIC_DefaultBus;
+
+/**
+ * @brief ʼ, ظ
+ * @param bus ʵ
+ * @return 0-; 1-IIC_MAX_BUSES, ûгʼ
+ */
+uint8_t IIC_BusInit(IIC_BusTypedef *bus);
+/**
+ * @brief ʼź, IIC
+ * @param bus ʵ
+ */
+void IIC_BusStart(IIC_BusTypedef *bus);
+/**
+ * @brief ֹͣź, IIC
+ * @param bus ʵ
+ */
+void IIC_BusStop(IIC_BusTypedef *bus);
+/**
+ * @brief ȴӦź, IIC
+ * @param bus ʵ
+ * @return 1-Ӧʧ; 0-Ӧɹ
+ */
+uint8_t IIC_BusWaitAck(IIC_BusTypedef *bus);
+/**
+ * @brief Ӧź, IIC
+ * @param bus ʵ
+ */
+void IIC_BusAck(IIC_BusTypedef *bus);
+/**
+ * @brief Ӧź, IIC
+ * @param bus ʵ
+ */
+void IIC_BusNAck(IIC_BusTypedef *bus);
+/**
+ * @brief һֽ, IIC
+ * @param bus ʵ
+ * @param data Ҫ͵ֽ
+ */
+void IIC_BusWriteByte(IIC_BusTypedef *bus, uint8_t data);
+/**
+ * @brief 1ֽ, IIC
+ * @param bus ʵ
  * @param ack
  *          1-Ӧ
  *          0-ͷӦ
  * @return ضȡһֽ
- */ 
-uint8_t IIC_ReadByte(uint8_t ack);
+ */
+uint8_t IIC_BusReadByte(IIC_BusTypedef *bus, uint8_t ack);
 /**
- * @brief IICд1ֽڵĴ
+ * @brief д1ֽڵĴ
+ * @param bus ʵ
  * @param addr ַ
  * @param reg Ĵַ
  * @param data Ҫд
  * @return 0-; 1-
  */
-uint8_t IIC_WriteRegByte(uint8_t addr, uint8_t reg, uint8_t data);
+uint8_t IIC_BusWriteRegByte(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint8_t data);
 /**
- * @brief IIC1ֽڵĴ
+ * @brief 1ֽڼĴ
+ * @param bus ʵ
  * @param addr ַ
  * @param reg Ĵַ
  * @return Ҫȡ
  */
-uint8_t IIC_ReadRegByte(uint8_t addr, uint8_t reg);
+uint8_t IIC_BusReadRegByte(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg);
+/**
+ * @brief д
+ * @param bus ʵ
+ * @param addr ַ
+ * @param reg Ĵַ
+ * @param len дֽ
+ * @param data Ҫд
+ * @return 0-; 1-
+ */
+uint8_t IIC_BusWriteRegBytes(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint8_t len, uint8_t *data);
+/**
+ * @brief 
+ * @param bus ʵ
+ * @param addr ַ
+ * @param reg Ĵַ
+ * @param len ȡֽ
+ * @param data Ҫȡ
+ * @return 0-; 1-
+ */
+uint8_t IIC_BusReadRegBytes(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint8_t len, uint8_t *data);
+/**
+ * @brief , ȿɳ255ֽ
+ * @param bus ʵ
+ * @param addr ַ
+ * @param reg Ĵַ
+ * @param len ȡֽ
+ * @param data Ҫȡ
+ * @return 0-; 1-
+ */
+uint8_t IIC_BusReadRegBytesLong(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint16_t len, uint8_t *data);
 /**
- * @brief IICд
+ * @brief ֶζ, һδ(һʼ/ֹͣź)ζ
+ * @param bus ʵ
  * @param addr ַ
  * @param reg Ĵַ
+ * @param segments εĻֽ, ÿ1ֽ
+ * @param count 
+ * @return 0-; 1-
+ * @note һζFIFOеĶݰ, ŵĻ, ֽ65535
+ */
+uint8_t IIC_BusReadRegScatter(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, const IIC_SegmentTypedef *segments, uint8_t count);
+/**
+ * @brief ֿд, Դȴ
+ * @param bus ʵ
+ * @param addr ַ
+ * @param reg Ĵַ, ÿ鶼·
  * @param len дֽ
  * @param data Ҫд
  * @return 0-; 1-
+ * @note ÿ鲻IIC_CHUNK_SIZEֽ, ֮ȼĴԲ
+ *       ֻÿԶд, SSD1306ݼĴ(0x40)Զеַ
  */
-uint8_t IIC_WriteRegBytes(uint8_t addr, uint8_t reg, uint8_t len, uint8_t *data);
+uint8_t IIC_BusWriteBulk(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint16_t len, uint8_t *data);
 /**
- * @brief IIC
+ * @brief һĺʱ, ڱȽIICӲIIC
+ * @param bus ʵ
  * @param addr ַ
  * @param reg Ĵַ
  * @param len ȡֽ
  * @param data Ҫȡ
+ * @param result ͳƽ
  * @return 0-; 1-
+ * @note IICȫռCPU, cpuCyclestotalCycles;
+ *       ӲIICͲIICֻͳжϷ, ʱCPUԴж
+ */
+uint8_t IIC_BusBenchmark(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint8_t len, uint8_t *data, IIC_BenchmarkTypedef *result);
+/**
+ * @brief 
+ * @param bus ʵ
+ * @param speed (Hz), IIC_SPEED_STANDARD, IIC_SPEED_FAST, IIC_SPEED_FAST_PLUS
+ * @return 0-; 1-ָ֧
+ * @note IIC֧1MHzڵ, ߵ͵ƽʱDWTڼ֤;
+ *       ӲIIC400KHz, ȵǰ;
+ *       IIC֧1KHz~1MHz, ߵ͵ƽʱɶʱ֤
+ */
+uint8_t IIC_BusSetSpeed(IIC_BusTypedef *bus, uint32_t speed);
+/**
+ * @brief , ȡɴβͳÿֽ
+ * @param bus ʵ
+ * @param addr ַ
+ * @param reg Ĵַ
+ * @param len ÿζȡֽ
+ * @param times ȡ
+ * @return ֽ/, ַͼĴַ; ʱ0
+ */
+uint32_t IIC_BusMeasureThroughput(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint8_t len, uint8_t times);
+/**
+ * @brief ύһ첽, 
+ * @param bus ʵ
+ * @param transfer , addr, reg, isRead, len, data, segments, priority, callback
+ * @return 0-Ѽ; 1-
+ * @note ȼж
+ *       ȼĴڵǰʼ, еȼ֮ǰ
+ *       صPendSV(ȼ)ִ, ԻصԵдٴύ
+ *       IICĴҲPendSVн, жֻñ, Ҫд
+ *       (жϴ˸ϵĴʱ, дȴ, ֱӷس)
+ *       ߵĶл, һϵдƳߵĴ
+ */
+uint8_t IIC_BusSubmit(IIC_BusTypedef *bus, IIC_TransferTypedef *transfer);
+/**
+ * @brief ȡͳϢ
+ * @param bus ʵ
+ * @param priority ȼ
+ * @param stats ͳϢ
+ * @note IICд, ͳ; ӲIICͲIICдȼ
  */
-uint8_t IIC_ReadRegBytes(uint8_t addr, uint8_t reg, uint8_t len, uint8_t *data);
+void IIC_BusGetStatistics(IIC_BusTypedef *bus, IIC_PriorityTypedef priority, IIC_QueueStatisticsTypedef *stats);
+/**
+ * @brief ͳϢ, ǰȲ
+ * @param bus ʵ
+ */
+void IIC_BusResetStatistics(IIC_BusTypedef *bus);
 
+/**
+ * @brief ʼÿдֽ
+ */
+#define IIC_INIT_MAX_BYTES          4
+/**
+ * @brief ʼѯļ(us), ѯռ
+ */
+#define IIC_INIT_POLL_INTERVAL_US   200
 
+/**
+ * @brief ʼĲ
+ */
+typedef enum {
+    IIC_INIT_OP_WRITE = 0,//дĴ, ĴַϲΪһд(ֵַ֧Զ)
+    IIC_INIT_OP_STREAM,//дͬһĴ, ϲΪһд, SSD1306Ĵ0x00
+    IIC_INIT_OP_POLL,//1ֽڼĴֱ(ֵ & data[0]) == data[1], ӦҲ
+    IIC_INIT_OP_PROBE//ֻͼĴַ, ֱӦ
+}IIC_InitOpTypedef;
 
+/**
+ * @brief ʼһ,  @ref IIC_BusRunInitTable
+ * @note IIC_INIT_XXXд, ӦΪconstFlash
+ */
+typedef struct {
+    uint8_t op;//IIC_InitOpTypedef
+    uint8_t addr;//ַ
+    uint8_t reg;//Ĵַ
+    uint8_t len;//WRITE/STREAMдֽ
+    uint8_t data[IIC_INIT_MAX_BYTES];//WRITE/STREAM; POLLֵ
+    uint16_t delayMs;//WRITE/STREAMдʱ, 0ʱһϲ; POLL/PROBEĳʱʱ
+}IIC_InitEntryTypedef;
+
+#define IIC_INIT_WRITE(addr, reg, value)                    {IIC_INIT_OP_WRITE, addr, reg, 1, {value}, 0}
+#define IIC_INIT_WRITE_DELAY(addr, reg, value, delayMs)     {IIC_INIT_OP_WRITE, addr, reg, 1, {value}, delayMs}
+#define IIC_INIT_STREAM(addr, reg, value)                   {IIC_INIT_OP_STREAM, addr, reg, 1, {value}, 0}
+#define IIC_INIT_POLL(addr, reg, mask, expect, timeoutMs)   {IIC_INIT_OP_POLL, addr, reg, 0, {mask, expect}, timeoutMs}
+#define IIC_INIT_PROBE(addr, reg, timeoutMs)                {IIC_INIT_OP_PROBE, addr, reg, 0, {0}, timeoutMs}
+
+/**
+ * @brief ִгʼ
+ * @param bus ʵ
+ * @param table ʼ
+ * @param count 
+ * @return 0-; Ϊ+1, ϲдʱΪϲĵһ
+ * @note ͬһWRITE(Ĵַ)STREAM(Ĵͬ)ϲΪһд,
+ *       ÿIIC_CHUNK_SIZEֽ, ʱǺϲһ
+ *       POLL/PROBE̶ʱ, ʱس; ִ, Ҫже
+ */
+uint16_t IIC_BusRunInitTable(IIC_BusTypedef *bus, const IIC_InitEntryTypedef *table, uint16_t count);
+
+/**
+ * @brief GPIO˿ڵʱ, IICʹ
+ */
+#define IIC_GpioClock(port)         (RCC_AHB1Periph_GPIOA << (((uint32_t)(port) - GPIOA_BASE) / 0x400))
+
+/**
+ * @brief , IICʹ
+ * @return 0-ɹ; 1-
+ */
+uint8_t IIC_QueuePush(IIC_BusTypedef *bus, IIC_TransferTypedef *transfer);
+/**
+ * @brief , IICʹ
+ * @return ȼߵķǿնеĶ, жΪʱNULL
+ */
+IIC_TransferTypedef *IIC_QueuePop(IIC_BusTypedef *bus);
+/**
+ * @brief ɵĴصбPendSV, IICжʹ
+ * @note ûлصĴֱӺ
+ */
+void IIC_DonePush(IIC_BusTypedef *bus, IIC_TransferTypedef *transfer);
+
+/**
+ * @brief ߵĵַ(صַ), ֻڱõĺֱʹ
+ */
+#if defined(__CC_ARM)
+#define IIC_CALLER()                ((uint32_t)__return_address())
+#else
+#define IIC_CALLER()                ((uint32_t)(uintptr_t)__builtin_return_address(0))
+#endif
+
+#ifdef IIC_USE_TRACE
+/**
+ * @brief һټ¼, ʱ˲ֽڷ(С)
+ */
+typedef struct {
+    uint32_t start;//ʼʱ(DWT), 첽Ϊʱ
+    uint32_t end;//ʱ(DWT)
+    uint32_t caller;//ߵķصַ, mapļɺ
+    uint16_t len;//ֽ
+    uint8_t addr;//ַ
+    uint8_t reg;//Ĵַ
+    uint8_t flags;//IIC_TRACE_FLAG_xxx
+    uint8_t reserved[3];
+}IIC_TraceRecordTypedef;
+
+#define IIC_TRACE_FLAG_STATUS       0x03//0-; 1-Ӧ/; 3-ʱ
+#define IIC_TRACE_FLAG_READ         0x04//
+#define IIC_TRACE_FLAG_BUS_POS      4//߱(ʼ˳)ڵλ, ռ2λ
+
+/**
+ * @brief һټ¼, IICʹ
+ */
+void IIC_TraceAdd(IIC_BusTypedef *bus, IIC_TransferTypedef *transfer, uint32_t start);
+/**
+ * @brief ոټ¼
+ */
+void IIC_TraceClear(void);
+/**
+ * @brief ԶƸʽIIC_TRACE_USARTиټ¼, Ȼ
+ * @note ڼͣ¼; ʽbsp_iic.c
+ */
+void IIC_TraceDump(void);
+#endif
+
+#ifdef IIC_USE_HARDWARE
+/**
+ * @brief ӲIIC, bsp_iic.cbus->backend
+ */
+void IIC_HwInit(IIC_BusTypedef *bus);
+uint8_t IIC_HwSubmit(IIC_BusTypedef *bus, IIC_TransferTypedef *transfer);
+uint8_t IIC_HwTransfer(IIC_BusTypedef *bus, IIC_TransferTypedef *transfer);
+uint8_t IIC_HwSetSpeed(IIC_BusTypedef *bus, uint32_t speed);
+uint32_t IIC_HwBusyCycles(void);
+#endif
+
+#ifdef IIC_USE_WAVE
+/**
+ * @brief IIC, bsp_iic.cbus->backend
+ */
+void IIC_WaveInit(IIC_BusTypedef *bus);
+uint8_t IIC_WaveSubmit(IIC_BusTypedef *bus, IIC_TransferTypedef *transfer);
+uint8_t IIC_WaveTransfer(IIC_BusTypedef *bus, IIC_TransferTypedef *transfer);
+uint8_t IIC_WaveSetSpeed(IIC_BusTypedef *bus, uint32_t speed);
+uint32_t IIC_WaveBusyCycles(void);
+#endif
+
+/**
+ * @brief ĬϵĲ, ԭĽӿ
+ */
+#define IIC_Init()                                  IIC_BusInit(&IIC_DefaultBus)
+#define IIC_WriteRegByte(addr, reg, data)           IIC_BusWriteRegByte(&IIC_DefaultBus, addr, reg, data)
+#define IIC_ReadRegByte(addr, reg)                  IIC_BusReadRegByte(&IIC_DefaultBus, addr, reg)
+#define IIC_WriteRegBytes(addr, reg, len, data)     IIC_BusWriteRegBytes(&IIC_DefaultBus, addr, reg, len, data)
+#define IIC_ReadRegBytes(addr, reg, len, data)      IIC_BusReadRegBytes(&IIC_DefaultBus, addr, reg, len, data)
+#define IIC_ReadRegBytesLong(addr, reg, len, data)  IIC_BusReadRegBytesLong(&IIC_DefaultBus, addr, reg, len, data)
+#define IIC_ReadRegScatter(addr, reg, segments, count) IIC_BusReadRegScatter(&IIC_DefaultBus, addr, reg, segments, count)
+#define IIC_WriteBulk(addr, reg, len, data)         IIC_BusWriteBulk(&IIC_DefaultBus, addr, reg, len, data)
+#define IIC_Benchmark(addr, reg, len, data, result) IIC_BusBenchmark(&IIC_DefaultBus, addr, reg, len, data, result)
+#define IIC_SetSpeed(speed)                         IIC_BusSetSpeed(&IIC_DefaultBus, speed)
+#define IIC_MeasureThroughput(addr, reg, len, times) IIC_BusMeasureThroughput(&IIC_DefaultBus, addr, reg, len, times)
+#define IIC_Submit(transfer)                        IIC_BusSubmit(&IIC_DefaultBus, transfer)
+#define IIC_GetStatistics(priority, stats)          IIC_BusGetStatistics(&IIC_DefaultBus, priority, stats)
+#define IIC_ResetStatistics()                       IIC_BusResetStatistics(&IIC_DefaultBus)
+#define IIC_RunInitTable(table, count)              IIC_BusRunInitTable(&IIC_DefaultBus, table, count)
+#if !defined(IIC_USE_HARDWARE) && !defined(IIC_USE_WAVE)
+#define IIC_Start()                                 IIC_BusStart(&IIC_DefaultBus)
+#define IIC_Stop()                                  IIC_BusStop(&IIC_DefaultBus)
+#define IIC_WaitAck()                               IIC_BusWaitAck(&IIC_DefaultBus)
+#define IIC_Ack()                                   IIC_BusAck(&IIC_DefaultBus)
+#define IIC_NAck()                                  IIC_BusNAck(&IIC_DefaultBus)
+#define IIC_WriteByte(data)                         IIC_BusWriteByte(&IIC_DefaultBus, data)
+#define IIC_ReadByte(ack)                           IIC_BusReadByte(&IIC_DefaultBus, ack)
+/**
+ * @brief ûнյӦźţ򷵻1
+ */
+#define IIC_IF_NOT_ACK_RETURN_1     if(IIC_WaitAck()) {IIC_Stop(); return 1;}
+#endif
 
 #endif
@@ -0,0 +1,527 @@
+/**
+ * @file    bsp_iic_hw.c
+ * @author  Miaow
+ * @version 0.10.0
+ * @date    2026/10/16
+ * @brief
+ *          This file provides functions to manage the following
+ *          functionalities of hardware IIC with DMA:
+ *              1. Initialization
+ *              2. Write and read registers of slave
+ *              3. Asynchronous transfer queue with callbacks
+ *              4. Bus speed setting
+ *              5. Transfer priorities
+ *              6. Transfer tracing
+ *              7. Scatter-gather reads
+ * @note
+ *          Minimum version of header file:
+ *              0.10.0
+ *          Define IIC_USE_HARDWARE in bsp_iic.h to enable this file.
+ *          This is the backend of IIC_BACKEND_HARDWARE buses, called by bsp_iic.c.
+ *          Only one bus can use it.
+ *          Recommanded pin connection:
+ *               
+ *               PB8SCL     
+ *               PB9SDA     
+ *               
+ *          STM32F407        slave
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#include "bsp_iic.h"
+#include "cyclecounter.h"
+
+#ifdef IIC_USE_HARDWARE
+
+/**
+ * @brief ״̬״̬
+ */
+typedef enum {
+    IIC_HW_STATE_IDLE = 0,
+    IIC_HW_STATE_START,//ȴSB, Ȼдַ
+    IIC_HW_STATE_ADDRESS,//ȴADDR, ȻͼĴַ
+    IIC_HW_STATE_REGISTER,//ȴĴַ(BTF)
+    IIC_HW_STATE_RESTART,//ȴظʼSB, ȻͶַ
+    IIC_HW_STATE_READ_ADDRESS,//ȴADDR, Ȼʼ
+    IIC_HW_STATE_READ_SINGLE,//ֻ1ֽʱDMA, ȴRXNE
+    IIC_HW_STATE_DMA,//DMA
+    IIC_HW_STATE_WRITE_END//ȴһֽڷ(BTF)
+}IIC_HwStateTypedef;
+
+/**
+ * @brief ǰ
+ */
+static struct {
+    __IO IIC_HwStateTypedef state;
+    IIC_TransferTypedef *transfer;//ڽеĴ
+    uint8_t segment;//ֶζʱDMAڽյĶ
+    uint32_t startCycles;//俪ʼʱ, ڳʱ
+    IIC_BusTypedef *bus;//ʹӲIIC
+    __IO uint32_t busyCycles;//жϷռõ
+}iicHw;
+
+/**
+ * @brief IICDMA
+ */
+static void IIC_HwConfig()
+{
+    I2C_InitTypeDef I2C_InitStructure;
+    DMA_InitTypeDef DMA_InitStructure;
+
+    //I2C
+    I2C_DeInit(IIC_HW_I2C);
+    I2C_InitStructure.I2C_Mode = I2C_Mode_I2C;
+    I2C_InitStructure.I2C_DutyCycle = I2C_DutyCycle_2;
+    I2C_InitStructure.I2C_OwnAddress1 = 0x00;
+    I2C_InitStructure.I2C_Ack = I2C_Ack_Enable;
+    I2C_InitStructure.I2C_AcknowledgedAddress = I2C_AcknowledgedAddress_7bit;
+    I2C_InitStructure.I2C_ClockSpeed = iicHw.bus->speed;
+    I2C_Init(IIC_HW_I2C, &I2C_InitStructure);
+    I2C_ITConfig(IIC_HW_I2C, I2C_IT_EVT | I2C_IT_ERR, ENABLE);
+    I2C_Cmd(IIC_HW_I2C, ENABLE);
+
+    //DMA, ڴַͳÿδʱ
+    DMA_DeInit(IIC_HW_DMA_RX_STREAM);
+    DMA_DeInit(IIC_HW_DMA_TX_STREAM);
+    DMA_InitStructure.DMA_Channel = IIC_HW_DMA_CHANNEL;
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&IIC_HW_I2C->DR;
+    DMA_InitStructure.DMA_Memory0BaseAddr = 0;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralToMemory;
+    DMA_InitStructure.DMA_BufferSize = 1;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_VeryHigh;
+    DMA_InitStructure.DMA_FIFOMode = DMA_FIFOMode_Disable;
+    DMA_InitStructure.DMA_FIFOThreshold = DMA_FIFOThreshold_Full;
+    DMA_InitStructure.DMA_MemoryBurst = DMA_MemoryBurst_Single;
+    DMA_InitStructure.DMA_PeripheralBurst = DMA_PeripheralBurst_Single;
+    DMA_Init(IIC_HW_DMA_RX_STREAM, &DMA_InitStructure);
+    DMA_InitStructure.DMA_DIR = DMA_DIR_MemoryToPeripheral;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_High;
+    DMA_Init(IIC_HW_DMA_TX_STREAM, &DMA_InitStructure);
+    DMA_ITConfig(IIC_HW_DMA_RX_STREAM, DMA_IT_TC | DMA_IT_TE, ENABLE);
+    DMA_ITConfig(IIC_HW_DMA_TX_STREAM, DMA_IT_TC | DMA_IT_TE, ENABLE);
+
+    iicHw.state = IIC_HW_STATE_IDLE;
+}
+
+/**
+ * @brief ʼӲIIC, IIC_BusInit
+ * @param bus ʵ, űI2C1SCLSDA
+ * @note жȼΪ0, дȼ͵ж
+ */
+void IIC_HwInit(IIC_BusTypedef *bus)
+{
+    GPIO_InitTypeDef GPIO_InitStructure;
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    iicHw.bus = bus;
+    if(bus->speed == 0 || bus->speed > IIC_SPEED_FAST)
+        bus->speed = IIC_SPEED_FAST;
+    RCC_AHB1PeriphClockCmd(IIC_HW_SCL_GPIO_CLK | IIC_HW_SDA_GPIO_CLK | IIC_HW_DMA_CLK, ENABLE);//ʹGPIO, DMAʱ
+    RCC_APB1PeriphClockCmd(IIC_HW_I2C_CLK, ENABLE);//ʹI2Cʱ
+    //SCL, SDAÿ©
+    GPIO_PinAFConfig(bus->sclPort, IIC_HW_SCL_PINSOURCE, IIC_HW_GPIO_AF);
+    GPIO_PinAFConfig(bus->sdaPort, IIC_HW_SDA_PINSOURCE, IIC_HW_GPIO_AF);
+    GPIO_InitStructure.GPIO_Pin = bus->sclPin;
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF;
+    GPIO_InitStructure.GPIO_OType = GPIO_OType_OD;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Fast_Speed;//50MHz
+    GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_UP;
+    GPIO_Init(bus->sclPort, &GPIO_InitStructure);
+    GPIO_InitStructure.GPIO_Pin = bus->sdaPin;
+    GPIO_Init(bus->sdaPort, &GPIO_InitStructure);
+
+    IIC_HwConfig();
+
+    //NVIC
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_InitStructure.NVIC_IRQChannel = IIC_HW_EV_IRQCHANNEL;
+    NVIC_Init(&NVIC_InitStructure);
+    NVIC_InitStructure.NVIC_IRQChannel = IIC_HW_ER_IRQCHANNEL;
+    NVIC_Init(&NVIC_InitStructure);
+    NVIC_InitStructure.NVIC_IRQChannel = IIC_HW_DMA_RX_IRQCHANNEL;
+    NVIC_Init(&NVIC_InitStructure);
+    NVIC_InitStructure.NVIC_IRQChannel = IIC_HW_DMA_TX_IRQCHANNEL;
+    NVIC_Init(&NVIC_InitStructure);
+}
+
+/**
+ * @brief indexεĻ, ֶʱֻһ
+ */
+static inline uint8_t *IIC_HwSegmentData(IIC_TransferTypedef *transfer, uint8_t index)
+{
+    return transfer->segments ? transfer->segments[index].data : transfer->data;
+}
+
+/**
+ * @brief indexεֽ
+ */
+static inline uint16_t IIC_HwSegmentLen(IIC_TransferTypedef *transfer, uint8_t index)
+{
+    return transfer->segments ? transfer->segments[index].len : transfer->len;
+}
+
+/**
+ * @brief DMAڽյǷΪһ
+ */
+static inline uint8_t IIC_HwIsLastSegment()
+{
+    return !iicHw.transfer->segments || iicHw.segment + 1 >= iicHw.transfer->segmentCount;
+}
+
+/**
+ * @brief һδ, ֻúüĴ, жϺDMAʣµĹ
+ * @param transfer 
+ * @note ֻڹжϻIICж
+ */
+static void IIC_HwStart(IIC_TransferTypedef *transfer)
+{
+    uint32_t begin = CYCLECOUNTER_Read();
+    const uint32_t timeout = IIC_HW_TIMEOUT_US * (CYCLECOUNTER_CORE_CLOCK / 1000000);
+
+    while(IIC_HW_I2C->CR1 & I2C_CR1_STOP)//ȴϴεֹͣźŷ, дCR1
+    {
+        if(CYCLECOUNTER_Read() - begin > timeout)
+        {
+            I2C_SoftwareResetCmd(IIC_HW_I2C, ENABLE);
+            I2C_SoftwareResetCmd(IIC_HW_I2C, DISABLE);
+            IIC_HwConfig();
+            break;
+        }
+    }
+    iicHw.transfer = transfer;
+    iicHw.segment = 0;
+    if(transfer->len > 1 || (!transfer->isRead && transfer->len))
+    {
+        DMA_Stream_TypeDef *stream = transfer->isRead ? IIC_HW_DMA_RX_STREAM : IIC_HW_DMA_TX_STREAM;
+        if(transfer->isRead)
+            DMA_ClearFlag(IIC_HW_DMA_RX_STREAM, IIC_HW_DMA_RX_FLAG_ALL);
+        else
+            DMA_ClearFlag(IIC_HW_DMA_TX_STREAM, IIC_HW_DMA_TX_FLAG_ALL);
+        stream->M0AR = (uint32_t)IIC_HwSegmentData(transfer, 0);
+        stream->NDTR = IIC_HwSegmentLen(transfer, 0);
+    }
+    iicHw.state = IIC_HW_STATE_START;
+    iicHw.startCycles = CYCLECOUNTER_Read();
+    IIC_HW_I2C->CR1 |= I2C_CR1_ACK | I2C_CR1_START;
+}
+
+/**
+ * @brief ߿ʱеһ
+ * @note ֻڹжϻIICж
+ */
+static inline void IIC_HwStartNext()
+{
+    IIC_TransferTypedef *transfer;
+    if(iicHw.state != IIC_HW_STATE_IDLE)
+        return;
+    transfer = IIC_QueuePop(iicHw.bus);
+    if(transfer)
+        IIC_HwStart(transfer);
+}
+
+/**
+ * @brief ǰ, Ȼһ
+ * @param status IIC_STATUS_OK, IIC_STATUS_ERRORIIC_STATUS_TIMEOUT
+ * @note صPendSVִ, IICжִ
+ */
+static void IIC_HwFinish(IIC_StatusTypedef status)
+{
+    IIC_TransferTypedef *transfer = iicHw.transfer;
+
+    iicHw.transfer = NULL;
+    iicHw.state = IIC_HW_STATE_IDLE;
+    if(transfer)
+    {
+        transfer->status = status;
+#ifdef IIC_USE_TRACE
+        IIC_TraceAdd(iicHw.bus, transfer, transfer->submitCycles);
+#endif
+        IIC_DonePush(iicHw.bus, transfer);
+    }
+    IIC_HwStartNext();
+}
+
+/**
+ * @brief 鵱ǰǷʱ, ʱλIIC貢ô
+ */
+static void IIC_HwCheckTimeout()
+{
+    const uint32_t timeout = IIC_HW_TIMEOUT_US * (CYCLECOUNTER_CORE_CLOCK / 1000000);
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    if(iicHw.state != IIC_HW_STATE_IDLE && CYCLECOUNTER_Read() - iicHw.startCycles > timeout)
+    {
+        DMA_Cmd(IIC_HW_DMA_RX_STREAM, DISABLE);
+        DMA_Cmd(IIC_HW_DMA_TX_STREAM, DISABLE);
+        I2C_SoftwareResetCmd(IIC_HW_I2C, ENABLE);
+        I2C_SoftwareResetCmd(IIC_HW_I2C, DISABLE);
+        IIC_HwConfig();
+        IIC_HwFinish(IIC_STATUS_TIMEOUT);
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief ύһ첽, 
+ * @param bus ʵ
+ * @param transfer , addr, reg, isRead, len, data, callback
+ * @return 0-Ѽ; 1-
+ * @note ߿ʱ, һж
+ *       صPendSVִ, ִ֮ǰٴύͬһ
+ */
+uint8_t IIC_HwSubmit(IIC_BusTypedef *bus, IIC_TransferTypedef *transfer)
+{
+    uint32_t begin = CYCLECOUNTER_Read();
+    uint32_t primask;
+    uint8_t res;
+
+    IIC_HwCheckTimeout();
+    transfer->status = IIC_STATUS_PENDING;
+    primask = __get_PRIMASK();
+    __disable_irq();
+    res = IIC_QueuePush(bus, transfer);
+    if(res)
+        transfer->status = IIC_STATUS_ERROR;
+    else
+        IIC_HwStartNext();
+    __set_PRIMASK(primask);
+    iicHw.busyCycles += CYCLECOUNTER_Read() - begin;
+    return res;
+}
+
+/**
+ * @brief 
+ * @param bus ʵ
+ * @param speed (Hz), IIC_SPEED_STANDARD, IIC_SPEED_FAST
+ * @return 0-; 1-ָ֧
+ * @note ӲIIC400KHz, ȵǰڹжϵ
+ */
+uint8_t IIC_HwSetSpeed(IIC_BusTypedef *bus, uint32_t speed)
+{
+    uint32_t primask;
+    if(speed == 0 || speed > IIC_SPEED_FAST)
+        return 1;
+    while(1)
+    {
+        IIC_HwCheckTimeout();
+        primask = __get_PRIMASK();
+        __disable_irq();
+        if(iicHw.state == IIC_HW_STATE_IDLE)
+            break;
+        __set_PRIMASK(primask);
+    }
+    bus->speed = speed;
+    if(bus->isInitialized)
+        IIC_HwConfig();
+    __set_PRIMASK(primask);
+    return 0;
+}
+
+/**
+ * @brief ύһδ䲢ȴ
+ * @param bus ʵ
+ * @param transfer , ɵ, priorityΪȼ, callbackΪNULL
+ * @return 0-; 1-
+ * @note 첽乲ö, ȼŶ, ȼ첽Ƚ
+ *       ȴڼжϺDMA, ֻҪߵжȼIICж, Ϳж
+ */
+uint8_t IIC_HwTransfer(IIC_BusTypedef *bus, IIC_TransferTypedef *transfer)
+{
+    while(IIC_HwSubmit(bus, transfer))//ʱȴλ
+        IIC_HwCheckTimeout();
+    while(transfer->status == IIC_STATUS_PENDING)
+        IIC_HwCheckTimeout();
+    return transfer->status != IIC_STATUS_OK;
+}
+
+/**
+ * @brief жϷۼռõ, IIC_BusBenchmark
+ */
+uint32_t IIC_HwBusyCycles()
+{
+    return iicHw.busyCycles;
+}
+
+/**
+ * @brief IIC¼жϷ
+ */
+void IIC_HW_EV_IRQHANDLER()
+{
+    uint32_t begin = CYCLECOUNTER_Read();
+    uint16_t sr1 = IIC_HW_I2C->SR1;
+
+    switch(iicHw.state)
+    {
+        case IIC_HW_STATE_START:
+            if(sr1 & I2C_SR1_SB)
+            {
+                IIC_HW_I2C->DR = iicHw.transfer->addr << 1;//ַ+д
+                iicHw.state = IIC_HW_STATE_ADDRESS;
+            }
+            break;
+        case IIC_HW_STATE_ADDRESS:
+            if(sr1 & I2C_SR1_ADDR)
+            {
+                (void)IIC_HW_I2C->SR2;//SR2ADDR
+                IIC_HW_I2C->DR = iicHw.transfer->reg;//дĴַ
+                if(!iicHw.transfer->isRead && iicHw.transfer->len)
+                {
+                    //Ĵַ֮ݽDMA
+                    IIC_HW_I2C->CR2 |= I2C_CR2_DMAEN;
+                    IIC_HW_DMA_TX_STREAM->CR |= DMA_SxCR_EN;
+                    iicHw.state = IIC_HW_STATE_DMA;
+                }
+                else
+                    iicHw.state = IIC_HW_STATE_REGISTER;
+            }
+            break;
+        case IIC_HW_STATE_REGISTER:
+            if(sr1 & I2C_SR1_BTF)
+            {
+                if(iicHw.transfer->isRead)
+                {
+                    IIC_HW_I2C->CR1 |= I2C_CR1_START;//ظʼ
+                    iicHw.state = IIC_HW_STATE_RESTART;
+                }
+                else
+                {
+                    IIC_HW_I2C->CR1 |= I2C_CR1_STOP;//ֻдĴַ
+                    IIC_HwFinish(IIC_STATUS_OK);
+                }
+            }
+            break;
+        case IIC_HW_STATE_RESTART:
+            if(sr1 & I2C_SR1_SB)
+            {
+                IIC_HW_I2C->DR = (iicHw.transfer->addr << 1) | 1;//ַ+
+                if(iicHw.transfer->len == 1)
+                    IIC_HW_I2C->CR1 &= ~I2C_CR1_ACK;//ֽڶADDRǰرӦ
+                iicHw.state = IIC_HW_STATE_READ_ADDRESS;
+            }
+            break;
+        case IIC_HW_STATE_READ_ADDRESS:
+            if(sr1 & I2C_SR1_ADDR)
+            {
+                if(iicHw.transfer->len == 1)
+                {
+                    (void)IIC_HW_I2C->SR2;
+                    IIC_HW_I2C->CR1 |= I2C_CR1_STOP;
+                    IIC_HW_I2C->CR2 |= I2C_CR2_ITBUFEN;
+                    iicHw.state = IIC_HW_STATE_READ_SINGLE;
+                }
+                else
+                {
+                    //LASTλDMAһֽԶͷӦ, ֶζʱһλ
+                    IIC_HW_DMA_RX_STREAM->CR |= DMA_SxCR_EN;
+                    IIC_HW_I2C->CR2 |= I2C_CR2_DMAEN | (IIC_HwIsLastSegment() ? I2C_CR2_LAST : 0);
+                    (void)IIC_HW_I2C->SR2;
+                    iicHw.state = IIC_HW_STATE_DMA;
+                }
+            }
+            break;
+        case IIC_HW_STATE_READ_SINGLE:
+            if(sr1 & I2C_SR1_RXNE)
+            {
+                *IIC_HwSegmentData(iicHw.transfer, 0) = IIC_HW_I2C->DR;
+                IIC_HW_I2C->CR2 &= ~I2C_CR2_ITBUFEN;
+                IIC_HwFinish(IIC_STATUS_OK);
+            }
+            break;
+        case IIC_HW_STATE_WRITE_END:
+            if(sr1 & I2C_SR1_BTF)
+            {
+                IIC_HW_I2C->CR1 |= I2C_CR1_STOP;
+                IIC_HwFinish(IIC_STATUS_OK);
+            }
+            break;
+        default://DMAڼܳBTF, DMAдDRԶ
+            break;
+    }
+    iicHw.busyCycles += CYCLECOUNTER_Read() - begin;
+}
+
+/**
+ * @brief IICжϷ
+ * @note Ӧ, ٲöʧ, ߴʱ䲢س
+ */
+void IIC_HW_ER_IRQHANDLER()
+{
+    uint32_t begin = CYCLECOUNTER_Read();
+    uint16_t sr1 = IIC_HW_I2C->SR1;
+
+    IIC_HW_I2C->SR1 = sr1 & ~(I2C_SR1_AF | I2C_SR1_ARLO | I2C_SR1_BERR | I2C_SR1_OVR);//־
+    IIC_HW_DMA_RX_STREAM->CR &= ~DMA_SxCR_EN;
+    IIC_HW_DMA_TX_STREAM->CR &= ~DMA_SxCR_EN;
+    IIC_HW_I2C->CR2 &= ~(I2C_CR2_DMAEN | I2C_CR2_LAST | I2C_CR2_ITBUFEN);
+    if(!(sr1 & I2C_SR1_ARLO))
+        IIC_HW_I2C->CR1 |= I2C_CR1_STOP;
+    if(iicHw.state != IIC_HW_STATE_IDLE)
+        IIC_HwFinish(IIC_STATUS_ERROR);
+    iicHw.busyCycles += CYCLECOUNTER_Read() - begin;
+}
+
+/**
+ * @brief DMAжϷ
+ */
+void IIC_HW_DMA_RX_IRQHANDLER()
+{
+    uint32_t begin = CYCLECOUNTER_Read();
+    uint8_t error = DMA_GetITStatus(IIC_HW_DMA_RX_STREAM, IIC_HW_DMA_RX_IT_TE) != RESET;
+
+    DMA_ClearITPendingBit(IIC_HW_DMA_RX_STREAM, IIC_HW_DMA_RX_IT_TC | IIC_HW_DMA_RX_IT_TE);
+    if(!error && iicHw.state == IIC_HW_STATE_DMA && !IIC_HwIsLastSegment())
+    {
+        //Žһ, ڼDRλĴʱIICSCLȴ, ᶪ
+        iicHw.segment++;
+        DMA_ClearFlag(IIC_HW_DMA_RX_STREAM, IIC_HW_DMA_RX_FLAG_ALL);
+        IIC_HW_DMA_RX_STREAM->M0AR = (uint32_t)IIC_HwSegmentData(iicHw.transfer, iicHw.segment);
+        IIC_HW_DMA_RX_STREAM->NDTR = IIC_HwSegmentLen(iicHw.transfer, iicHw.segment);
+        if(IIC_HwIsLastSegment())
+            IIC_HW_I2C->CR2 |= I2C_CR2_LAST;
+        IIC_HW_DMA_RX_STREAM->CR |= DMA_SxCR_EN;
+        iicHw.busyCycles += CYCLECOUNTER_Read() - begin;
+        return;
+    }
+    IIC_HW_I2C->CR2 &= ~(I2C_CR2_DMAEN | I2C_CR2_LAST);
+    IIC_HW_I2C->CR1 |= I2C_CR1_STOP;//һֽյ, ֹͣź
+    if(iicHw.state == IIC_HW_STATE_DMA)
+        IIC_HwFinish(error ? IIC_STATUS_ERROR : IIC_STATUS_OK);
+    iicHw.busyCycles += CYCLECOUNTER_Read() - begin;
+}
+
+/**
+ * @brief DMAжϷ
+ */
+void IIC_HW_DMA_TX_IRQHANDLER()
+{
+    uint32_t begin = CYCLECOUNTER_Read();
+    uint8_t error = DMA_GetITStatus(IIC_HW_DMA_TX_STREAM, IIC_HW_DMA_TX_IT_TE) != RESET;
+
+    DMA_ClearITPendingBit(IIC_HW_DMA_TX_STREAM, IIC_HW_DMA_TX_IT_TC | IIC_HW_DMA_TX_IT_TE);
+    IIC_HW_I2C->CR2 &= ~I2C_CR2_DMAEN;
+    if(error)
+    {
+        IIC_HW_I2C->CR1 |= I2C_CR1_STOP;
+        IIC_HwFinish(IIC_STATUS_ERROR);
+    }
+    else if(iicHw.state == IIC_HW_STATE_DMA)
+        iicHw.state = IIC_HW_STATE_WRITE_END;//һֽڻλĴ, BTFֹͣ
+    iicHw.busyCycles += CYCLECOUNTER_Read() - begin;
+}
+
+#endif
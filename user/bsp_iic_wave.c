@@ -0,0 +1,593 @@
+/**
+ * @file    bsp_iic_wave.c
+ * @author  Miaow
+ * @version 0.10.0
+ * @date    2026/10/16
+ * @brief
+ *          This file provides functions to manage the following
+ *          functionalities of IIC driven by timer and DMA:
+ *              1. Initialization
+ *              2. Write and read registers of slave
+ *              3. Asynchronous transfer queue with callbacks
+ *              4. Bus speed setting
+ *              5. Transfer priorities
+ *              6. Transfer tracing
+ *              7. Scatter-gather reads
+ * @note
+ *          Minimum version of header file:
+ *              0.10.0
+ *          Define IIC_USE_WAVE in bsp_iic.h to enable this file.
+ *          This is the backend of IIC_BACKEND_WAVE buses, called by bsp_iic.c.
+ *          Only one bus can use it. SCL and SDA must be on the same port.
+ *          Every bit is 5 timer ticks, one BSRR word per tick:
+ *              tick    0       1       2       3       4
+ *              SCL     low     -       -       high    -(SDA sampled)
+ *              SDA     -       bit     -       -       -
+ *          Start and stop conditions take 2 bits. The buffer is played in
+ *          circular mode, each half is decoded and refilled in the DMA
+ *          interrupt while the other half is on the wire.
+ *          Recommanded pin connection:
+ *               
+ *               PB8SCL     
+ *               PB9SDA     
+ *               
+ *          STM32F407        slave
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#include "bsp_iic.h"
+#include "cyclecounter.h"
+
+#ifdef IIC_USE_WAVE
+
+#define IIC_WAVE_UNIT_TICKS         5//ÿλĶʱ
+#define IIC_WAVE_SAMPLE_TICK        4//ÿλвSDAĶʱ
+#define IIC_WAVE_HALF_TICKS         (IIC_WAVE_HALF_UNITS * IIC_WAVE_UNIT_TICKS)
+#define IIC_WAVE_BUFFER_TICKS       (IIC_WAVE_HALF_TICKS * 2)
+#define IIC_WAVE_MIN_SPEED          1000//ʱڲ65536
+
+/**
+ * @brief еĽ׶
+ */
+typedef enum {
+    IIC_WAVE_PHASE_START = 0,//ʼź
+    IIC_WAVE_PHASE_ADDRESS,//ַ+д
+    IIC_WAVE_PHASE_REGISTER,//Ĵַ
+    IIC_WAVE_PHASE_WRITE,//д
+    IIC_WAVE_PHASE_RESTART,//ظʼź
+    IIC_WAVE_PHASE_READ_ADDRESS,//ַ+
+    IIC_WAVE_PHASE_READ,//, Ӧ
+    IIC_WAVE_PHASE_STOP,//ֹͣź
+    IIC_WAVE_PHASE_IDLE//ֹͣźֻ֮ıŵĿ
+}IIC_WavePhaseTypedef;
+
+/**
+ * @brief ÿһλĲʽ
+ */
+typedef enum {
+    IIC_WAVE_PROBE_NONE = 0,
+    IIC_WAVE_PROBE_ACK,//ӻӦλ, Ϊ1ʱӦ
+    IIC_WAVE_PROBE_DATA,//λ
+    IIC_WAVE_PROBE_END//ֹͣźŵһλ, 
+}IIC_WaveProbeTypedef;
+
+/**
+ * @brief ǰ
+ */
+static struct {
+    IIC_BusTypedef *bus;//ʹòIIC
+    GPIO_TypeDef *port;//SCLSDAڵĶ˿
+    uint32_t sclLow, sclHigh, sdaLow, sdaHigh;//дBSRR
+    IIC_TransferTypedef *transfer;//ڽеĴ, NULLʾ
+    //
+    IIC_WavePhaseTypedef phase;
+    uint8_t step;//ʼ/ֹͣźŵĵڼλ; ֽڵĵڼλ, 8ΪӦλ
+    uint16_t index;//ǰ׶ѱֽ
+    //
+    uint8_t rxByte;
+    uint8_t rxBits;
+    uint8_t segment;//ֶζʱڽյĶ
+    uint16_t offset;//ڸöеλ
+    uint8_t error;//Ӧж仺
+    __IO uint32_t busyCycles;//жϷռõ
+}iicWave;
+
+static uint32_t iicWaveOut[IIC_WAVE_BUFFER_TICKS];//DMAдBSRR
+static uint16_t iicWaveIn[IIC_WAVE_BUFFER_TICKS];//DMAIDRֵ
+static uint8_t iicWaveProbe[2][IIC_WAVE_HALF_UNITS];//ÿλĲʽ
+
+/**
+ * @brief öʱ, ÿλ5, ȡʹʵʲ趨ֵ
+ */
+static void IIC_WaveSetTiming()
+{
+    uint32_t ticks = (IIC_WAVE_TIM_CLOCK / IIC_WAVE_UNIT_TICKS + iicWave.bus->speed - 1) / iicWave.bus->speed;
+    IIC_WAVE_TIM->ARR = ticks - 1;
+    IIC_WAVE_TIM->CCR1 = ticks / 2;//ÿڵм
+}
+
+/**
+ * @brief öʱDMA
+ */
+static void IIC_WaveConfig()
+{
+    TIM_TimeBaseInitTypeDef TIM_TimeBaseStructure;
+    TIM_OCInitTypeDef TIM_OCInitStructure;
+    DMA_InitTypeDef DMA_InitStructure;
+
+    //TIM, ֻø¼ͨ1Ƚ¼DMA, 
+    TIM_DeInit(IIC_WAVE_TIM);
+    TIM_TimeBaseStructure.TIM_Prescaler = 0;
+    TIM_TimeBaseStructure.TIM_CounterMode = TIM_CounterMode_Up;
+    TIM_TimeBaseStructure.TIM_Period = 0xFFFF;
+    TIM_TimeBaseStructure.TIM_ClockDivision = TIM_CKD_DIV1;
+    TIM_TimeBaseStructure.TIM_RepetitionCounter = 0;
+    TIM_TimeBaseInit(IIC_WAVE_TIM, &TIM_TimeBaseStructure);
+    TIM_OCStructInit(&TIM_OCInitStructure);
+    TIM_OC1Init(IIC_WAVE_TIM, &TIM_OCInitStructure);
+    IIC_WaveSetTiming();
+
+    //DMA, ·ѭģʽ, ÿδó
+    DMA_DeInit(IIC_WAVE_DMA_OUT_STREAM);
+    DMA_DeInit(IIC_WAVE_DMA_IN_STREAM);
+    DMA_InitStructure.DMA_Channel = IIC_WAVE_DMA_CHANNEL;
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&iicWave.port->BSRRL;//BSRRLBSRRHһд
+    DMA_InitStructure.DMA_Memory0BaseAddr = (uint32_t)iicWaveOut;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_MemoryToPeripheral;
+    DMA_InitStructure.DMA_BufferSize = IIC_WAVE_BUFFER_TICKS;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Word;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Word;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Circular;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_VeryHigh;
+    DMA_InitStructure.DMA_FIFOMode = DMA_FIFOMode_Disable;
+    DMA_InitStructure.DMA_FIFOThreshold = DMA_FIFOThreshold_Full;
+    DMA_InitStructure.DMA_MemoryBurst = DMA_MemoryBurst_Single;
+    DMA_InitStructure.DMA_PeripheralBurst = DMA_PeripheralBurst_Single;
+    DMA_Init(IIC_WAVE_DMA_OUT_STREAM, &DMA_InitStructure);
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&iicWave.port->IDR;
+    DMA_InitStructure.DMA_Memory0BaseAddr = (uint32_t)iicWaveIn;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralToMemory;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_HalfWord;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_HalfWord;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_High;
+    DMA_Init(IIC_WAVE_DMA_IN_STREAM, &DMA_InitStructure);
+    DMA_ITConfig(IIC_WAVE_DMA_IN_STREAM, DMA_IT_HT | DMA_IT_TC | DMA_IT_TE, ENABLE);//, òж
+}
+
+/**
+ * @brief ʼIIC, IIC_BusInit
+ * @param bus ʵ, SCLSDAͬһ˿
+ * @note жȼΪ0, дȼ͵ж
+ */
+void IIC_WaveInit(IIC_BusTypedef *bus)
+{
+    GPIO_InitTypeDef GPIO_InitStructure;
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    iicWave.bus = bus;
+    iicWave.port = bus->sclPort;
+    iicWave.sclHigh = bus->sclPin;
+    iicWave.sclLow = (uint32_t)bus->sclPin << 16;
+    iicWave.sdaHigh = bus->sdaPin;
+    iicWave.sdaLow = (uint32_t)bus->sdaPin << 16;
+    if(bus->speed < IIC_WAVE_MIN_SPEED || bus->speed > IIC_SPEED_FAST_PLUS)
+        bus->speed = IIC_SPEED;
+    RCC_AHB1PeriphClockCmd(IIC_GpioClock(bus->sclPort) | IIC_WAVE_DMA_CLK, ENABLE);//ʹGPIO, DMAʱ
+    RCC_APB2PeriphClockCmd(IIC_WAVE_TIM_CLK, ENABLE);//ʹܶʱʱ
+    //SCL, SDA©, д1ͷ, IDRϵĵƽ
+    iicWave.port->BSRRL = bus->sclPin | bus->sdaPin;
+    GPIO_InitStructure.GPIO_Pin = bus->sclPin | bus->sdaPin;
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_OUT;
+    GPIO_InitStructure.GPIO_OType = GPIO_OType_OD;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Fast_Speed;//50MHz
+    GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_UP;
+    GPIO_Init(iicWave.port, &GPIO_InitStructure);
+
+    IIC_WaveConfig();
+
+    //NVIC
+    NVIC_InitStructure.NVIC_IRQChannel = IIC_WAVE_DMA_IN_IRQCHANNEL;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+}
+
+/**
+ * @brief ǰڱֽ
+ */
+static inline uint8_t IIC_WaveByte()
+{
+    IIC_TransferTypedef *transfer = iicWave.transfer;
+    switch(iicWave.phase)
+    {
+        case IIC_WAVE_PHASE_ADDRESS: return transfer->addr << 1;
+        case IIC_WAVE_PHASE_REGISTER: return transfer->reg;
+        case IIC_WAVE_PHASE_WRITE: return transfer->data[iicWave.index];
+        case IIC_WAVE_PHASE_READ_ADDRESS: return (transfer->addr << 1) | 1;
+        default: return 0xFF;//ʱͷSDA
+    }
+}
+
+/**
+ * @brief һֽڵ9λһ׶
+ */
+static inline void IIC_WaveNextByte()
+{
+    IIC_TransferTypedef *transfer = iicWave.transfer;
+    switch(iicWave.phase)
+    {
+        case IIC_WAVE_PHASE_ADDRESS:
+            iicWave.phase = IIC_WAVE_PHASE_REGISTER;
+            break;
+        case IIC_WAVE_PHASE_REGISTER:
+            if(transfer->isRead)
+                iicWave.phase = IIC_WAVE_PHASE_RESTART;
+            else
+                iicWave.phase = transfer->len ? IIC_WAVE_PHASE_WRITE : IIC_WAVE_PHASE_STOP;
+            break;
+        case IIC_WAVE_PHASE_READ_ADDRESS:
+            iicWave.phase = IIC_WAVE_PHASE_READ;
+            break;
+        default://WRITE, READ
+            if(++iicWave.index >= transfer->len)
+                iicWave.phase = IIC_WAVE_PHASE_STOP;
+            break;
+    }
+}
+
+/**
+ * @brief һλ, 5BSRR
+ * @param word 5, 0ʾı
+ * @return һλĲʽ, IIC_WaveProbeTypedef
+ */
+static uint8_t IIC_WaveEncodeBit(uint32_t *word)
+{
+    uint8_t probe = IIC_WAVE_PROBE_NONE;
+    uint8_t bit;
+
+    word[0] = word[1] = word[2] = word[3] = word[4] = 0;
+    switch(iicWave.phase)
+    {
+        case IIC_WAVE_PHASE_IDLE:
+            break;
+        case IIC_WAVE_PHASE_START:
+        case IIC_WAVE_PHASE_RESTART:
+            if(iicWave.step == 0)
+            {
+                if(iicWave.phase == IIC_WAVE_PHASE_RESTART)
+                    word[0] = iicWave.sclLow;//߿ʱSCLѾΪ
+                word[1] = iicWave.sdaHigh;
+                word[3] = iicWave.sclHigh;
+                iicWave.step = 1;
+            }
+            else
+            {
+                word[1] = iicWave.sdaLow;//SCLΪʱSDA½
+                iicWave.step = 0;
+                iicWave.phase = iicWave.phase == IIC_WAVE_PHASE_START ? IIC_WAVE_PHASE_ADDRESS : IIC_WAVE_PHASE_READ_ADDRESS;
+            }
+            break;
+        case IIC_WAVE_PHASE_STOP:
+            if(iicWave.step == 0)
+            {
+                word[0] = iicWave.sclLow;
+                word[1] = iicWave.sdaLow;
+                word[3] = iicWave.sclHigh;
+                iicWave.step = 1;
+            }
+            else
+            {
+                word[1] = iicWave.sdaHigh;//SCLΪʱSDA
+                iicWave.step = 0;
+                iicWave.phase = IIC_WAVE_PHASE_IDLE;
+                probe = IIC_WAVE_PROBE_END;
+            }
+            break;
+        default:
+            if(iicWave.step < 8)
+            {
+                bit = (IIC_WaveByte() >> (7 - iicWave.step)) & 1;
+                if(iicWave.phase == IIC_WAVE_PHASE_READ)
+                    probe = IIC_WAVE_PROBE_DATA;
+            }
+            else if(iicWave.phase == IIC_WAVE_PHASE_READ)
+                bit = iicWave.index + 1 >= iicWave.transfer->len;//һֽڷͷӦ
+            else
+            {
+                bit = 1;//ͷSDA, ɴӻӦ
+                probe = IIC_WAVE_PROBE_ACK;
+            }
+            word[0] = iicWave.sclLow;
+            word[1] = bit ? iicWave.sdaHigh : iicWave.sdaLow;
+            word[3] = iicWave.sclHigh;
+            if(++iicWave.step > 8)
+            {
+                iicWave.step = 0;
+                IIC_WaveNextByte();
+            }
+            break;
+    }
+    return probe;
+}
+
+/**
+ * @brief 
+ * @param half 0-ǰ; 1-
+ */
+static void IIC_WaveEncodeHalf(uint8_t half)
+{
+    uint32_t *word = iicWaveOut + half * IIC_WAVE_HALF_TICKS;
+    uint8_t i;
+    for(i = 0; i < IIC_WAVE_HALF_UNITS; i++, word += IIC_WAVE_UNIT_TICKS)
+        iicWaveProbe[half][i] = IIC_WaveEncodeBit(word);
+}
+
+/**
+ * @brief һֽ, ֶζʱ
+ */
+static inline void IIC_WaveStoreByte(uint8_t data)
+{
+    IIC_TransferTypedef *transfer = iicWave.transfer;
+    if(!transfer->segments)
+    {
+        transfer->data[iicWave.offset++] = data;
+        return;
+    }
+    transfer->segments[iicWave.segment].data[iicWave.offset] = data;
+    if(++iicWave.offset >= transfer->segments[iicWave.segment].len)
+    {
+        iicWave.segment++;
+        iicWave.offset = 0;
+    }
+}
+
+/**
+ * @brief ֹͣʱDMA
+ * @note ͬʱʱDMA, ´ʱһ
+ */
+static void IIC_WaveStop()
+{
+    IIC_WAVE_TIM->CR1 &= ~TIM_CR1_CEN;
+    IIC_WAVE_TIM->DIER &= ~(TIM_DIER_UDE | TIM_DIER_CC1DE);
+    IIC_WAVE_DMA_OUT_STREAM->CR &= ~DMA_SxCR_EN;
+    IIC_WAVE_DMA_IN_STREAM->CR &= ~DMA_SxCR_EN;
+    while((IIC_WAVE_DMA_OUT_STREAM->CR | IIC_WAVE_DMA_IN_STREAM->CR) & DMA_SxCR_EN);
+    DMA_ClearFlag(IIC_WAVE_DMA_OUT_STREAM, IIC_WAVE_DMA_OUT_FLAG_ALL);
+    DMA_ClearFlag(IIC_WAVE_DMA_IN_STREAM, IIC_WAVE_DMA_IN_FLAG_ALL);//رDMAʱλTCIF
+    NVIC_ClearPendingIRQ(IIC_WAVE_DMA_IN_IRQCHANNEL);
+}
+
+/**
+ * @brief һδ, ǰ뻺ɶʱDMA
+ * @param transfer 
+ * @note ֻڹжϻDMAж
+ */
+static void IIC_WaveStart(IIC_TransferTypedef *transfer)
+{
+    iicWave.transfer = transfer;
+    iicWave.phase = IIC_WAVE_PHASE_START;
+    iicWave.step = 0;
+    iicWave.index = 0;
+    iicWave.rxBits = 0;
+    iicWave.segment = 0;
+    iicWave.offset = 0;
+    iicWave.error = 0;
+    IIC_WaveEncodeHalf(0);
+    IIC_WaveEncodeHalf(1);
+    IIC_WAVE_DMA_OUT_STREAM->NDTR = IIC_WAVE_BUFFER_TICKS;
+    IIC_WAVE_DMA_IN_STREAM->NDTR = IIC_WAVE_BUFFER_TICKS;
+    IIC_WAVE_DMA_OUT_STREAM->CR |= DMA_SxCR_EN;
+    IIC_WAVE_DMA_IN_STREAM->CR |= DMA_SxCR_EN;
+    IIC_WAVE_TIM->SR = 0;
+    IIC_WAVE_TIM->DIER |= TIM_DIER_UDE | TIM_DIER_CC1DE;
+    //㲢һ, ֮nڿʼʱn, м
+    IIC_WAVE_TIM->EGR = TIM_EGR_UG;
+    IIC_WAVE_TIM->CR1 |= TIM_CR1_CEN;
+}
+
+/**
+ * @brief ߿ʱеһ
+ * @note ֻڹжϻDMAж
+ */
+static inline void IIC_WaveStartNext()
+{
+    IIC_TransferTypedef *transfer;
+    if(iicWave.transfer)
+        return;
+    transfer = IIC_QueuePop(iicWave.bus);
+    if(transfer)
+        IIC_WaveStart(transfer);
+}
+
+/**
+ * @brief ǰ, Ȼһ
+ * @param status IIC_STATUS_OKIIC_STATUS_ERROR
+ * @note صPendSVִ, DMAжִ
+ */
+static void IIC_WaveFinish(IIC_StatusTypedef status)
+{
+    IIC_TransferTypedef *transfer = iicWave.transfer;
+
+    IIC_WaveStop();
+    iicWave.transfer = NULL;
+    if(transfer)
+    {
+        transfer->status = status;
+#ifdef IIC_USE_TRACE
+        IIC_TraceAdd(iicWave.bus, transfer, transfer->submitCycles);
+#endif
+        IIC_DonePush(iicWave.bus, transfer);
+    }
+    IIC_WaveStartNext();
+}
+
+/**
+ * @brief : ȡеӦλλ, ٱλȥ
+ * @param half 0-ǰ; 1-
+ * @note Ӧʱ޸ڲŵһ, һ뿪ʼֹͣź
+ */
+static void IIC_WaveHalfDone(uint8_t half)
+{
+    const uint16_t *sample = iicWaveIn + half * IIC_WAVE_HALF_TICKS + IIC_WAVE_SAMPLE_TICK;
+    uint16_t sdaPin = iicWave.bus->sdaPin;
+    uint16_t next;
+    uint8_t i, end = 0;
+
+    for(i = 0; i < IIC_WAVE_HALF_UNITS; i++, sample += IIC_WAVE_UNIT_TICKS)
+    {
+        switch(iicWaveProbe[half][i])
+        {
+            case IIC_WAVE_PROBE_ACK:
+                if(*sample & sdaPin)
+                    iicWave.error = 1;
+                break;
+            case IIC_WAVE_PROBE_DATA:
+                iicWave.rxByte = (iicWave.rxByte << 1) | ((*sample & sdaPin) != 0);
+                if(++iicWave.rxBits == 8)
+                {
+                    iicWave.rxBits = 0;
+                    if(!iicWave.error)
+                        IIC_WaveStoreByte(iicWave.rxByte);
+                }
+                break;
+            case IIC_WAVE_PROBE_END:
+                end = 1;
+                break;
+            default:
+                break;
+        }
+    }
+    if(end)
+    {
+        IIC_WaveFinish(iicWave.error ? IIC_STATUS_ERROR : IIC_STATUS_OK);
+        return;
+    }
+    if(iicWave.error && iicWave.phase < IIC_WAVE_PHASE_STOP)
+    {
+        iicWave.phase = IIC_WAVE_PHASE_STOP;
+        iicWave.step = 0;
+    }
+    IIC_WaveEncodeHalf(half);
+    //Ѿһ˵, ϵĲβ, ŷֹͣźŲس
+    next = (IIC_WAVE_BUFFER_TICKS - IIC_WAVE_DMA_OUT_STREAM->NDTR) % IIC_WAVE_BUFFER_TICKS;//һҪ
+    if((uint16_t)((next + IIC_WAVE_BUFFER_TICKS - half * IIC_WAVE_HALF_TICKS) % IIC_WAVE_BUFFER_TICKS - 1) < IIC_WAVE_HALF_TICKS - 1)
+        iicWave.error = 1;
+}
+
+/**
+ * @brief ύһ첽, 
+ * @param bus ʵ
+ * @param transfer , addr, reg, isRead, len, data, callback
+ * @return 0-Ѽ; 1-
+ * @note ߿ʱ, һж
+ *       صPendSVִ, ִ֮ǰٴύͬһ
+ */
+uint8_t IIC_WaveSubmit(IIC_BusTypedef *bus, IIC_TransferTypedef *transfer)
+{
+    uint32_t begin = CYCLECOUNTER_Read();
+    uint32_t primask;
+    uint8_t res;
+
+    transfer->status = IIC_STATUS_PENDING;
+    primask = __get_PRIMASK();
+    __disable_irq();
+    res = IIC_QueuePush(bus, transfer);
+    if(res)
+        transfer->status = IIC_STATUS_ERROR;
+    else
+        IIC_WaveStartNext();
+    __set_PRIMASK(primask);
+    iicWave.busyCycles += CYCLECOUNTER_Read() - begin;
+    return res;
+}
+
+/**
+ * @brief 
+ * @param bus ʵ
+ * @param speed (Hz), 1KHz~1MHz
+ * @return 0-; 1-ָ֧
+ * @note ȵǰڹжϵ޸Ķʱ
+ */
+uint8_t IIC_WaveSetSpeed(IIC_BusTypedef *bus, uint32_t speed)
+{
+    uint32_t primask;
+    if(speed < IIC_WAVE_MIN_SPEED || speed > IIC_SPEED_FAST_PLUS)
+        return 1;
+    while(1)
+    {
+        primask = __get_PRIMASK();
+        __disable_irq();
+        if(!iicWave.transfer)
+            break;
+        __set_PRIMASK(primask);
+    }
+    bus->speed = speed;
+    if(bus->isInitialized)
+        IIC_WaveSetTiming();
+    __set_PRIMASK(primask);
+    return 0;
+}
+
+/**
+ * @brief ύһδ䲢ȴ
+ * @param bus ʵ
+ * @param transfer , ɵ, priorityΪȼ, callbackΪNULL
+ * @return 0-; 1-
+ * @note 첽乲ö, ȼŶ, ȼ첽Ƚ
+ *       ɶʱDMA, ܻȷʱڽ, Ҫʱ
+ */
+uint8_t IIC_WaveTransfer(IIC_BusTypedef *bus, IIC_TransferTypedef *transfer)
+{
+    while(IIC_WaveSubmit(bus, transfer));//ʱȴλ
+    while(transfer->status == IIC_STATUS_PENDING);
+    return transfer->status != IIC_STATUS_OK;
+}
+
+/**
+ * @brief жϷۼռõ, IIC_BusBenchmark
+ */
+uint32_t IIC_WaveBusyCycles()
+{
+    return iicWave.busyCycles;
+}
+
+/**
+ * @brief DMAжϷ, ÿһ
+ */
+void IIC_WAVE_DMA_IN_IRQHANDLER()
+{
+    uint32_t begin = CYCLECOUNTER_Read();
+
+    if(DMA_GetITStatus(IIC_WAVE_DMA_IN_STREAM, IIC_WAVE_DMA_IN_IT_TE) != RESET)
+    {
+        IIC_WaveStop();
+        iicWave.port->BSRRL = iicWave.bus->sclPin | iicWave.bus->sdaPin;//ͷ
+        if(iicWave.transfer)
+            IIC_WaveFinish(IIC_STATUS_ERROR);
+    }
+    if(DMA_GetITStatus(IIC_WAVE_DMA_IN_STREAM, IIC_WAVE_DMA_IN_IT_HT) != RESET)
+    {
+        DMA_ClearITPendingBit(IIC_WAVE_DMA_IN_STREAM, IIC_WAVE_DMA_IN_IT_HT);
+        if(iicWave.transfer)
+            IIC_WaveHalfDone(0);
+    }
+    if(DMA_GetITStatus(IIC_WAVE_DMA_IN_STREAM, IIC_WAVE_DMA_IN_IT_TC) != RESET)
+    {
+        DMA_ClearITPendingBit(IIC_WAVE_DMA_IN_STREAM, IIC_WAVE_DMA_IN_IT_TC);
+        if(iicWave.transfer)
+            IIC_WaveHalfDone(1);
+    }
+    iicWave.busyCycles += CYCLECOUNTER_Read() - begin;
+}
+
+#endif
@@ -19,21 +19,33 @@
 #include "delay.h"
 #include "stdio.h"
 
-#ifdef CONTROL_USE_MPU6050
+#if defined CONTROL_USE_MPU6050 && defined CONTROL_USE_FUSION
+    #include "mpu6050.h"
+    #define MPU_InitWithDmp MPU6050_InitWithFusion
+    #define MPU_GetDmpData MPU6050_GetFusionData
+    #define MPU_RATE MPU6050_FUSION_RATE
+#elif defined CONTROL_USE_MPU6050
     #include "mpu6050.h"
     #define MPU_InitWithDmp MPU6050_InitWithDmp
     #define MPU_GetDmpData MPU6050_GetDmpData
+    #define MPU_RATE MPU6050_FIFO_RATE
 #elif defined CONTROL_USE_MPU9250
     #include "mpu9250.h"
     #define MPU_InitWithDmp MPU9250_InitWithDmp
     #define MPU_GetDmpData MPU9250_GetDmpData
+    #define MPU_RATE MPU9250_FIFO_RATE
 #endif
 #if !defined CONTROL_USE_MPU6050 && !defined CONTROL_USE_MPU9250
     #error  Which gyro are you using? Define CONTROL_USE_MPUxxxx in your options.
 #endif
+#if defined CONTROL_USE_FUSION && !defined CONTROL_USE_MPU6050
+    #error  CONTROL_USE_FUSION is only available with CONTROL_USE_MPU6050.
+#endif
 
 #ifdef CONTROL_USE_OLED_DEBUG
     #include "oled.h"
+    #include "oled_widget.h"
+    #include "oled_chart.h"
     extern OLED_HandleTypedef oledHandle;
 #endif
 /** @addtogroup CONTROL
@@ -68,6 +80,22 @@ static int32_t targetAngle, actualAngle;
  */
 static CONTROL_StateTypedef CONTROL_State = CONTROL_StateStop;
 
+#ifdef CONTROL_USE_OLED_DEBUG
+/**
+ * @brief Values bound to the status screen, only changed characters are redrawn.
+ */
+static int32_t displayYaw, displayCode;
+static OLED_WidgetTypedef CONTROL_Widgets[] = {
+    OLED_WIDGET_INIT(0, 1, 5, "%5d", OLED_WIDGET_INT32, &displayYaw)
+};
+#ifdef CONTROL_USE_OLED_PLOT
+/**
+ * @brief Strip chart for tuning CONTROL_VELOCITY_KP/KI, target speed as a line and actual speed as dots.
+ */
+static OLED_ChartTypedef CONTROL_SpeedChart = OLED_CHART_INIT(0, 128, 5, 3, 2, 0, 0, 1);
+#endif
+#endif
+
 
 int32_t CONTROL_IncrementalPi(uint8_t motorX, int32_t actualSpeed, int32_t targetSpeed);
 void CONTROL_Refresh(void);
@@ -111,6 +139,7 @@ void CONTROL_Init()
     oledHandle.stringContinuous = DISABLE;
     OLED_Clear(&oledHandle);
     OLED_DisplayFormat(&oledHandle, "  YAW  LO   RO\r\n\r\n\r\n  LTS  RTS  LAS  RAS");
+    OLED_WidgetInvalidate(CONTROL_Widgets, sizeof(CONTROL_Widgets) / sizeof(CONTROL_Widgets[0]));
     #endif
     MPU6050_BeginReceive();
 }
@@ -124,7 +153,7 @@ void CONTROL_Refresh()
     float pitch, roll, yaw;//Euler angle of the car
     uint8_t code = MPU_GetDmpData(&pitch, &roll, &yaw);
 
-    if(++i == 20)
+    if(++i == MPU_RATE / 10)//every 100ms
     {
         i = 0;
         actualSpeed[0] = HALLENCODER_ReadDeltaValue(HALLENCODER_A) * 7 / 2;//actual speed of left
@@ -136,12 +165,14 @@ void CONTROL_Refresh()
         //printf("t=%d,%d,o=%d,%d,a=%d,%d\r\n", targetSpeed[0], targetSpeed[1], outputSpeed[0], outputSpeed[1], actualSpeed[0], actualSpeed[1]);
         printf("%d,%d,%d,%d,%f\r\n", targetSpeed[0], targetSpeed[1], actualSpeed[0], actualSpeed[1], yaw);
         #ifdef CONTROL_USE_OLED_DEBUG
-        oledHandle.stringX = 0;
-        oledHandle.stringY = 1;
-        if(code)
-            OLED_DisplayFormat(&oledHandle, "Err-%d", (int32_t)code);
-        else
-            OLED_DisplayFormat(&oledHandle, "%5d", (uint32_t)yaw);
+        displayYaw = (int32_t)yaw;
+        displayCode = code;
+        CONTROL_Widgets[0].format = code ? "Err-%d" : "%5d";
+        CONTROL_Widgets[0].value = code ? &displayCode : &displayYaw;
+        OLED_WidgetRefresh(CONTROL_Widgets, sizeof(CONTROL_Widgets) / sizeof(CONTROL_Widgets[0]));
+        #ifdef CONTROL_USE_OLED_PLOT
+        OLED_ChartAddSample(&CONTROL_SpeedChart, targetSpeed[0], actualSpeed[0]);
+        #endif
 //        
 //        oledHandle.stringX = 5;
 //        OLED_DisplayFormat(&oledHandle, "%5d%5d", outputSpeed[0], outputSpeed[1]);
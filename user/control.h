@@ -36,8 +36,15 @@
  * @}
  */ 
 
+/**
+ * @brief Use raw mpu6050 samples fused on the MCU at MPU6050_FUSION_RATE instead of the DMP.
+ * @note Only for CONTROL_USE_MPU6050.
+ */
+//#define CONTROL_USE_FUSION
+
 #ifdef USE_OLED_DEBUG
     #define CONTROL_USE_OLED_DEBUG
+    //#define CONTROL_USE_OLED_PLOT//plot target and actual speed of the left motors on lines 5~7
 #endif
 /** 
  * @defgroup CONTROL_timer_define
@@ -0,0 +1,37 @@
+/**
+ * @file    cyclecounter.c
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2026/10/16
+ * @brief
+ *          This file provides functions to manage the following
+ *          functionalities of DWT cycle counter:
+ *              1. Initialization
+ *              2. Read cycles and convert them to time
+ * @note
+ *          Minimum version of header file:
+ *              0.1.0
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#include "cyclecounter.h"
+
+/**
+ * @brief ʼDWTڼ, ظ
+ * @note Ϊ32λ, 168MHzԼ25.5һ, ֵʱֱ
+ */
+void CYCLECOUNTER_Init()
+{
+    if(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)
+        return;
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;//ʹDWT
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;//ʼ
+}
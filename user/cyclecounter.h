@@ -0,0 +1,49 @@
+/**
+ * @file    cyclecounter.h
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2026/10/16
+ * @brief
+ *          This file provides functions to manage the following
+ *          functionalities of DWT cycle counter:
+ *              1. Initialization
+ *              2. Read cycles and convert them to time
+ * @note
+ *          Minimum version of source file:
+ *              0.1.0
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#ifndef __CYCLECOUNTER_H
+#define __CYCLECOUNTER_H
+
+#include "stm32f4xx.h"
+
+/**
+ * @brief ںʱƵ(Hz)
+ */
+#define CYCLECOUNTER_CORE_CLOCK     168000000
+
+/**
+ * @brief ȡǰڼ
+ */
+#define CYCLECOUNTER_Read()         (DWT->CYCCNT)
+
+/**
+ * @brief Ϊ΢
+ */
+#define CYCLECOUNTER_ToUs(cycles)   ((uint32_t)(cycles) / (CYCLECOUNTER_CORE_CLOCK / 1000000))
+
+/**
+ * @brief ʼDWTڼ, ظ
+ */
+void CYCLECOUNTER_Init(void);
+
+#endif
@@ -13,7 +13,6 @@ OLED_HandleTypedef oledHandle =
     .stringY = 0,
     .stringClear = DISABLE,
     .stringContinuous = ENABLE,
-    .__string = {0},
 };
 
 int main(void)
@@ -29,6 +28,7 @@ int main(void)
     CONTROL_SetSpeed(CONTROL_MOTOR_ALL ,500);
     while(1)
     {
+        OLED_ProcessLog(&oledHandle);//ʾжOLED_PostLogϢ
         //OLED_DisplayFormat(&oledHandle, "abcdefghijklmnopqrstuvwxy\r\n\r\nzabcde\ti\r\njklmnopqrstuvwxyzabcpqrstuvwxyzabc!");
     }
     
@@ -1,268 +0,0 @@
-#include "bsp_iic.h"
-
-static void IIC_Start(void);
-static void IIC_Stop(void);
-static uint8_t IIC_WaitAck(void);
-static void IIC_Ack(void);
-static void IIC_NAck(void);
-
-/**
- * @brief ʼIIC
- */
-void IIC_Init()
-{            
-    GPIO_InitTypeDef GPIO_InitStructure;
-    RCC_AHB1PeriphClockCmd(IIC_SCL_GPIO_CLK | IIC_SDA_GPIO_CLK, ENABLE);//ʹGPIOʱ
-    //SCL, SDAʼ
-    GPIO_InitStructure.GPIO_Pin = IIC_SCL_PIN;
-    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_OUT;//ͨģʽ
-    GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;//
-    GPIO_InitStructure.GPIO_Speed = GPIO_Fast_Speed;//50MHz
-    GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_UP;//
-    GPIO_Init(IIC_SCL_PORT, &GPIO_InitStructure);//ʼ
-    GPIO_InitStructure.GPIO_Pin = IIC_SDA_PIN;
-    GPIO_Init(IIC_SDA_PORT, &GPIO_InitStructure);//ʼ
-    IIC_SCL_PORT->BSRRL = IIC_SCL_PIN;//IIC_SCL=1
-    IIC_SDA_PORT->BSRRL = IIC_SDA_PIN;//IIC_SDA=1
-}
-/**
- * @brief IICʼź
- */
-static void IIC_Start()
-{
-    IIC_Out();//sda
-    IIC_SDA_PORT->BSRRL = IIC_SDA_PIN;//IIC_SDA=1      
-    IIC_SCL_PORT->BSRRL = IIC_SCL_PIN;//IIC_SCL=1
-    delay_us(4);
-    IIC_SDA_PORT->BSRRH = IIC_SDA_PIN;//IIC_SDA=0 START:when CLK is high,DATA change form high to low 
-    delay_us(4);
-    IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//ǯסI2Cߣ׼ͻ 
-}      
-/**
- * @brief IICֹͣź
- */
-static void IIC_Stop()
-{
-    IIC_Out();//sda
-    IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0
-    IIC_SDA_PORT->BSRRH = IIC_SDA_PIN;//IIC_SDA=0 STOP:when CLK is high DATA change form low to high
-    delay_us(4);
-    IIC_SCL_PORT->BSRRL = IIC_SCL_PIN;//IIC_SCL=1;
-    IIC_SDA_PORT->BSRRL = IIC_SDA_PIN;//IIC_SDA=1IIC_SDA=1 I2C߽ź
-    delay_us(4);                                   
-}
-/**
- * @brief ȴӦź
- * @return 1-Ӧʧ; 0-Ӧɹ
- */
-static uint8_t IIC_WaitAck()
-{
-    uint8_t ucErrTime=0;
-    IIC_In();//SDAΪ  
-    IIC_SDA_PORT->BSRRL = IIC_SDA_PIN;//IIC_SDA=1
-    delay_us(1);       
-    IIC_SCL_PORT->BSRRL = IIC_SCL_PIN;//IIC_SCL=1
-    delay_us(1);     
-    while(IIC_SDA_PORT->IDR & IIC_SDA_PIN)
-    {
-        ucErrTime++;
-        if(ucErrTime>250)
-        {
-            IIC_Stop();
-            return 1;
-        }
-    }
-    IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0 ʱ0        
-    return 0;  
-} 
-/**
- * @brief ACKӦ
- */
-static void IIC_Ack()
-{
-    IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0
-    IIC_Out();
-    IIC_SDA_PORT->BSRRH = IIC_SDA_PIN;//IIC_SDA=0
-    delay_us(2);
-    IIC_SCL_PORT->BSRRL = IIC_SCL_PIN;//IIC_SCL=1
-    delay_us(2);
-    IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0
-}
-/**
- * @brief Ӧź
- */           
-static void IIC_NAck()
-{
-    IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0
-    IIC_Out();
-    IIC_SDA_PORT->BSRRL = IIC_SDA_PIN;//IIC_SDA=1
-    delay_us(2);
-    IIC_SCL_PORT->BSRRL = IIC_SCL_PIN;//IIC_SCL=1
-    delay_us(2);
-    IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0
-}                                          
-/**
- * @brief IICһֽ
- * @return 1-Ack; 0-Ack
- */      
-void IIC_WriteByte(uint8_t data)
-{                        
-    uint8_t i;   
-    IIC_Out();         
-    IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0 ʱӿʼݴ
-    for(i = 0; i<8;i++)
-    {            
-        if((data & 0x80) >> 7)
-            IIC_SDA_PORT->BSRRL = IIC_SDA_PIN;//IIC_SDA=1
-        else
-            IIC_SDA_PORT->BSRRH = IIC_SDA_PIN;//IIC_SDA=0
-        data <<= 1;       
-        delay_us(2);   //TEA5767ʱǱ
-        IIC_SCL_PORT->BSRRL = IIC_SCL_PIN;//IIC_SCL=1
-        delay_us(2); 
-        IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0
-        delay_us(2);
-    }     
-}         
-/**
- * @brief 1ֽ
- * @param ack
- *          1-Ӧ
- *          0-ͷӦ
- * @return ضȡһֽ
- */ 
-uint8_t IIC_ReadByte(uint8_t ack)
-{
-    uint8_t i, receive = 0;
-    IIC_In();//SDAΪ
-    for(i = 0; i < 8; i++)
-    {
-        IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0 
-        delay_us(2);
-        IIC_SCL_PORT->BSRRL = IIC_SCL_PIN;//IIC_SCL=1
-        receive <<= 1;
-        if(IIC_SDA_PORT->IDR & IIC_SDA_PIN)
-            receive++;   
-        delay_us(1); 
-    }                     
-    if (!ack)
-        IIC_NAck();//nACK
-    else
-        IIC_Ack(); //ACK   
-    return receive;
-}
-/**
- * @brief IICд1ֽڵĴ
- * @param addr ַ
- * @param reg Ĵַ
- * @param data Ҫд
- * @return 0-; 1-
- */
-uint8_t IIC_WriteRegByte(uint8_t addr, uint8_t reg, uint8_t data)
-{ 
-    IIC_Start(); 
-	IIC_WriteByte(addr << 1);//ַ+д	
-	if(IIC_WaitAck())	//ȴӦ
-	{
-		IIC_Stop();		 
-		return 1;		
-	}
-    IIC_WriteByte(reg);	//дĴַ
-    IIC_WaitAck();		//ȴӦ 
-	IIC_WriteByte(data);//
-	if(IIC_WaitAck())	//ȴACK
-	{
-		IIC_Stop();	 
-		return 1;		 
-	}		 
-    IIC_Stop();	 
-	return 0;
-}
-/**
- * @brief IIC1ֽڵĴ
- * @param addr ַ
- * @param reg Ĵַ
- * @return Ҫȡ
- */
-uint8_t IIC_ReadRegByte(uint8_t addr, uint8_t reg)
-{
-	uint8_t res;
-    IIC_Start(); 
-	IIC_WriteByte(addr << 1);//ַ+д	
-	IIC_WaitAck();//ȴӦ 
-    IIC_WriteByte(reg);//дĴַ
-    IIC_WaitAck();//ȴӦ
-    IIC_Start();
-	IIC_WriteByte((addr << 1) | 1);//ַ+	
-    IIC_WaitAck();//ȴӦ 
-	res = IIC_ReadByte(0);//ȡ,nACK 
-    IIC_Stop();//һֹͣ 
-	return res;		
-}
-
-/**
- * @brief IICд
- * @param addr ַ
- * @param reg Ĵַ
- * @param len дֽ
- * @param data Ҫд
- * @return 0-; 1-
- */
-uint8_t IIC_WriteRegBytes(uint8_t addr, uint8_t reg, uint8_t len, uint8_t *data)
-{
-    uint8_t i; 
-    IIC_Start(); 
-    IIC_WriteByte(addr << 1);//ַ+д    
-    if(IIC_WaitAck())//ȴӦ
-    {
-        IIC_Stop();         
-        return 1;        
-    }
-    IIC_WriteByte(reg);//дĴַ
-    IIC_WaitAck();//ȴӦ
-    for(i = 0; i < len; i++)
-    {
-        IIC_WriteByte(data[i]);//
-        if(IIC_WaitAck())//ȴACK
-        {
-            IIC_Stop();     
-            return 1;         
-        }        
-    }    
-    IIC_Stop();     
-    return 0;    
-} 
-/**
- * @brief IIC
- * @param addr ַ
- * @param reg Ĵַ
- * @param len ȡֽ
- * @param data Ҫȡ
- * @return 0-; 1-
- */
-uint8_t IIC_ReadRegBytes(uint8_t addr, uint8_t reg, uint8_t len, uint8_t *data)
-{ 
-    IIC_Start(); 
-    IIC_WriteByte(addr<<1);//ַ+д    
-    if(IIC_WaitAck())//ȴӦ
-    {
-        IIC_Stop();         
-        return 1;        
-    }
-    IIC_WriteByte(reg);//дĴַ
-    IIC_WaitAck();//ȴӦ
-    IIC_Start();
-    IIC_WriteByte((addr << 1) | 1);//ַ+    
-    IIC_WaitAck();//ȴӦ 
-    while(len)
-    {
-        if(len == 1)
-            *data=IIC_ReadByte(0);//,nACK 
-        else
-            *data=IIC_ReadByte(1);//,ACK  
-        len--;
-        data++; 
-    }    
-    IIC_Stop();//һֹͣ 
-    return 0;    
-}
@@ -43,8 +43,21 @@
 //#include "log.h"
 //#include "board-st_discovery.h"
    
+/* Keep a RAM copy of the configuration registers, see mpu_shadow_write.
+ * Comment out to send every read-modify-write to the bus.
+ */
+#define MPU_USE_REG_SHADOW
+#ifdef MPU_USE_REG_SHADOW
+static int mpu_shadow_write(unsigned char slave_addr, unsigned char reg_addr,
+    unsigned char length, unsigned char *data);
+static int mpu_shadow_read(unsigned char slave_addr, unsigned char reg_addr,
+    unsigned char length, unsigned char *data);
+#define i2c_write       mpu_shadow_write
+#define i2c_read        mpu_shadow_read
+#else
 #define i2c_write       IIC_WriteRegBytes
 #define i2c_read        IIC_ReadRegBytes 
+#endif
 #define delay_ms        delay_ms
 #define get_ms(...)     do {} while (0)
 #define log_i(...)      do {} while (0)
@@ -619,6 +632,109 @@ static struct gyro_state_s st = {
 };
 #endif
 
+#ifdef MPU_USE_REG_SHADOW
+/* Registers that only change when the host writes them. Everything else
+ * (FIFO, DMP memory, interrupt status, sensor data, PWR_MGMT_1 and the
+ * slave 4 registers, whose enable bit clears itself) always goes to the bus.
+ */
+#define SHADOW_CACHED(reg)  (((reg) >= 0x19 && (reg) <= 0x30) || \
+    ((reg) >= 0x37 && (reg) <= 0x38) || ((reg) >= 0x63 && (reg) <= 0x67) || \
+    (reg) == 0x69 || (reg) == 0x6A || (reg) == 0x6C)
+/* USER_CTRL reset bits clear themselves, writing USER_CTRL always goes out. */
+#define SHADOW_USER_CTRL        (0x6A)
+#define SHADOW_USER_CTRL_RESETS (0x0F)
+
+static struct {
+    unsigned char value[0x70];
+    unsigned char valid[0x70 / 8];
+} shadow;
+
+#define shadow_is_valid(reg)    (shadow.valid[(reg) >> 3] & (1 << ((reg) & 7)))
+
+static void shadow_store(unsigned char reg, unsigned char value)
+{
+    if (reg == SHADOW_USER_CTRL)
+        value &= ~SHADOW_USER_CTRL_RESETS;
+    shadow.value[reg] = value;
+    shadow.valid[reg >> 3] |= 1 << (reg & 7);
+}
+
+/**
+ *  @brief      Write-through register write for the MPU.
+ *  A write is skipped when every register it covers is cached and already
+ *  holds the value. A device reset through PWR_MGMT_1 drops the cache.
+ *  Other slaves (the compass in bypass mode) are passed through.
+ */
+static int mpu_shadow_write(unsigned char slave_addr, unsigned char reg_addr,
+    unsigned char length, unsigned char *data)
+{
+    unsigned char ii, reg;
+
+    if (slave_addr != st.hw->addr || reg_addr == st.reg->fifo_r_w ||
+        reg_addr == st.reg->mem_r_w)
+        return IIC_WriteRegBytes(slave_addr, reg_addr, length, data);
+    for (ii = 0; ii < length; ii++) {
+        reg = reg_addr + ii;
+        if (!SHADOW_CACHED(reg) || reg == SHADOW_USER_CTRL ||
+            !shadow_is_valid(reg) || shadow.value[reg] != data[ii])
+            break;
+    }
+    if (length && ii == length)
+        return 0;
+    if (IIC_WriteRegBytes(slave_addr, reg_addr, length, data)) {
+        /* The device may have taken part of the data. */
+        for (ii = 0; ii < length; ii++) {
+            reg = reg_addr + ii;
+            if (SHADOW_CACHED(reg))
+                shadow.valid[reg >> 3] &= ~(1 << (reg & 7));
+        }
+        return -1;
+    }
+    if (reg_addr <= st.reg->pwr_mgmt_1 && reg_addr + length > st.reg->pwr_mgmt_1 &&
+        (data[st.reg->pwr_mgmt_1 - reg_addr] & BIT_RESET)) {
+        memset(&shadow, 0, sizeof(shadow));
+        return 0;
+    }
+    for (ii = 0; ii < length; ii++) {
+        reg = reg_addr + ii;
+        if (SHADOW_CACHED(reg))
+            shadow_store(reg, data[ii]);
+    }
+    return 0;
+}
+
+/**
+ *  @brief      Register read for the MPU, served from the cache when every
+ *  register is cached and valid. A bus read fills the cache.
+ */
+static int mpu_shadow_read(unsigned char slave_addr, unsigned char reg_addr,
+    unsigned char length, unsigned char *data)
+{
+    unsigned char ii, reg;
+
+    if (slave_addr != st.hw->addr || reg_addr == st.reg->fifo_r_w ||
+        reg_addr == st.reg->mem_r_w)
+        return IIC_ReadRegBytes(slave_addr, reg_addr, length, data);
+    for (ii = 0; ii < length; ii++) {
+        reg = reg_addr + ii;
+        if (!SHADOW_CACHED(reg) || !shadow_is_valid(reg))
+            break;
+    }
+    if (length && ii == length) {
+        memcpy(data, &shadow.value[reg_addr], length);
+        return 0;
+    }
+    if (IIC_ReadRegBytes(slave_addr, reg_addr, length, data))
+        return -1;
+    for (ii = 0; ii < length; ii++) {
+        reg = reg_addr + ii;
+        if (SHADOW_CACHED(reg))
+            shadow_store(reg, data[ii]);
+    }
+    return 0;
+}
+#endif
+
 #define MAX_PACKET_LENGTH (12)
 #ifdef MPU6500
 #define HWST_MAX_PACKET_LENGTH (512)
@@ -714,13 +830,23 @@ int mpu_read_reg(unsigned char reg, unsigned char *data)
  */
 int mpu_init()
 {
-    unsigned char data[6];
+    unsigned char data[6], ii;
 
-    /* Reset device. */
+    /* Reset device. The reset bit clears itself once the registers are
+     * back to their defaults, so poll it instead of always waiting 100ms.
+     * The device may not acknowledge while it is resetting.
+     */
     data[0] = BIT_RESET;
     if (i2c_write(st.hw->addr, st.reg->pwr_mgmt_1, 1, data))
         return -1;
-    delay_ms(100);
+    for (ii = 0; ii < 100; ii++) {
+        delay_ms(1);
+        if (!i2c_read(st.hw->addr, st.reg->pwr_mgmt_1, 1, data) &&
+            !(data[0] & BIT_RESET))
+            break;
+    }
+    if (ii == 100)
+        return -1;
 
     /* Wake up chip. */
     data[0] = 0x00;
@@ -786,6 +912,21 @@ int mpu_init()
     return 0;
 }
 
+/**
+ *  @brief      Forget the cached chip configuration.
+ *  Call after the configuration registers were written without this driver.
+ *  The register shadow is dropped and the driver reports the sensors as off,
+ *  so mpu_init has to run again before the other mpu_* calls.
+ */
+void mpu_forget_config(void)
+{
+#ifdef MPU_USE_REG_SHADOW
+    memset(&shadow, 0, sizeof(shadow));
+#endif
+    st.chip_cfg.sensors = 0;
+    st.chip_cfg.dmp_on = 0;
+}
+
 /**
  *  @brief      Enter low-power accel-only mode.
  *  In low-power accel mode, the chip goes to sleep and only wakes up to sample
@@ -63,6 +63,7 @@ struct int_param_s {
 
 /* Set up APIs */
 int mpu_init(void);
+void mpu_forget_config(void);
 int mpu_init_slave(void);
 int mpu_set_bypass(unsigned char bypass_on);
 
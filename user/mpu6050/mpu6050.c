@@ -1,7 +1,7 @@
 /**
  * @file    mpu6050.c
  * @author  Miaow
- * @version 0.1.2
+ * @version 0.7.0
  * @date    2018/08/31
  * @brief   
  *          This file provides functions to manage the following 
@@ -9,9 +9,13 @@
  *              1. Initialization and setup
  *              2. Get raw data from gyroscope, accelerometer and thermometer
  *              3. DMP operations
+ *              4. Non-blocking DMP read with asynchronous IIC
+ *              5. Batched DMP FIFO drain with sequence numbers and overrun counters
+ *              6. Single precision attitude output as Euler angles, yaw or quaternion
+ *              7. Raw gyroscope and accelerometer FIFO at up to 1kHz fused on the MCU
  * @note
  *          Minimum version of header file:
- *              0.1.0
+ *              0.5.0
  *          Recommanded pin connection:
  *               
  *               PB8SCL  XDAX
@@ -32,6 +36,8 @@
 #include "mpu6050.h"
 #include "inv_mpu.h"
 #include "inv_mpu_dmp_motion_driver.h" 
+#include "attitude.h"
+#include "string.h"
 /**
  * @brief Ĵ
  */
@@ -110,9 +116,73 @@
 static int8_t MPU6050_GyroOrientation[9] = { 1, 0, 0,
                                              0, 1, 0,
                                              0, 0, 1};
+/**
+ * @brief ʼĴ, ַļĴϲΪһд
+ * @note ǡ2000dps, ٶȴ2g, 50Hz, 
+ *       жϹ, I2Cģʽ, FIFO, INTЧ, Xʱ
+ */
+static const IIC_InitEntryTypedef MPU6050_InitTable[] = {
+    IIC_INIT_WRITE(MPU6050_ADDR, MPU6050_REG_PWR_MGMT1, 0X80),//λMPU6050
+    IIC_INIT_POLL(MPU6050_ADDR, MPU6050_REG_PWR_MGMT1, 0X80, 0X00, 100),//λɺDEVICE_RESETλԶ, 100ms
+    IIC_INIT_WRITE(MPU6050_ADDR, MPU6050_REG_PWR_MGMT1, 0X01),//MPU6050, CLKSEL XPLLΪο
+    IIC_INIT_WRITE(MPU6050_ADDR, MPU6050_REG_PWR_MGMT2, 0X00),//ٶǶ
+    IIC_INIT_WRITE(MPU6050_ADDR, MPU6050_REG_SAMPLE_RATE, 1000 / 50 - 1),//ò50Hz
+    IIC_INIT_WRITE(MPU6050_ADDR, MPU6050_REG_CFG, MPU6050_FILTER_20HZ),//LPFΪʵһ
+    IIC_INIT_WRITE(MPU6050_ADDR, MPU6050_REG_GYRO_CFG, MPU6050_FSR_2000DPS << 3),//ǡ2000dps
+    IIC_INIT_WRITE(MPU6050_ADDR, MPU6050_REG_ACCEL_CFG, MPU6050_FSR_2G << 3),//ٶȴ2g
+    IIC_INIT_WRITE(MPU6050_ADDR, MPU6050_REG_FIFO_EN, 0X00),//رFIFO
+    IIC_INIT_WRITE(MPU6050_ADDR, MPU6050_REG_INTBP_CFG, 0X80),//INTŵ͵ƽЧ
+    IIC_INIT_WRITE(MPU6050_ADDR, MPU6050_REG_INT_EN, 0X00),//رж
+    IIC_INIT_WRITE(MPU6050_ADDR, MPU6050_REG_USER_CTRL, 0X00)//I2Cģʽر
+};
 static inline void MPU6050_InitExti(void (* irqHandler)(void));
 void (* MPU6050_IrqHandler)(void);//ⲿжϻص
+
+#define MPU6050_FIFO_SIZE           1024
+#define MPU6050_MAX_PACKET_LENGTH   32
+static uint8_t MPU6050_FifoPacketData[MPU6050_FIFO_BATCH][MPU6050_MAX_PACKET_LENGTH];
+static IIC_SegmentTypedef MPU6050_FifoSegments[MPU6050_FIFO_BATCH];//ÿݰһ
+static MPU6050_DmpSampleTypedef MPU6050_DmpSamples[MPU6050_FIFO_BATCH];//õݰ
+static uint8_t MPU6050_DmpSampleCount = 0;//ûбMPU6050_DrainDmpȡߵĸ
+static uint32_t MPU6050_DmpSequence = 0;//һݰ
+static MPU6050_DmpStatisticsTypedef MPU6050_DmpStatistics = {0};
+static long MPU6050_DmpQuat[4] = {1073741824L, 0, 0, 0};//µq30Ԫ, ȡʧʱֲ
+
+#ifdef MPU6050_USE_ASYNC_READ
+static uint8_t MPU6050_FifoCountData[2];
+static IIC_TransferTypedef MPU6050_FifoCountTransfer;
+static IIC_TransferTypedef MPU6050_FifoPacketTransfer;
+static __IO uint8_t MPU6050_IsReading = 0;//첽ȡ
+static uint8_t MPU6050_DmpCode = 1;//һ첽ȡĽ, ͬMPU6050_GetDmpData, MPU6050_GetFusionDataķֵ
+#endif
+
+static ATTITUDE_MahonyTypedef MPU6050_Fusion = ATTITUDE_MAHONY_INIT(ATTITUDE_MAHONY_KP, ATTITUDE_MAHONY_KI);
+static float MPU6050_FusionGyroScale;//ÿLSBӦrad/s
+static float MPU6050_FusionGyroBias[3];//Լõƫ(rad/s), оƬϵ
+static float MPU6050_FusionDt;//(s)
+static uint8_t MPU6050_FusionMode = 0;//MPU6050_InitWithFusionʼ, FIFOԭʼ
+#define MPU6050_RAW_PACKET_LENGTH   12//ԭʼһֽ, ٶǰ, ں
                                              
+/**
+ * @brief inv_mpuǷڹMPU6050, MPU6050_InitWithDmpMPU6050_InitWithFusionʼ
+ * @note inv_mpuüĴ̵, ʱֻܾinv_mpu޸
+ */
+static uint8_t MPU6050_IsInvManaged()
+{
+    unsigned char on;
+    mpu_get_power_state(&on);
+    return on;
+}
+
+/**
+ * @brief inv_mpuдüĴ, ֮inv_mpuĻ
+ */
+static uint8_t MPU6050_WriteConfig(uint8_t reg, uint8_t data)
+{
+    mpu_forget_config();
+    return IIC_WriteRegByte(MPU6050_ADDR, reg, data);
+}
+
 /**
  * @brief 
  * @param fsr MPU6050_FSR_XXXXDPS(MPU6050_GyroFsrTypedef)
@@ -120,7 +190,14 @@ void (* MPU6050_IrqHandler)(void);//
  */
 uint8_t MPU6050_SetGyroFsr(MPU6050_GyroFsrTypedef fsr)
 {
-    return IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_GYRO_CFG, fsr << 3);//̷Χ  
+    float sens;
+    if(!MPU6050_IsInvManaged())
+        return MPU6050_WriteConfig(MPU6050_REG_GYRO_CFG, fsr << 3);//̷Χ  
+    if(fsr > MPU6050_FSR_2000DPS || mpu_set_gyro_fsr(250 << fsr))
+        return 1;
+    if(MPU6050_FusionMode && !mpu_get_gyro_sens(&sens))
+        MPU6050_FusionGyroScale = ATTITUDE_DEG_TO_RAD / sens;
+    return 0;
 }
 /**
  * @brief üٶ
@@ -129,7 +206,11 @@ uint8_t MPU6050_SetGyroFsr(MPU6050_GyroFsrTypedef fsr)
  */
 uint8_t MPU6050_SetAccelFsr(MPU6050_AccelFsrTypedef fsr)
 {
-    return IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_ACCEL_CFG, fsr << 3);//üٶȴ̷Χ  
+    if(!MPU6050_IsInvManaged())
+        return MPU6050_WriteConfig(MPU6050_REG_ACCEL_CFG, fsr << 3);//üٶȴ̷Χ  
+    if(fsr > MPU6050_FSR_16G || mpu_set_accel_fsr(2 << fsr))
+        return 1;
+    return 0;
 }
 /**
  * @brief ò(ٶFs=1KHz)
@@ -142,7 +223,16 @@ uint8_t MPU6050_SetSampleRate(uint16_t rate)
     MPU6050_LpfTypedef data;
     if(rate > 1000 || rate < 4)
         return 1;
-    if(IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_SAMPLE_RATE, 1000 / rate - 1))    //ֵͨ˲
+    if(MPU6050_IsInvManaged())
+    {
+        //DMPʱinv_mpuʧ, ʼMPU6050_FIFO_RATE; LPFͬΪʵһ
+        if(mpu_set_sample_rate(rate))
+            return 1;
+        if(MPU6050_FusionMode && !mpu_get_sample_rate(&rate))
+            MPU6050_FusionDt = 1.0f / rate;//Ƶʵʲ
+        return 0;
+    }
+    if(MPU6050_WriteConfig(MPU6050_REG_SAMPLE_RATE, 1000 / rate - 1))    //ֵͨ˲
         return 1;
     if (lpf >= 188)
         data = MPU6050_FILTER_188HZ;
@@ -165,7 +255,12 @@ uint8_t MPU6050_SetSampleRate(uint16_t rate)
  */
 uint8_t MPU6050_SetLPF(MPU6050_LpfTypedef lpf)
 {
-    return IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_CFG, lpf);//ֵͨ˲  
+    static const uint8_t hz[] = {0, 188, 98, 42, 20, 10, 5, 0};
+    if(!MPU6050_IsInvManaged())
+        return MPU6050_WriteConfig(MPU6050_REG_CFG, lpf);//ֵͨ˲  
+    if(lpf >= sizeof(hz) || !hz[lpf] || mpu_set_lpf(hz[lpf]))
+        return 1;//inv_mpuֹ֧رLPF
+    return 0;
 }
 
 /**
@@ -177,19 +272,9 @@ uint8_t MPU6050_SetLPF(MPU6050_LpfTypedef lpf)
 uint8_t MPU6050_Init()
 { 
     IIC_Init();//ʼIIC
-    IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_PWR_MGMT1, 0X80);//λMPU6050
-    delay_ms(100);
-    IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_PWR_MGMT1, 0X00);//MPU6050 
-    MPU6050_SetGyroFsr(MPU6050_FSR_2000DPS);//ǡ2000dps
-    MPU6050_SetAccelFsr(MPU6050_FSR_2G);//ٶȴ2g
-    MPU6050_SetSampleRate(50);//ò50Hz
-    IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_INT_EN, 0X00);//رж
-    IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_USER_CTRL, 0X00);//I2Cģʽر
-    IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_FIFO_EN, 0X00);//رFIFO
-    IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_INTBP_CFG, 0X80);//INTŵ͵ƽЧ
-    IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_PWR_MGMT1, 0X01);//CLKSEL XPLLΪο
-    IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_PWR_MGMT2, 0X00);//ٶǶ
-
+    mpu_forget_config();//ʼλMPU6050, inv_mpu
+    if(IIC_RunInitTable(MPU6050_InitTable, sizeof(MPU6050_InitTable) / sizeof(MPU6050_InitTable[0])))
+        return 1;
     return IIC_ReadRegByte(MPU6050_ADDR, MPU6050_REG_DEVICE_ID) != MPU6050_ADDR;
 }
 
@@ -264,7 +349,7 @@ void MPU6050_BeginReceive()
     //NVIC
     NVIC_InitStructure.NVIC_IRQChannel = MPU6050_NVIC_IRQCHANNEL;
     NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
-    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 1;//ӲIICж, صܶдIIC
     NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
     NVIC_Init(&NVIC_InitStructure);
 }
@@ -406,42 +491,420 @@ uint8_t MPU6050_InitWithDmp(void (* irqHandler)(void))
 }
 
 /**
- * @brief õdmp
- * @param pitch , :0.1, Χ -90~90
- * @param pitch , :0.1, Χ -180~180
- * @param pitch , :0.1, Χ -180~180
- * @return 0-ɹ; -ʧ
+ * @brief FIFO, ݴλʱλFIFO
+ * @param count FIFOеֽ
+ * @param length ݰ
+ * @return Ҫݰ, 0ʾûݰѸλ
+ * @note λʱݰ, ܴſ
  */
-uint8_t MPU6050_GetDmpData(float *pitch, float *roll, float *yaw)
+static uint8_t MPU6050_CheckFifoCount(uint16_t count, uint8_t length)
 {
-	float q0 = 1.0f, q1 = 0.0f, q2 = 0.0f, q3 = 0.0f;
-	unsigned long sensor_timestamp;
-	int16_t gyro[3], accel[3], sensors;
-	uint8_t more;
-	long quat[4]; 
-	if(dmp_read_fifo(gyro, accel, quat, &sensor_timestamp, &sensors, &more))
-        return 1;	 
-	/* Gyro and accel data are written to the FIFO by the DMP in chip frame and hardware units.
-	 * This behavior is convenient because it keeps the gyro and accel outputs of dmp_read_fifo and mpu_read_fifo consistent.
-	**/
-	/*if (sensors & INV_XYZ_GYRO )
-	send_packet(PACKET_TYPE_GYRO, gyro);
-	if (sensors & INV_XYZ_ACCEL)
-	send_packet(PACKET_TYPE_ACCEL, accel); */
-	/* Unlike gyro and accel, quaternions are written to the FIFO in the body frame, q30.
+    uint16_t packets;
+    if(!length || length > MPU6050_MAX_PACKET_LENGTH)
+        return 0;
+    packets = count / length;
+    if(count >= MPU6050_FIFO_SIZE || count % length)
+    {
+        if(count >= MPU6050_FIFO_SIZE)
+            MPU6050_DmpStatistics.overflows++;
+        else
+            MPU6050_DmpStatistics.resyncs++;
+        MPU6050_DmpStatistics.dropped += packets;
+        MPU6050_DmpSequence += packets;
+        mpu_reset_fifo();
+        return 0;
+    }
+    return packets > MPU6050_FIFO_BATCH ? MPU6050_FIFO_BATCH : packets;
+}
+
+/**
+ * @brief ÿݰһ, һδMPU6050_FifoPacketDataĸ
+ */
+static void MPU6050_PrepareSegments(uint8_t packets, uint8_t length)
+{
+    uint8_t i;
+    for(i = 0; i < packets; i++)
+    {
+        MPU6050_FifoSegments[i].data = MPU6050_FifoPacketData[i];
+        MPU6050_FifoSegments[i].len = length;
+    }
+}
+
+/**
+ * @brief ݰ, ׷ӵMPU6050_DmpSamples
+ * @param packets ݰ
+ * @return 0-ɹ; 1-ݴλ, ѸλFIFO, ֮ǰõݰȻЧ
+ * @note ûбȡߵݰŲʱɵ
+ */
+static uint8_t MPU6050_DecodePackets(uint8_t packets)
+{
+    MPU6050_DmpSampleTypedef *sample;
+    uint8_t i;
+    if(MPU6050_DmpSampleCount + packets > MPU6050_FIFO_BATCH)
+    {
+        i = MPU6050_DmpSampleCount + packets - MPU6050_FIFO_BATCH;
+        memmove(MPU6050_DmpSamples, MPU6050_DmpSamples + i, (MPU6050_DmpSampleCount - i) * sizeof(MPU6050_DmpSamples[0]));
+        MPU6050_DmpSampleCount -= i;
+        MPU6050_DmpStatistics.evicted += i;
+    }
+    MPU6050_DmpStatistics.batches++;
+    if(packets > MPU6050_DmpStatistics.maxBatch)
+        MPU6050_DmpStatistics.maxBatch = packets;
+    for(i = 0; i < packets; i++)
+    {
+        sample = &MPU6050_DmpSamples[MPU6050_DmpSampleCount];
+        if(dmp_decode_fifo_packet(MPU6050_FifoPacketData[i], sample->gyro, sample->accel, sample->quat, &sample->sensors))
+        {
+            MPU6050_DmpStatistics.resyncs++;
+            MPU6050_DmpStatistics.dropped += packets - i;
+            MPU6050_DmpSequence += packets - i;
+            mpu_reset_fifo();
+            return 1;
+        }
+        sample->sequence = MPU6050_DmpSequence++;
+        MPU6050_DmpSampleCount++;
+        MPU6050_DmpStatistics.packets++;
+    }
+    return 0;
+}
+
+/**
+ * @brief µݰеԪ浽MPU6050_DmpQuat
+ * @return ͬMPU6050_GetDmpData
+ * @note ֻԪ, õʱŻΪŷ
+ */
+static uint8_t MPU6050_LatestQuat()
+{
+    const MPU6050_DmpSampleTypedef *sample;
+    if(!MPU6050_DmpSampleCount)
+        return 1;
+    sample = &MPU6050_DmpSamples[MPU6050_DmpSampleCount - 1];
+    if(!(sample->sensors & INV_WXYZ_QUAT))
+        return 2;
+    memcpy(MPU6050_DmpQuat, sample->quat, sizeof(MPU6050_DmpQuat));
+    return 0;
+}
+
+/**
+ * @brief MPU6050_GyroOrientationоƬϵתϵ
+ */
+static void MPU6050_Orient(const float *chip, float *body)
+{
+    const int8_t *row = MPU6050_GyroOrientation;
+    uint8_t i;
+    for(i = 0; i < 3; i++, row += 3)
+        body[i] = row[0] * chip[0] + row[1] * chip[1] + row[2] * chip[2];
+}
+
+/**
+ * @brief ԭʼMahony˲
+ * @param packets Ĳ
+ * @note ƫоƬϵмȥ, ת
+ */
+static void MPU6050_FusePackets(uint8_t packets)
+{
+    const uint8_t *data;
+    float gyro[3], accel[3], chip[3];
+    uint8_t i, j;
+    MPU6050_DmpStatistics.batches++;
+    if(packets > MPU6050_DmpStatistics.maxBatch)
+        MPU6050_DmpStatistics.maxBatch = packets;
+    for(i = 0; i < packets; i++)
+    {
+        data = MPU6050_FifoPacketData[i];
+        for(j = 0; j < 3; j++)
+            chip[j] = (int16_t)(((uint16_t)data[2 * j] << 8) | data[2 * j + 1]);
+        MPU6050_Orient(chip, accel);
+        for(j = 0; j < 3; j++)
+            chip[j] = (int16_t)(((uint16_t)data[6 + 2 * j] << 8) | data[7 + 2 * j]) * MPU6050_FusionGyroScale - MPU6050_FusionGyroBias[j];
+        MPU6050_Orient(chip, gyro);
+        ATTITUDE_MahonyUpdate(&MPU6050_Fusion, gyro, accel, MPU6050_FusionDt);
+        MPU6050_DmpStatistics.packets++;
+    }
+}
+
+#ifdef MPU6050_USE_ASYNC_READ
+/**
+ * @brief һ첽ȡ, ⲿжϻص
+ * @param code ͬMPU6050_GetDmpDataķֵ
+ */
+static void MPU6050_FinishRead(uint8_t code)
+{
+    MPU6050_DmpCode = code;
+    MPU6050_IrqHandler();
+    MPU6050_IsReading = 0;
+}
+
+/**
+ * @brief FIFOݰȡɵĻص, PendSVִ
+ * @param transfer 
+ * @note νݰ, ̬ȡµһ
+ */
+static void MPU6050_OnFifoPacket(IIC_TransferTypedef *transfer)
+{
+    if(transfer->status != IIC_STATUS_OK)
+    {
+        MPU6050_FinishRead(1);
+        return;
+    }
+    if(MPU6050_DecodePackets(transfer->segmentCount))
+    {
+        MPU6050_FinishRead(1);
+        return;
+    }
+    MPU6050_FinishRead(MPU6050_LatestQuat());
+}
+
+/**
+ * @brief ԭʼݶȡɵĻص, PendSVִ
+ * @param transfer 
+ */
+static void MPU6050_OnFusionPacket(IIC_TransferTypedef *transfer)
+{
+    if(transfer->status != IIC_STATUS_OK)
+    {
+        MPU6050_FinishRead(1);
+        return;
+    }
+    MPU6050_FusePackets(transfer->segmentCount);
+    MPU6050_FinishRead(0);
+}
+
+/**
+ * @brief FIFOȡɵĻص, PendSVִ
+ * @param transfer 
+ * @note DMPݰԭʼݹ, ֻаͶĴͬ
+ */
+static void MPU6050_OnFifoCount(IIC_TransferTypedef *transfer)
+{
+    uint8_t length, packets;
+    if(transfer->status != IIC_STATUS_OK)
+    {
+        MPU6050_FinishRead(1);
+        return;
+    }
+    if(MPU6050_FusionMode)
+        length = MPU6050_RAW_PACKET_LENGTH;
+    else
+        dmp_get_packet_length(&length);
+    packets = MPU6050_CheckFifoCount(((uint16_t)MPU6050_FifoCountData[0] << 8) | MPU6050_FifoCountData[1], length);
+    if(!packets)
+    {
+        MPU6050_FinishRead(1);//û, FIFO, ݴλѸλ
+        return;
+    }
+    //FIFOݰһδ, ÿŵĻ
+    MPU6050_PrepareSegments(packets, length);
+    MPU6050_FifoPacketTransfer.addr = MPU6050_ADDR;
+    MPU6050_FifoPacketTransfer.reg = MPU6050_REG_FIFO_RW;
+    MPU6050_FifoPacketTransfer.isRead = 1;
+    MPU6050_FifoPacketTransfer.len = (uint16_t)packets * length;
+    MPU6050_FifoPacketTransfer.data = MPU6050_FifoPacketData[0];
+    MPU6050_FifoPacketTransfer.segments = MPU6050_FifoSegments;
+    MPU6050_FifoPacketTransfer.segmentCount = packets;
+    MPU6050_FifoPacketTransfer.priority = IIC_PRIORITY_HIGH;
+    MPU6050_FifoPacketTransfer.callback = MPU6050_FusionMode ? MPU6050_OnFusionPacket : MPU6050_OnFifoPacket;
+    if(IIC_Submit(&MPU6050_FifoPacketTransfer))
+        MPU6050_FinishRead(1);
+}
+
+/**
+ * @brief ύFIFO, ⲿж
+ * @note һζȡûʱֱӷ, FIFO; DMPݰԭʼݶ
+ */
+static inline void MPU6050_RequestDmpData()
+{
+    if(MPU6050_IsReading)
+        return;
+    MPU6050_IsReading = 1;
+    MPU6050_FifoCountTransfer.addr = MPU6050_ADDR;
+    MPU6050_FifoCountTransfer.reg = MPU6050_REG_FIFO_CNTH;
+    MPU6050_FifoCountTransfer.isRead = 1;
+    MPU6050_FifoCountTransfer.len = 2;
+    MPU6050_FifoCountTransfer.data = MPU6050_FifoCountData;
+    MPU6050_FifoCountTransfer.priority = IIC_PRIORITY_HIGH;//OLEDȴǰ
+    MPU6050_FifoCountTransfer.callback = MPU6050_OnFifoCount;
+    if(IIC_Submit(&MPU6050_FifoCountTransfer))
+        MPU6050_IsReading = 0;
+}
+#else
+/**
+ * @brief FIFOеݰ, ÿMPU6050_FIFO_BATCH
+ * @return 0-ɹ; -ûݻFIFOѸλ
+ */
+static uint8_t MPU6050_ReadFifo()
+{
+    uint8_t data[2], length, packets;
+    if(IIC_ReadRegBytes(MPU6050_ADDR, MPU6050_REG_FIFO_CNTH, 2, data))
+        return 1;
+    dmp_get_packet_length(&length);
+    packets = MPU6050_CheckFifoCount(((uint16_t)data[0] << 8) | data[1], length);
+    if(!packets)
+        return 1;
+    MPU6050_PrepareSegments(packets, length);
+    if(IIC_ReadRegScatter(MPU6050_ADDR, MPU6050_REG_FIFO_RW, MPU6050_FifoSegments, packets))
+        return 1;
+    return MPU6050_DecodePackets(packets);
+}
+
+/**
+ * @brief FIFOеԭʼMahony˲, ÿMPU6050_FIFO_BATCH
+ * @return ͬMPU6050_GetFusionData
+ */
+static uint8_t MPU6050_ReadFusionFifo()
+{
+    uint8_t data[2], packets;
+    if(IIC_ReadRegBytes(MPU6050_ADDR, MPU6050_REG_FIFO_CNTH, 2, data))
+        return 1;
+    packets = MPU6050_CheckFifoCount(((uint16_t)data[0] << 8) | data[1], MPU6050_RAW_PACKET_LENGTH);
+    if(!packets)
+        return 1;
+    MPU6050_PrepareSegments(packets, MPU6050_RAW_PACKET_LENGTH);
+    if(IIC_ReadRegScatter(MPU6050_ADDR, MPU6050_REG_FIFO_RW, MPU6050_FifoSegments, packets))
+        return 1;
+    MPU6050_FusePackets(packets);
+    return 0;
+}
+
+#endif
+
+/**
+ * @brief MPU6050_DmpQuat
+ * @return ͬMPU6050_GetDmpData
+ * @note 첽ȡʱֻһζȡĽ, IIC;
+ *       FIFOеݰ, ȡµһ, FIFO;
+ *       ݰMPU6050_DmpSamples, MPU6050_DrainDmpȡ
+ */
+static uint8_t MPU6050_UpdateDmpQuat()
+{
+#ifdef MPU6050_USE_ASYNC_READ
+    return MPU6050_DmpCode;
+#else
+    uint32_t packets = MPU6050_DmpStatistics.packets;
+    MPU6050_ReadFifo();
+    if(MPU6050_DmpStatistics.packets == packets)
+        return 1;//ûнµݰ
+    /* Quaternions are written to the FIFO in the body frame, q30.
 	 * The orientation is set by the scalar passed to dmp_set_orientation during initialization. 
 	**/
-	if(!(sensors & INV_WXYZ_QUAT))
+    return MPU6050_LatestQuat();
+#endif
+}
+
+uint8_t MPU6050_GetDmpData(float *pitch, float *roll, float *yaw)
+{
+    uint8_t code = MPU6050_UpdateDmpQuat();
+    ATTITUDE_QuatToEuler(MPU6050_DmpQuat, pitch, roll, yaw);
+    return code;
+}
+
+uint8_t MPU6050_GetDmpYaw(float *yaw)
+{
+    uint8_t code = MPU6050_UpdateDmpQuat();
+    *yaw = ATTITUDE_QuatToYaw(MPU6050_DmpQuat);
+    return code;
+}
+
+uint8_t MPU6050_GetDmpQuaternion(float *quat)
+{
+    uint8_t code = MPU6050_UpdateDmpQuat();
+    ATTITUDE_QuatFromQ30(MPU6050_DmpQuat, quat);
+    return code;
+}
+
+uint8_t MPU6050_DrainDmp(MPU6050_DmpSampleTypedef *samples, uint8_t max, uint8_t *count)
+{
+    uint32_t primask;
+    uint8_t n;
+#ifndef MPU6050_USE_ASYNC_READ
+    MPU6050_ReadFifo();
+#endif
+    primask = __get_PRIMASK();
+    __disable_irq();//첽ȡʱPendSVеĻص׷ݰ
+    n = MPU6050_DmpSampleCount > max ? max : MPU6050_DmpSampleCount;
+    memcpy(samples, MPU6050_DmpSamples, n * sizeof(MPU6050_DmpSamples[0]));
+    MPU6050_DmpSampleCount -= n;
+    memmove(MPU6050_DmpSamples, MPU6050_DmpSamples + n, MPU6050_DmpSampleCount * sizeof(MPU6050_DmpSamples[0]));
+    __set_PRIMASK(primask);
+    *count = n;
+    return n ? 0 : 1;
+}
+
+void MPU6050_GetDmpStatistics(MPU6050_DmpStatisticsTypedef *statistics)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *statistics = MPU6050_DmpStatistics;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief DMPʱԼ, ƫ
+ * @return 0-ɹ; 1-ʧ
+ * @note ԼƫΪоƬϵq16ʽġ/s, ת֮ǰȥ
+ */
+static uint8_t MPU6050_RunFusionSelfTest()
+{
+    long gyro[3], accel[3];
+    uint8_t i;
+    if((mpu_run_self_test(gyro, accel) & 0x03) != 0x03)
+        return 1;
+    for(i = 0; i < 3; i++)
+        MPU6050_FusionGyroBias[i] = (float)gyro[i] * (ATTITUDE_DEG_TO_RAD / Q16);
+    return 0;
+}
+
+uint8_t MPU6050_InitWithFusion(void (* irqHandler)(void))
+{
+    float sens;
+    uint16_t rate;
+    IIC_Init();//ʼIIC
+    if(mpu_init())
+        return 1;
+    //ҪĴ
+    if(mpu_set_sensors(INV_XYZ_GYRO | INV_XYZ_ACCEL))
         return 2;
-    q0 = quat[0] / Q30;	//q30ʽתΪ
-    q1 = quat[1] / Q30;
-    q2 = quat[2] / Q30;
-    q3 = quat[3] / Q30; 
-    //õ//
-    *pitch = asin(2 * q0* q2 - 2 * q1 * q3) * 57.3;// pitch
-    *roll = atan2(2 * q2 * q3 + 2 * q0 * q1, 1 - 2 * q1 * q1 - 2 * q2* q2) * 57.3;// roll
-    *yaw = atan2(2 * q1 * q2 + 2 * q0 * q3, q0 * q0 + q1 * q1 - q2 * q2 - q3 * q3) * 57.3;//yaw
-	return 0;
+    if(mpu_set_gyro_fsr(2000) || mpu_set_accel_fsr(2))
+        return 3;
+    //, ͬʱѵͨ˲Ϊʵһ
+    if(mpu_set_sample_rate(MPU6050_FUSION_RATE))
+        return 4;
+    //ԭʼֵдFIFO, ݾж
+    if(mpu_configure_fifo(INV_XYZ_GYRO | INV_XYZ_ACCEL))
+        return 5;
+    //Լ
+    if(MPU6050_RunFusionSelfTest())
+        return 8;
+    //Ƶʵʲ
+    if(mpu_get_gyro_sens(&sens) || mpu_get_sample_rate(&rate))
+        return 9;
+    MPU6050_FusionGyroScale = ATTITUDE_DEG_TO_RAD / sens;
+    MPU6050_FusionDt = 1.0f / rate;
+    ATTITUDE_MahonyReset(&MPU6050_Fusion);
+    MPU6050_FusionMode = 1;
+    MPU6050_InitExti(irqHandler);
+    return 0;
+}
+
+uint8_t MPU6050_GetFusionData(float *pitch, float *roll, float *yaw)
+{
+    float q[4];
+#ifdef MPU6050_USE_ASYNC_READ
+    uint8_t code = MPU6050_DmpCode;
+#else
+    uint8_t code = MPU6050_ReadFusionFifo();
+#endif
+    MPU6050_GetFusionQuaternion(q);
+    ATTITUDE_QuatToEulerf(q, pitch, roll, yaw);
+    return code;
+}
+
+void MPU6050_GetFusionQuaternion(float *quat)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();//첽ȡʱPendSVеĻصԪ
+    memcpy(quat, MPU6050_Fusion.q, sizeof(MPU6050_Fusion.q));
+    __set_PRIMASK(primask);
 }
 
 /**
@@ -451,7 +914,11 @@ void MPU6050_EXTI_IRQHANDLER()
 {
     if(EXTI_GetITStatus(MPU6050_EXTI_LINE) != RESET)
     {
+#ifdef MPU6050_USE_ASYNC_READ
+        MPU6050_RequestDmpData();//ֻύ, صݶִ
+#else
         MPU6050_IrqHandler();
+#endif
         EXTI_ClearITPendingBit(MPU6050_EXTI_LINE);
     }
 }
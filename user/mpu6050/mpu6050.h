@@ -1,7 +1,7 @@
 /**
  * @file    mpu6050.c
  * @author  Miaow
- * @version 0.1.1
+ * @version 0.5.0
  * @date    2018/08/31
  * @brief   
  *          This file provides functions to manage the following 
@@ -9,7 +9,13 @@
  *              1. Initialization and setup
  *              2. Get raw data from gyroscope, accelerometer and thermometer
  *              3. DMP operations
+ *              4. Non-blocking DMP read with asynchronous IIC
+ *              5. Batched DMP FIFO drain with sequence numbers and overrun counters
+ *              6. Single precision attitude output as Euler angles, yaw or quaternion
+ *              7. Raw gyroscope and accelerometer FIFO at up to 1kHz fused on the MCU
  * @note
+ *          Minimum version of source file:
+ *              0.7.0
  *          Recommanded pin connection:
  *               
  *               PB8SCL  XDAX
@@ -53,6 +59,41 @@
 #define MPU6050_ADDR				0X68
 #define MPU6050_SAMPLE_RATE         200
 #define MPU6050_FIFO_RATE           200
+#define MPU6050_FUSION_RATE         1000//DMPʱĲ(4~1000Hz), MPU6050_InitWithFusion
+
+/**
+ * @brief ʹ첽IICȡDMP
+ * @note ⲿжֻύFIFO, ;
+ *       ݶPendSV, ٵMPU6050_InitWithDmpĻص,
+ *       ʱMPU6050_GetDmpDataֱӷظս̬
+ */
+#define MPU6050_USE_ASYNC_READ
+
+#define MPU6050_FIFO_BATCH          16//һδݰ
+
+/**
+ * @brief DMPһݰ
+ */
+typedef struct {
+    uint32_t sequence;//, ÿ1, FIFOλʱİҲ, ˵˰
+    int16_t sensors;//, INV_XYZ_GYRO, INV_XYZ_ACCEL, INV_WXYZ_QUAT
+    int16_t gyro[3];//ԭʼֵ
+    int16_t accel[3];//ٶԭʼֵ
+    long quat[4];//q30ʽԪ
+}MPU6050_DmpSampleTypedef;
+
+/**
+ * @brief DMP FIFOͳϢ,  @ref MPU6050_GetDmpStatistics
+ */
+typedef struct {
+    uint32_t batches;//ݰĴ
+    uint32_t packets;//ݰ
+    uint8_t maxBatch;//һδݰ
+    uint32_t overflows;//FIFOλĴ
+    uint32_t resyncs;//ݴλλFIFOĴ
+    uint32_t dropped;//λʱFIFOжݰ, ʱǵ
+    uint32_t evicted;//ûбMPU6050_DrainDmpȡ߾ͱݰĸ, ֻMPU6050_GetDmpDataʱһֱ
+}MPU6050_DmpStatisticsTypedef;
 
 typedef enum {
     MPU6050_FSR_250DPS = 0,
@@ -94,24 +135,28 @@ void MPU6050_BeginReceive(void);
  * @brief 
  * @param fsr MPU6050_FSR_XXXXDPS(MPU6050_GyroFsrTypedef)
  * @return 0-ɹ; 1-ʧ
+ * @note MPU6050_InitWithDmpMPU6050_InitWithFusionʼ󾭹inv_mpu, ñһ
  */
 uint8_t MPU6050_SetGyroFsr(MPU6050_GyroFsrTypedef fsr);
 /**
  * @brief üٶ
  * @param fsr MPU6050_FSR_XXXXG(MPU6050_AccelFsrTypedef)
  * @return 0-ɹ; 1-ʧ
+ * @note ͬMPU6050_SetGyroFsr
  */
 uint8_t MPU6050_SetAccelFsr(MPU6050_AccelFsrTypedef fsr);
 /**
  * @brief ò(ٶFs=1KHz)
  * @param rate 4~1000Hz
  * @return 0-ɹ; 1-ʧ
+ * @note ͬMPU6050_SetGyroFsr; DMPʱʧ, MPU6050_FIFO_RATE
  */
 uint8_t MPU6050_SetSampleRate(uint16_t rate);
 /**
  * @brief ֵͨ˲
  * @param lpf MPU6050_FILTER_XXXHZ(MPU6050_LpfTypedef)
  * @return 0-ɹ; 1-ʧ
+ * @note ͬMPU6050_SetGyroFsr; inv_mpuʱ֧MPU6050_FILTER_256HZ_NOLPF2MPU6050_FILTER_2100HZ_NOLPF
  */
 uint8_t MPU6050_SetLPF(MPU6050_LpfTypedef lpf);
 /**
@@ -146,7 +191,65 @@ uint8_t MPU6050_InitWithDmp(void (* irqHandler)(void));
  * @param pitch , :0.1, Χ -180~180
  * @param pitch , :0.1, Χ -180~180
  * @return 0-ɹ; -ʧ
+ * @note MPU6050_USE_ASYNC_READʱһ첽ȡĽ, IIC
+ *       ʧʱһγɹ̬; Ȼ, attitude.h
  */
 uint8_t MPU6050_GetDmpData(float *pitch, float *roll, float *yaw);
+/**
+ * @brief õdmpĺ, 㸩Ǻͺ
+ * @param yaw , Χ -180~180
+ * @return ͬMPU6050_GetDmpData
+ */
+uint8_t MPU6050_GetDmpYaw(float *yaw);
+/**
+ * @brief õdmpԪ, Ϊŷ
+ * @param quat , ˳Ϊw, x, y, z
+ * @return ͬMPU6050_GetDmpData
+ */
+uint8_t MPU6050_GetDmpQuaternion(float *quat);
+/**
+ * @brief ȡFIFOеݰ
+ * @param samples , ŴС
+ * @param max samplesĴС
+ * @param count ȡĸ
+ * @return 0-ȡһ; 1-ûݻ
+ * @note һFIFO, Ȼһδݰ, MPU6050_FIFO_BATCH, ´
+ *       MPU6050_USE_ASYNC_READʱ첽ȡõݰ, IIC, ⲿжϻص
+ *       MPU6050_GetDmpDataֻȡµԪ, ȡݰ, ߿һ
+ */
+uint8_t MPU6050_DrainDmp(MPU6050_DmpSampleTypedef *samples, uint8_t max, uint8_t *count);
+/**
+ * @brief ȡDMP FIFOͳϢ
+ * @param statistics 
+ */
+void MPU6050_GetDmpStatistics(MPU6050_DmpStatisticsTypedef *statistics);
+/**
+ * @brief ʼ, DMP̼, ǺͼٶȼƵԭʼֵMPU6050_FUSION_RATEдFIFO
+ * @param irqHandler ⲿжϻص, ÿһ, еMPU6050_GetFusionData
+ * @return 0-ɹ; -ʧ
+ * @note ǡ2000dps, ٶȡ2g, ͨ˲Ϊʵһ;
+ *       Լõƫںǰȥ;
+ *       MPU6050_USE_ASYNC_READʱDMPͬ, ⲿжֻύFIFO,
+ *       PendSV˲, ٵirqHandler
+ */
+uint8_t MPU6050_InitWithFusion(void (* irqHandler)(void));
+/**
+ * @brief FIFOеԭʼ, Mahony˲, õ̬
+ * @param pitch , Χ -90~90
+ * @param roll , Χ -180~180
+ * @param yaw , Χ -180~180
+ * @return 0-ɹ; 1-û, ȡʧܻFIFOѸλ
+ * @note ֻMPU6050_InitWithFusion֮ʹ; һMPU6050_FIFO_BATCH;
+ *       MPU6050_USE_ASYNC_READʱһ첽ȡĽ, IIC
+ *       ʧʱһε̬, ĲᲹ, MPU6050_GetDmpStatistics;
+ *       ֻǻ, ỺƯ
+ */
+uint8_t MPU6050_GetFusionData(float *pitch, float *roll, float *yaw);
+/**
+ * @brief ȡںϺԪ
+ * @param quat , ˳Ϊw, x, y, z
+ * @note FIFO, һMPU6050_GetFusionDataĽ
+ */
+void MPU6050_GetFusionQuaternion(float *quat);
 
 #endif
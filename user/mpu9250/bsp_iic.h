@@ -1,70 +0,0 @@
-#ifndef __BSP_IIC_H
-#define __BSP_IIC_H
-#include "sys.h" 
-#include "delay.h"
-
-//GPIO
-#define IIC_SCL_PORT        GPIOE
-#define IIC_SCL_PIN         GPIO_Pin_2
-#define IIC_SCL_GPIO_CLK    RCC_AHB1Periph_GPIOE
-#define IIC_SDA_PORT        GPIOE
-#define IIC_SDA_PIN         GPIO_Pin_3
-#define IIC_SDA_GPIO_CLK    RCC_AHB1Periph_GPIOE
-#define IIC_In()            IIC_SDA_PORT->MODER &= ~0x000000C0;IIC_SDA_PORT->MODER |= 0x00000000//ģʽ
-#define IIC_Out()           IIC_SDA_PORT->MODER &= ~0x000000C0;IIC_SDA_PORT->MODER |= 0x00000040//ģʽ
-
- /**
- * @brief ʼIIC
- */
-void IIC_Init(void);
-/**
- * @brief IICһֽ
- * @return 1-Ack; 0-Ack
- */      
-void IIC_WriteByte(uint8_t data);
-/**
- * @brief 1ֽ
- * @param ack
- *          1-Ӧ
- *          0-ͷӦ
- * @return ضȡһֽ
- */ 
-uint8_t IIC_ReadByte(uint8_t ack);
-/**
- * @brief IICд1ֽڵĴ
- * @param addr ַ
- * @param reg Ĵַ
- * @param data Ҫд
- * @return 0-; 1-
- */
-uint8_t IIC_WriteRegByte(uint8_t addr, uint8_t reg, uint8_t data);
-/**
- * @brief IIC1ֽڵĴ
- * @param addr ַ
- * @param reg Ĵַ
- * @return Ҫȡ
- */
-uint8_t IIC_ReadRegByte(uint8_t addr, uint8_t reg);
-/**
- * @brief IICд
- * @param addr ַ
- * @param reg Ĵַ
- * @param len дֽ
- * @param data Ҫд
- * @return 0-; 1-
- */
-uint8_t IIC_WriteRegBytes(uint8_t addr, uint8_t reg, uint8_t len, uint8_t *data);
-/**
- * @brief IIC
- * @param addr ַ
- * @param reg Ĵַ
- * @param len ȡֽ
- * @param data Ҫȡ
- * @return 0-; 1-
- */
-uint8_t IIC_ReadRegBytes(uint8_t addr, uint8_t reg, uint8_t len, uint8_t *data);
-
-
-
-
-#endif
@@ -1,7 +1,7 @@
 /**
  * @file    mpu9250.c
  * @author  Miaow
- * @version 0.1.1
+ * @version 0.4.0
  * @date    2018/09/08
  * @brief   
  *          This file provides functions to manage the following 
@@ -9,9 +9,12 @@
  *              1. Initialization and setup
  *              2. Get raw data from gyroscope, accelerometer, magnetometer and thermometer
  *              3. DMP operations
+ *              4. Non-blocking DMP read with asynchronous IIC
+ *              5. Batched DMP FIFO drain with sequence numbers and overrun counters
+ *              6. Single precision attitude output as Euler angles, yaw or quaternion
  * @note
  *          Minimum version of header file:
- *              0.1.1
+ *              0.4.0
  *          Recommanded pin connection:
  *               
  *               PB8SCL  XDAX
@@ -32,8 +35,10 @@
 #include "mpu9250.h"
 #include "inv_mpu.h"
 #include "inv_mpu_dmp_motion_driver.h" 
+#include "attitude.h"
 #include "math.h"
 #include "stdio.h"
+#include "string.h"
 /**
  * @brief Ĵ
  */
@@ -147,6 +152,23 @@
 //q16ʽ
 #define Q16  65536.0f
 
+#define MPU9250_FIFO_SIZE           512
+#define MPU9250_MAX_PACKET_LENGTH   32
+static uint8_t MPU9250_FifoPacketData[MPU9250_FIFO_BATCH][MPU9250_MAX_PACKET_LENGTH];
+static IIC_SegmentTypedef MPU9250_FifoSegments[MPU9250_FIFO_BATCH];//ÿݰһ
+static MPU9250_DmpSampleTypedef MPU9250_DmpSamples[MPU9250_FIFO_BATCH];//õݰ
+static uint8_t MPU9250_DmpSampleCount = 0;//ûбȡߵĸ
+static uint32_t MPU9250_DmpSequence = 0;//һݰ
+static MPU9250_DmpStatisticsTypedef MPU9250_DmpStatistics = {0};
+static long MPU9250_DmpQuat[4] = {1073741824L, 0, 0, 0};//µq30Ԫ, ȡʧʱֲ
+#ifdef MPU9250_USE_ASYNC_READ
+static uint8_t MPU9250_FifoCountData[2];
+static IIC_TransferTypedef MPU9250_FifoCountTransfer;
+static IIC_TransferTypedef MPU9250_FifoPacketTransfer;
+static __IO uint8_t MPU9250_IsReading = 0;//첽ȡ
+static int8_t MPU9250_DmpCode = 1;//һ첽ȡĽ, ͬMPU9250_GetDmpDataķֵ
+#endif
+
 /**
  * @brief Ƿ
  */
@@ -263,7 +285,7 @@ static inline void MPU9250_InitExti(void (* irqHandler)(void))
     //NVIC
     NVIC_InitStructure.NVIC_IRQChannel = MPU9250_NVIC_IRQCHANNEL;
     NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
-    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 1;//ӲIICж, صܶдIIC
     NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
     NVIC_Init(&NVIC_InitStructure);
     //IRQ
@@ -445,7 +467,6 @@ int8_t MPU9250_InitWithDmp(void (* irqHandler)(void))
 {
 	IIC_Init();//ʼIIC
     
-    MPU9250_InitExti(irqHandler);
 	if(!mpu_init())//ʼMPU9250
 	{
         //ҪĴ
@@ -473,46 +494,273 @@ int8_t MPU9250_InitWithDmp(void (* irqHandler)(void))
 		if(mpu_set_dmp_state(1))
             return 9;
 	}
+    MPU9250_InitExti(irqHandler);//DMPٿж, ʼڼд첽ȡ
 	return 0;
 }
 
 /**
- * @brief õdmp
- * @param pitch , :0.1, Χ -90~90
- * @param pitch , :0.1, Χ -180~180
- * @param pitch , :0.1, Χ -180~180
- * @return 0-ɹ; -ʧ
+ * @brief FIFO, ݴλʱλFIFO
+ * @param count FIFOеֽ
+ * @param length ݰ
+ * @return Ҫݰ, 0ʾûݰѸλ
+ * @note λʱݰ, ܴſ
  */
-int8_t MPU9250_GetDmpData(float *pitch, float *roll, float *yaw)
+static uint8_t MPU9250_CheckFifoCount(uint16_t count, uint8_t length)
+{
+    uint16_t packets;
+    if(!length || length > MPU9250_MAX_PACKET_LENGTH)
+        return 0;
+    packets = count / length;
+    if(count >= MPU9250_FIFO_SIZE || count % length)
+    {
+        if(count >= MPU9250_FIFO_SIZE)
+            MPU9250_DmpStatistics.overflows++;
+        else
+            MPU9250_DmpStatistics.resyncs++;
+        MPU9250_DmpStatistics.dropped += packets;
+        MPU9250_DmpSequence += packets;
+        mpu_reset_fifo();
+        return 0;
+    }
+    return packets > MPU9250_FIFO_BATCH ? MPU9250_FIFO_BATCH : packets;
+}
+
+/**
+ * @brief ÿݰһ, һδMPU9250_FifoPacketDataĸ
+ */
+static void MPU9250_PrepareSegments(uint8_t packets, uint8_t length)
+{
+    uint8_t i;
+    for(i = 0; i < packets; i++)
+    {
+        MPU9250_FifoSegments[i].data = MPU9250_FifoPacketData[i];
+        MPU9250_FifoSegments[i].len = length;
+    }
+}
+
+/**
+ * @brief ݰ, ׷ӵMPU9250_DmpSamples
+ * @param packets ݰ
+ * @return 0-ɹ; 1-ݴλ, ѸλFIFO, ֮ǰõݰȻЧ
+ * @note ûбȡߵݰŲʱɵ
+ */
+static int8_t MPU9250_DecodePackets(uint8_t packets)
+{
+    MPU9250_DmpSampleTypedef *sample;
+    uint8_t i;
+    if(MPU9250_DmpSampleCount + packets > MPU9250_FIFO_BATCH)
+    {
+        i = MPU9250_DmpSampleCount + packets - MPU9250_FIFO_BATCH;
+        memmove(MPU9250_DmpSamples, MPU9250_DmpSamples + i, (MPU9250_DmpSampleCount - i) * sizeof(MPU9250_DmpSamples[0]));
+        MPU9250_DmpSampleCount -= i;
+        MPU9250_DmpStatistics.evicted += i;
+    }
+    MPU9250_DmpStatistics.batches++;
+    if(packets > MPU9250_DmpStatistics.maxBatch)
+        MPU9250_DmpStatistics.maxBatch = packets;
+    for(i = 0; i < packets; i++)
+    {
+        sample = &MPU9250_DmpSamples[MPU9250_DmpSampleCount];
+        if(dmp_decode_fifo_packet(MPU9250_FifoPacketData[i], sample->gyro, sample->accel, sample->quat, &sample->sensors))
+        {
+            MPU9250_DmpStatistics.resyncs++;//ݴλ
+            MPU9250_DmpStatistics.dropped += packets - i;
+            MPU9250_DmpSequence += packets - i;
+            mpu_reset_fifo();
+            return 1;
+        }
+        sample->sequence = MPU9250_DmpSequence++;
+        MPU9250_DmpSampleCount++;
+        MPU9250_DmpStatistics.packets++;
+    }
+    return 0;
+}
+
+/**
+ * @brief µݰеԪ浽MPU9250_DmpQuat
+ * @return ͬMPU9250_GetDmpData
+ */
+static int8_t MPU9250_LatestQuat()
 {
-	float q0 = 1.0f, q1 = 0.0f, q2 = 0.0f, q3 = 0.0f;
-	unsigned long sensor_timestamp;
-	int16_t gyro[3], accel[3], sensors;
-	uint8_t more;
-	long quat[4]; 
-	if(dmp_read_fifo(gyro, accel, quat, &sensor_timestamp, &sensors, &more))
+    const MPU9250_DmpSampleTypedef *sample;
+    if(!MPU9250_DmpSampleCount)
         return 1;
-	/* Gyro and accel data are written to the FIFO by the DMP in chip frame and hardware units.
-	 * This behavior is convenient because it keeps the gyro and accel outputs of dmp_read_fifo and mpu_read_fifo consistent.
-	**/
-	/*if (sensors & INV_XYZ_GYRO )
-	send_packet(PACKET_TYPE_GYRO, gyro);
-	if (sensors & INV_XYZ_ACCEL)
-	send_packet(PACKET_TYPE_ACCEL, accel); */
-	/* Unlike gyro and accel, quaternions are written to the FIFO in the body frame, q30.
-	 * The orientation is set by the scalar passed to dmp_set_orientation during initialization. 
-	**/
-	if(!(sensors & INV_WXYZ_QUAT))
+    sample = &MPU9250_DmpSamples[MPU9250_DmpSampleCount - 1];
+    /* Unlike gyro and accel, quaternions are written to the FIFO in the body frame, q30.
+     * The orientation is set by the scalar passed to dmp_set_orientation during initialization. 
+    **/
+    if(!(sample->sensors & INV_WXYZ_QUAT))
         return 2;
-    q0 = quat[0] / Q30;	//q30ʽתΪ
-    q1 = quat[1] / Q30;
-    q2 = quat[2] / Q30;
-    q3 = quat[3] / Q30; 
-    //õ//
-    *pitch = asin(2 * q0 * q2 - 2 * q1 * q3) * 57.3;// pitch
-    *roll = atan2(2 * q2 * q3 + 2 * q0 * q1, 1 - 2 * q1 * q1 - 2 * q2* q2) * 57.3;// roll
-    *yaw = atan2(2 * q1 * q2 + 2 * q0 * q3, q0 * q0 + q1 * q1 - q2 * q2 - q3 * q3) * 57.3;//yaw
-	return 0;
+    memcpy(MPU9250_DmpQuat, sample->quat, sizeof(MPU9250_DmpQuat));
+    return 0;
+}
+
+#ifdef MPU9250_USE_ASYNC_READ
+/**
+ * @brief һ첽ȡ, ⲿжϻص
+ * @param code ͬMPU9250_GetDmpDataķֵ
+ */
+static void MPU9250_FinishRead(int8_t code)
+{
+    MPU9250_DmpCode = code;
+    MPU9250_IrqHandler();
+    MPU9250_IsReading = 0;
+}
+
+/**
+ * @brief FIFOݰȡɵĻص, PendSVִ
+ * @param transfer 
+ * @note νݰ, ̬ȡµһ
+ */
+static void MPU9250_OnFifoPacket(IIC_TransferTypedef *transfer)
+{
+    if(transfer->status != IIC_STATUS_OK || MPU9250_DecodePackets(transfer->segmentCount))
+    {
+        MPU9250_FinishRead(1);
+        return;
+    }
+    MPU9250_FinishRead(MPU9250_LatestQuat());
+}
+
+/**
+ * @brief FIFOȡɵĻص, PendSVִ
+ * @param transfer 
+ */
+static void MPU9250_OnFifoCount(IIC_TransferTypedef *transfer)
+{
+    uint8_t length, packets;
+    if(transfer->status != IIC_STATUS_OK)
+    {
+        MPU9250_FinishRead(1);
+        return;
+    }
+    dmp_get_packet_length(&length);
+    packets = MPU9250_CheckFifoCount(((uint16_t)MPU9250_FifoCountData[0] << 8) | MPU9250_FifoCountData[1], length);
+    if(!packets)
+    {
+        MPU9250_FinishRead(1);//û, FIFO, ݴλѸλ
+        return;
+    }
+    //FIFOݰһδ, ÿŵĻ
+    MPU9250_PrepareSegments(packets, length);
+    MPU9250_FifoPacketTransfer.addr = MPU9250_ADDR;
+    MPU9250_FifoPacketTransfer.reg = MPU9250_REG_FIFO_RW;
+    MPU9250_FifoPacketTransfer.isRead = 1;
+    MPU9250_FifoPacketTransfer.len = (uint16_t)packets * length;
+    MPU9250_FifoPacketTransfer.data = MPU9250_FifoPacketData[0];
+    MPU9250_FifoPacketTransfer.segments = MPU9250_FifoSegments;
+    MPU9250_FifoPacketTransfer.segmentCount = packets;
+    MPU9250_FifoPacketTransfer.priority = IIC_PRIORITY_HIGH;
+    MPU9250_FifoPacketTransfer.callback = MPU9250_OnFifoPacket;
+    if(IIC_Submit(&MPU9250_FifoPacketTransfer))
+        MPU9250_FinishRead(1);
+}
+
+/**
+ * @brief ύFIFO, ⲿж
+ * @note һζȡûʱֱӷ, FIFO
+ */
+static inline void MPU9250_RequestDmpData()
+{
+    if(MPU9250_IsReading)
+        return;
+    MPU9250_IsReading = 1;
+    MPU9250_FifoCountTransfer.addr = MPU9250_ADDR;
+    MPU9250_FifoCountTransfer.reg = MPU9250_REG_FIFO_CNTH;
+    MPU9250_FifoCountTransfer.isRead = 1;
+    MPU9250_FifoCountTransfer.len = 2;
+    MPU9250_FifoCountTransfer.data = MPU9250_FifoCountData;
+    MPU9250_FifoCountTransfer.priority = IIC_PRIORITY_HIGH;
+    MPU9250_FifoCountTransfer.callback = MPU9250_OnFifoCount;
+    if(IIC_Submit(&MPU9250_FifoCountTransfer))
+        MPU9250_IsReading = 0;
+}
+#else
+/**
+ * @brief FIFOеݰ, ÿMPU9250_FIFO_BATCH
+ * @return 0-ɹ; -ûݻFIFOѸλ
+ */
+static int8_t MPU9250_ReadFifo()
+{
+    uint8_t data[2], length, packets;
+    if(IIC_ReadRegBytes(MPU9250_ADDR, MPU9250_REG_FIFO_CNTH, 2, data))
+        return 1;
+    dmp_get_packet_length(&length);
+    packets = MPU9250_CheckFifoCount(((uint16_t)data[0] << 8) | data[1], length);
+    if(!packets)
+        return 1;
+    MPU9250_PrepareSegments(packets, length);
+    if(IIC_ReadRegScatter(MPU9250_ADDR, MPU9250_REG_FIFO_RW, MPU9250_FifoSegments, packets))
+        return 1;
+    return MPU9250_DecodePackets(packets);
+}
+#endif
+
+/**
+ * @brief MPU9250_DmpQuat
+ * @return ͬMPU9250_GetDmpData
+ * @note 첽ȡʱֻһζȡĽ, IIC;
+ *       FIFOеݰ, ȡµһ;
+ *       ݰMPU9250_DmpSamples, MPU9250_DrainDmpȡ
+ */
+static int8_t MPU9250_UpdateDmpQuat()
+{
+#ifdef MPU9250_USE_ASYNC_READ
+    return MPU9250_DmpCode;
+#else
+    uint32_t packets = MPU9250_DmpStatistics.packets;
+    MPU9250_ReadFifo();
+    if(MPU9250_DmpStatistics.packets == packets)
+        return 1;//ûнµݰ
+    return MPU9250_LatestQuat();
+#endif
+}
+
+int8_t MPU9250_GetDmpData(float *pitch, float *roll, float *yaw)
+{
+    int8_t code = MPU9250_UpdateDmpQuat();
+    ATTITUDE_QuatToEuler(MPU9250_DmpQuat, pitch, roll, yaw);
+    return code;
+}
+
+int8_t MPU9250_GetDmpYaw(float *yaw)
+{
+    int8_t code = MPU9250_UpdateDmpQuat();
+    *yaw = ATTITUDE_QuatToYaw(MPU9250_DmpQuat);
+    return code;
+}
+
+int8_t MPU9250_GetDmpQuaternion(float *quat)
+{
+    int8_t code = MPU9250_UpdateDmpQuat();
+    ATTITUDE_QuatFromQ30(MPU9250_DmpQuat, quat);
+    return code;
+}
+
+int8_t MPU9250_DrainDmp(MPU9250_DmpSampleTypedef *samples, uint8_t max, uint8_t *count)
+{
+    uint32_t primask;
+    uint8_t n;
+#ifndef MPU9250_USE_ASYNC_READ
+    MPU9250_ReadFifo();
+#endif
+    primask = __get_PRIMASK();
+    __disable_irq();//첽ȡʱPendSVеĻص׷ݰ
+    n = MPU9250_DmpSampleCount > max ? max : MPU9250_DmpSampleCount;
+    memcpy(samples, MPU9250_DmpSamples, n * sizeof(MPU9250_DmpSamples[0]));
+    MPU9250_DmpSampleCount -= n;
+    memmove(MPU9250_DmpSamples, MPU9250_DmpSamples + n, MPU9250_DmpSampleCount * sizeof(MPU9250_DmpSamples[0]));
+    __set_PRIMASK(primask);
+    *count = n;
+    return n ? 0 : 1;
+}
+
+void MPU9250_GetDmpStatistics(MPU9250_DmpStatisticsTypedef *statistics)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *statistics = MPU9250_DmpStatistics;
+    __set_PRIMASK(primask);
 }
 
 /**
@@ -522,7 +770,11 @@ void MPU9250_EXTI_IRQHANDLER()
 {
     if(EXTI_GetITStatus(MPU9250_EXTI_LINE) != RESET)
     {
+#ifdef MPU9250_USE_ASYNC_READ
+        MPU9250_RequestDmpData();//ֻύ, صݶִ
+#else
         MPU9250_IrqHandler();
+#endif
         EXTI_ClearITPendingBit(MPU9250_EXTI_LINE);
     }
 }
@@ -1,7 +1,7 @@
 /**
  * @file    mpu9250.h
  * @author  Miaow
- * @version 0.1.1
+ * @version 0.4.0
  * @date    2018/09/08
  * @brief   
  *          This file provides functions to manage the following 
@@ -9,7 +9,12 @@
  *              1. Initialization and setup
  *              2. Get raw data from gyroscope, accelerometer, magnetometer and thermometer
  *              3. DMP operations
+ *              4. Non-blocking DMP read with asynchronous IIC
+ *              5. Batched DMP FIFO drain with sequence numbers and overrun counters
+ *              6. Single precision attitude output as Euler angles, yaw or quaternion
  * @note
+ *          Minimum version of source file:
+ *              0.4.0
  *          Recommanded pin connection:
  *               
  *               PB8SCL  XDAX
@@ -53,6 +58,40 @@
 #define MPU9250_ADDR				0X68
 #define MPU9250_SAMPLE_RATE         200
 #define MPU9250_FIFO_RATE           200
+#define MPU9250_FIFO_BATCH          16//һδݰ
+
+/**
+ * @brief ʹ첽IICȡDMP
+ * @note ⲿжֻύFIFO, ݶPendSV,
+ *       ٵMPU9250_InitWithDmpĻص;
+ *       ע͵ʱصֱⲿжִ, MPU9250_GetDmpDataȡ
+ */
+#define MPU9250_USE_ASYNC_READ
+
+/**
+ * @brief DMPһݰ
+ */
+typedef struct {
+    uint32_t sequence;//, ÿ1, FIFOλʱİҲ, ˵˰
+    int16_t sensors;//, INV_XYZ_GYRO, INV_XYZ_ACCEL, INV_WXYZ_QUAT
+    int16_t gyro[3];//ԭʼֵ
+    int16_t accel[3];//ٶԭʼֵ
+    long quat[4];//q30ʽԪ
+}MPU9250_DmpSampleTypedef;
+
+/**
+ * @brief DMP FIFOͳϢ,  @ref MPU9250_GetDmpStatistics
+ */
+typedef struct {
+    uint32_t batches;//ݰĴ
+    uint32_t packets;//ݰ
+    uint8_t maxBatch;//һδݰ
+    uint32_t overflows;//FIFOλĴ
+    uint32_t resyncs;//ݴλλFIFOĴ
+    uint32_t dropped;//λʱFIFOжݰ, ʱǵ
+    uint32_t evicted;//ûбMPU9250_DrainDmpȡ߾ͱݰĸ, ֻMPU9250_GetDmpDataʱһֱ
+}MPU9250_DmpStatisticsTypedef;
+
 typedef enum {
     MPU9250_FSR_250DPS = 0,
     MPU9250_FSR_500DPS,
@@ -141,6 +180,8 @@ int8_t MPU9250_GetAccelerometer(int16_t *ax, int16_t *ay, int16_t *az);
  * @brief dmpһʼ
  * @param irqHandler ⲿжϻص
  * @return 0-ɹ; -ʧ
+ * @note ⲿжϵռȼΪ1, ӲIICж;
+ *       MPU9250_USE_ASYNC_READʱirqHandlerдIIC_SubmitύĴͬʱʹ
  */
 int8_t MPU9250_InitWithDmp(void (* irqHandler)(void));
 /**
@@ -149,8 +190,39 @@ int8_t MPU9250_InitWithDmp(void (* irqHandler)(void));
  * @param pitch , :0.1, Χ -180~180
  * @param pitch , :0.1, Χ -180~180
  * @return 0-ɹ; -ʧ
+ * @note FIFOеݰ, ̬ȡµһ
+ *       MPU9250_USE_ASYNC_READʱһ첽ȡĽ, IIC
+ *       ʧʱһγɹ̬; Ȼ, attitude.h
  */
 int8_t MPU9250_GetDmpData(float *pitch, float *roll, float *yaw);
+/**
+ * @brief õdmpĺ, 㸩Ǻͺ
+ * @param yaw , Χ -180~180
+ * @return ͬMPU9250_GetDmpData
+ */
+int8_t MPU9250_GetDmpYaw(float *yaw);
+/**
+ * @brief õdmpԪ, Ϊŷ
+ * @param quat , ˳Ϊw, x, y, z
+ * @return ͬMPU9250_GetDmpData
+ */
+int8_t MPU9250_GetDmpQuaternion(float *quat);
+/**
+ * @brief ȡFIFOеݰ
+ * @param samples , ŴС
+ * @param max samplesĴС
+ * @param count ȡĸ
+ * @return 0-ȡһ; 1-ûݻ
+ * @note һFIFO, Ȼһδݰ, MPU9250_FIFO_BATCH, ´
+ *       MPU9250_USE_ASYNC_READʱ첽ȡõݰ, IIC, ⲿжϻص
+ *       MPU9250_GetDmpDataֻȡµԪ, ȡݰ, ߿һ
+ */
+int8_t MPU9250_DrainDmp(MPU9250_DmpSampleTypedef *samples, uint8_t max, uint8_t *count);
+/**
+ * @brief ȡDMP FIFOͳϢ
+ * @param statistics 
+ */
+void MPU9250_GetDmpStatistics(MPU9250_DmpStatisticsTypedef *statistics);
 
 
 int8_t MPU9250_GetEulerFromCompass(float *yaw);
@@ -1,7 +1,7 @@
 /**
  * @file    oled.c
  * @author  Miaow, Evk123
- * @version 0.1.0
+ * @version 0.15.0
  * @date    2018/10/05
  * @brief   
  *          This file provides functions to manage the following 
@@ -10,9 +10,25 @@
  *              2. Display formatted strings, pictures and Chinese characters
  *              3. Turn on/off the screen
  *              4. Show logs
+ *              5. Framebuffer with dirty region flush
+ *              6. Timer paced background refresh
+ *              7. Formatted text without vsprintf
+ *              8. Log entries posted from interrupts
+ *              9. Single character cells and pixel columns for widgets
+ *              10. Pixel addressed glyph blitter for any font
+ *              11. Page rows for streamed pictures
+ *              12. 4-wire SPI transport with DMA
  * @note
  *          Minimum version of header file:
- *              0.1.0
+ *              0.12.0
+ *          Drawing only changes gRam and marks the changed columns of each
+ *          page. OLED_Flush sends them in horizontal addressing mode: one
+ *          0x21/0x22 window command and one data stream per run of pages.
+ *          With OLED_USE_BACKGROUND_REFRESH the same windows are copied to a
+ *          front buffer by OLED_REFRESH_TIM and sent as a chain of low priority
+ *          asynchronous transfers, each started from the previous callback.
+ *          Text lines are mapped onto the pages as a ring starting at ringTop,
+ *          so scrolling the log only moves the display start line (0x40|line).
  *          Recommanded pin connection:
  *               
  *               PB8SCL     
@@ -31,9 +47,16 @@
 
 #include "oled.h"
 #include "oled_font.h"       
+#include "oled_bmp.h"
+#include "oled_asset.h"
 #include "delay.h"
-#include "stdio.h"
+#include "oled_format.h"
+#include "oled_queue.h"
 #include "stdarg.h"
+#include "string.h"
+#ifdef OLED_USE_BENCHMARK
+#include "cyclecounter.h"
+#endif
 
 #define OLED_WIDTH                  128
 #define OLED_HEIGHT                 64
@@ -43,15 +66,124 @@
 #define OLED_LINES                  8
 #define OLED_CHARACTERS_ONE_LINE    21
 
+/**
+ * @brief 
+ */
+const OLED_FontTypedef OLED_Font6x8 = {6, 8, ' ', sizeof(F6x8) / sizeof(F6x8[0]), (const uint8_t *)F6x8};
+const OLED_FontTypedef OLED_Font8x16 = {8, 16, ' ', sizeof(F8X16) / 16, (const uint8_t *)F8X16};
+const OLED_CompressedFontTypedef OLED_FontHzk = {16, 16, sizeof(HzkOffsets) / sizeof(HzkOffsets[0]) - 1, HzkOffsets, Hzk};
+const OLED_AssetTypedef OLED_PictureBmp1 = {128, 8, sizeof(BMP1), BMP1};
+
 /**
  * @brief Ʊλòѯ
  */
 static const uint8_t tabLookUpTable[OLED_CHARACTERS_ONE_LINE + 1] = {4,4,4,4,8,8,8,8,12,12,12,12,16,16,16,16,20,20,20,20,24,24};
 static __IO uint8_t gRam[OLED_PAGES][OLED_WIDTH] = {0};
+/**
+ * @brief ÿҳԴĻһµзΧ[dirtyBegin, dirtyEnd), dirtyEndΪ0ʾҳûиĶ
+ */
+static uint8_t dirtyBegin[OLED_PAGES] = {0};
+static uint8_t dirtyEnd[OLED_PAGES] = {0};
+static __IO uint8_t oledDrawing = 0;//ִеĻƺ
+static OLED_QueueTypedef oledLogQueue = {0};//OLED_PostLogϢ
+/**
+ * @brief 8ҳԴΪλ, 0ڵҳ, ʱֻıʾʼ(0x40~0x7F)
+ */
+static uint8_t ringTop = 0;
+static __IO uint8_t shownTop = 0;//Ļǰĵ0ڵҳ
+#define OLED_PAGE(line)             (((line) + ringTop) & (OLED_PAGES - 1))
+
+/**
+ * @brief һˢµľδ, 궼
+ */
+typedef struct {
+    uint8_t beginX;
+    uint8_t endX;
+    uint8_t beginPage;
+    uint8_t endPage;
+}OLED_WindowTypedef;
+
+/**
+ * @brief ʼ, ϲΪһζĴ(0x00)д
+ */
+#define OLED_INIT_COMMAND(command)  IIC_INIT_STREAM(OLED_IIC_ADDRESS >> 1, 0x00, command)
+static const IIC_InitEntryTypedef OLED_InitTable[] = {
+    IIC_INIT_PROBE(OLED_IIC_ADDRESS >> 1, 0x00, 150),//ȴϵ, Ӧ𼴿д, ̶ʱ150ms
+    OLED_INIT_COMMAND(0xAE),//--display off
+    OLED_INIT_COMMAND(0x00),//---set low column address
+    OLED_INIT_COMMAND(0x10),//---set high column address
+    OLED_INIT_COMMAND(0x40),//--set start line address  
+    OLED_INIT_COMMAND(0x20),//-set memory addressing mode
+    OLED_INIT_COMMAND(0x00),//horizontal, д0x21/0x22õĴһкԶһҳ
+    OLED_INIT_COMMAND(0xB0),//--set page address
+    OLED_INIT_COMMAND(0x81),//contract control
+    OLED_INIT_COMMAND(OLED_BRIGHTNESS),//--256
+    OLED_INIT_COMMAND(0xA1),//set segment remap 
+    OLED_INIT_COMMAND(0xA6),//--normal / reverse
+    OLED_INIT_COMMAND(0xA8),//--set multiplex ratio(1 to 64)
+    OLED_INIT_COMMAND(0x3F),//--1/32 duty
+    OLED_INIT_COMMAND(0xC8),//Com scan direction
+    OLED_INIT_COMMAND(0xD3),//-set display offset
+    OLED_INIT_COMMAND(0x00),
+    OLED_INIT_COMMAND(0xD5),//set osc division
+    OLED_INIT_COMMAND(0x80),
+    OLED_INIT_COMMAND(0xD8),//set area color mode off
+    OLED_INIT_COMMAND(0x05),
+    OLED_INIT_COMMAND(0xD9),//Set Pre-Charge Period
+    OLED_INIT_COMMAND(0xF1),
+    OLED_INIT_COMMAND(0xDA),//set com pin configuartion
+    OLED_INIT_COMMAND(0x12),
+    OLED_INIT_COMMAND(0xDB),//set Vcomh
+    OLED_INIT_COMMAND(0x30),
+    OLED_INIT_COMMAND(0x8D),//set charge pump enable
+    OLED_INIT_COMMAND(0x14),
+    OLED_INIT_COMMAND(0xAF)//--turn on oled panel
+};
+
+/**
+ * @brief OLEDڵIIC
+ */
+#ifdef OLED_USE_SEPARATE_IIC
+static IIC_BusTypedef OLED_IicBus = IIC_BUS_INIT(IIC_BACKEND_SOFTWARE, OLED_IIC_SCL_PORT, OLED_IIC_SCL_PIN, OLED_IIC_SDA_PORT, OLED_IIC_SDA_PIN, OLED_IIC_SPEED);
+#define OLED_IIC_BUS                (&OLED_IicBus)
+#else
+#define OLED_IIC_BUS                (&IIC_DefaultBus)
+#endif
+
+/**
+ * @brief ݵķͷʽ
+ * @note ̨ˢµ첽ҲIIC_TransferTypedef, SPIֻõreg(0x00-; 0x40-), len, data, callback
+ */
+#ifdef OLED_USE_SPI
+static struct {
+    IIC_TransferTypedef *transfer;//ڷ͵첽, NULLʾ
+    __IO uint8_t busy;//DMAڷ
+}oledSpi;
+#define OLED_WRITE_COMMANDS(len, commands)  OLED_SpiWrite(0, commands, len)
+#define OLED_WRITE_DATA(len, data)          OLED_SpiWrite(1, data, len)
+#define OLED_SUBMIT(transfer)               OLED_SpiSubmit(transfer)
+#define OLED_CHUNK_SIZE                     (OLED_WIDTH * OLED_PAGES)//û, ÷ֿ
+#else
+#define OLED_WRITE_COMMANDS(len, commands)  IIC_BusWriteRegBytes(OLED_IIC_BUS, OLED_IIC_ADDRESS >> 1, 0x00, len, commands)
+#define OLED_WRITE_DATA(len, data)          IIC_BusWriteBulk(OLED_IIC_BUS, OLED_IIC_ADDRESS >> 1, 0x40, len, data)//D/C#=0; R/W#=0; write data
+#define OLED_SUBMIT(transfer)               IIC_BusSubmit(OLED_IIC_BUS, transfer)
+#define OLED_CHUNK_SIZE                     IIC_CHUNK_SIZE
+#endif
 
 static uint8_t OLED_WriteCommand(uint8_t command);
-static uint8_t OLED_WriteData(uint8_t data);
+#ifdef OLED_USE_SPI
+static void OLED_SpiInit(void);
+static void OLED_SpiRunInitTable(void);
+static uint8_t OLED_SpiWrite(uint8_t isData, const uint8_t *data, uint16_t len);
+#ifdef OLED_USE_BACKGROUND_REFRESH
+static uint8_t OLED_SpiSubmit(IIC_TransferTypedef *transfer);
+#endif
+#endif
+static inline void OLED_MarkDirty(uint8_t page, uint8_t beginX, uint8_t endX);
 static inline void OLED_ScrollUpOneLine(void);
+#ifdef OLED_USE_BACKGROUND_REFRESH
+static void OLED_RefreshInit(void);
+#endif
 
 /**
  * @brief ʼOLED, 
@@ -59,36 +191,18 @@ static inline void OLED_ScrollUpOneLine(void);
  */
 void OLED_Init(OLED_HandleTypedef *oledHandle)
 {
-    IIC_Init();
-    delay_ms(150);
-    OLED_WriteCommand(0xAE);//--display off
-    OLED_WriteCommand(0x00);//---set low column address
-    OLED_WriteCommand(0x10);//---set high column address
-    OLED_WriteCommand(0x40);//--set start line address  
-    OLED_WriteCommand(0xB0);//--set page address
-    OLED_WriteCommand(0x81);//contract control
-    OLED_WriteCommand(OLED_BRIGHTNESS);//--256
-    OLED_WriteCommand(0xA1);//set segment remap 
-    OLED_WriteCommand(0xA6);//--normal / reverse
-    OLED_WriteCommand(0xA8);//--set multiplex ratio(1 to 64)
-    OLED_WriteCommand(0x3F);//--1/32 duty
-    OLED_WriteCommand(0xC8);//Com scan direction
-    OLED_WriteCommand(0xD3);//-set display offset
-    OLED_WriteCommand(0x00);
-    OLED_WriteCommand(0xD5);//set osc division
-    OLED_WriteCommand(0x80);
-    OLED_WriteCommand(0xD8);//set area color mode off
-    OLED_WriteCommand(0x05);
-    OLED_WriteCommand(0xD9);//Set Pre-Charge Period
-    OLED_WriteCommand(0xF1);
-    OLED_WriteCommand(0xDA);//set com pin configuartion
-    OLED_WriteCommand(0x12);
-    OLED_WriteCommand(0xDB);//set Vcomh
-    OLED_WriteCommand(0x30);
-    OLED_WriteCommand(0x8D);//set charge pump enable
-    OLED_WriteCommand(0x14);
-    OLED_WriteCommand(0xAF);//--turn on oled panel
+#ifdef OLED_USE_SPI
+    OLED_SpiInit();
+    OLED_SpiRunInitTable();
+#else
+    if(IIC_BusInit(OLED_IIC_BUS))
+        return;//IIC_MAX_BUSES
+    IIC_BusRunInitTable(OLED_IIC_BUS, OLED_InitTable, sizeof(OLED_InitTable) / sizeof(OLED_InitTable[0]));
+#endif
     OLED_Clear(oledHandle);
+#ifdef OLED_USE_BACKGROUND_REFRESH
+    OLED_RefreshInit();
+#endif
 }
 /**
  * @brief д
@@ -97,35 +211,219 @@ void OLED_Init(OLED_HandleTypedef *oledHandle)
  */
 static uint8_t OLED_WriteCommand(uint8_t command)
 {
-    IIC_Start();
-    IIC_WriteByte(OLED_IIC_ADDRESS);//Slave address,SA0=0
-    IIC_IF_NOT_ACK_RETURN_1;
-    IIC_WriteByte(0x00);//write command
-    IIC_IF_NOT_ACK_RETURN_1;
-    IIC_WriteByte(command); 
-    IIC_IF_NOT_ACK_RETURN_1;
-    IIC_Stop();
-    return 0;
+    return OLED_WRITE_COMMANDS(1, &command);//IIC: Slave address,SA0=0; write command
+}
+
+#ifdef OLED_USE_SPI
+/**
+ * @brief ʼSPI, DMAͿ
+ * @note ֻ, MISO; SSD1306SCKز, CPOL=0, CPHA=0
+ */
+static void OLED_SpiInit()
+{
+    GPIO_InitTypeDef GPIO_InitStructure;
+    SPI_InitTypeDef SPI_InitStructure;
+    DMA_InitTypeDef DMA_InitStructure;
+#ifdef OLED_USE_BACKGROUND_REFRESH
+    NVIC_InitTypeDef NVIC_InitStructure;
+#endif
+
+    RCC_AHB1PeriphClockCmd(OLED_SPI_GPIO_CLK_ALL | OLED_SPI_DMA_CLK, ENABLE);//ʹGPIO, DMAʱ
+    RCC_APB1PeriphClockCmd(OLED_SPI_CLK, ENABLE);
+    GPIO_PinAFConfig(OLED_SPI_SCK_PORT, OLED_SPI_SCK_PINSOURCE, OLED_SPI_GPIO_AF);
+    GPIO_PinAFConfig(OLED_SPI_MOSI_PORT, OLED_SPI_MOSI_PINSOURCE, OLED_SPI_GPIO_AF);
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF;
+    GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;
+    GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_NOPULL;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+    GPIO_InitStructure.GPIO_Pin = OLED_SPI_SCK_PIN;
+    GPIO_Init(OLED_SPI_SCK_PORT, &GPIO_InitStructure);
+    GPIO_InitStructure.GPIO_Pin = OLED_SPI_MOSI_PIN;
+    GPIO_Init(OLED_SPI_MOSI_PORT, &GPIO_InitStructure);
+    GPIO_SetBits(OLED_SPI_CS_PORT, OLED_SPI_CS_PIN);
+    GPIO_SetBits(OLED_SPI_RES_PORT, OLED_SPI_RES_PIN);
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_OUT;
+    GPIO_InitStructure.GPIO_Pin = OLED_SPI_CS_PIN;
+    GPIO_Init(OLED_SPI_CS_PORT, &GPIO_InitStructure);
+    GPIO_InitStructure.GPIO_Pin = OLED_SPI_DC_PIN;
+    GPIO_Init(OLED_SPI_DC_PORT, &GPIO_InitStructure);
+    GPIO_InitStructure.GPIO_Pin = OLED_SPI_RES_PIN;
+    GPIO_Init(OLED_SPI_RES_PORT, &GPIO_InitStructure);
+
+    SPI_InitStructure.SPI_Direction = SPI_Direction_1Line_Tx;
+    SPI_InitStructure.SPI_Mode = SPI_Mode_Master;
+    SPI_InitStructure.SPI_DataSize = SPI_DataSize_8b;
+    SPI_InitStructure.SPI_CPOL = SPI_CPOL_Low;
+    SPI_InitStructure.SPI_CPHA = SPI_CPHA_1Edge;
+    SPI_InitStructure.SPI_NSS = SPI_NSS_Soft;
+    SPI_InitStructure.SPI_BaudRatePrescaler = OLED_SPI_PRESCALER;
+    SPI_InitStructure.SPI_FirstBit = SPI_FirstBit_MSB;
+    SPI_InitStructure.SPI_CRCPolynomial = 7;
+    SPI_Init(OLED_SPI, &SPI_InitStructure);
+    SPI_I2S_DMACmd(OLED_SPI, SPI_I2S_DMAReq_Tx, ENABLE);
+    SPI_Cmd(OLED_SPI, ENABLE);
+
+    DMA_DeInit(OLED_SPI_DMA_STREAM);
+    DMA_InitStructure.DMA_Channel = OLED_SPI_DMA_CHANNEL;
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&OLED_SPI->DR;
+    DMA_InitStructure.DMA_Memory0BaseAddr = 0;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_MemoryToPeripheral;
+    DMA_InitStructure.DMA_BufferSize = 1;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_Low;
+    DMA_InitStructure.DMA_FIFOMode = DMA_FIFOMode_Disable;
+    DMA_InitStructure.DMA_FIFOThreshold = DMA_FIFOThreshold_Full;
+    DMA_InitStructure.DMA_MemoryBurst = DMA_MemoryBurst_Single;
+    DMA_InitStructure.DMA_PeripheralBurst = DMA_PeripheralBurst_Single;
+    DMA_Init(OLED_SPI_DMA_STREAM, &DMA_InitStructure);
+#ifdef OLED_USE_BACKGROUND_REFRESH
+    //PendSVˢ¶ʱͬһռȼ, ɻص붨ʱжϻ
+    NVIC_InitStructure.NVIC_IRQChannel = OLED_SPI_DMA_IRQCHANNEL;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 3;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+#endif
+}
+
+/**
+ * @brief λĻ, ȻOLED_InitTableͳʼ
+ * @note SPIûӦ, IIC_INIT_OP_PROBERESŸλ; ڵϲΪһDMA
+ */
+static void OLED_SpiRunInitTable()
+{
+    uint8_t commands[sizeof(OLED_InitTable) / sizeof(OLED_InitTable[0]) * IIC_INIT_MAX_BYTES];
+    const IIC_InitEntryTypedef *entry;
+    uint16_t len = 0;
+
+    for(entry = OLED_InitTable; entry < OLED_InitTable + sizeof(OLED_InitTable) / sizeof(OLED_InitTable[0]); entry++)
+    {
+        if(entry->op == IIC_INIT_OP_STREAM)
+        {
+            memcpy(commands + len, entry->data, entry->len);
+            len += entry->len;
+            if(!entry->delayMs)
+                continue;
+        }
+        OLED_SpiWrite(0, commands, len);
+        len = 0;
+        if(entry->op == IIC_INIT_OP_PROBE)
+        {
+            GPIO_ResetBits(OLED_SPI_RES_PORT, OLED_SPI_RES_PIN);//λ͵ƽ3us
+            delay_ms(1);
+            GPIO_SetBits(OLED_SPI_RES_PORT, OLED_SPI_RES_PIN);
+            delay_ms(1);
+        }
+        else if(entry->delayMs)
+            delay_ms(entry->delayMs);
+    }
+    OLED_SpiWrite(0, commands, len);
+}
+
+/**
+ * @brief ռDMA
+ * @return 0-ɹ; 1-DMAڷ
+ */
+static inline uint8_t OLED_SpiAcquire()
+{
+    uint32_t primask = __get_PRIMASK();
+    uint8_t busy;
+    __disable_irq();
+    busy = oledSpi.busy;
+    oledSpi.busy = 1;
+    __set_PRIMASK(primask);
+    return busy;
 }
 
 /**
- * @brief д
- * @param data 
+ * @brief D/C#, Ƭѡ, ʼDMA
+ * @param isData 1-; 0-
+ * @param interrupt Ƿʱж
+ */
+static void OLED_SpiStart(uint8_t isData, const uint8_t *data, uint16_t len, FunctionalState interrupt)
+{
+    GPIO_WriteBit(OLED_SPI_DC_PORT, OLED_SPI_DC_PIN, isData ? Bit_SET : Bit_RESET);
+    GPIO_ResetBits(OLED_SPI_CS_PORT, OLED_SPI_CS_PIN);
+    DMA_ClearFlag(OLED_SPI_DMA_STREAM, OLED_SPI_DMA_FLAG_ALL);
+    DMA_ITConfig(OLED_SPI_DMA_STREAM, DMA_IT_TC | DMA_IT_TE, interrupt);
+    OLED_SPI_DMA_STREAM->M0AR = (uint32_t)data;
+    DMA_SetCurrDataCounter(OLED_SPI_DMA_STREAM, len);
+    DMA_Cmd(OLED_SPI_DMA_STREAM, ENABLE);
+}
+
+/**
+ * @brief ȴһֽƳ, ȡƬѡ
+ * @note DMAʱһֽڻSPIķͻ, ʱıD/C#Ūֽ, ȴ2ֽڵʱ
+ */
+static void OLED_SpiStop()
+{
+    while(SPI_I2S_GetFlagStatus(OLED_SPI, SPI_I2S_FLAG_TXE) == RESET);
+    while(SPI_I2S_GetFlagStatus(OLED_SPI, SPI_I2S_FLAG_BSY) == SET);
+    GPIO_SetBits(OLED_SPI_CS_PORT, OLED_SPI_CS_PIN);
+}
+
+/**
+ * @brief 
+ * @param isData 1-; 0-
  * @return 0-; 1-
+ * @note ̨ˢڷʱȵȴDMA, Ҫж
+ */
+static uint8_t OLED_SpiWrite(uint8_t isData, const uint8_t *data, uint16_t len)
+{
+    uint8_t error;
+    if(!len)
+        return 0;
+    while(OLED_SpiAcquire());
+    OLED_SpiStart(isData, data, len, DISABLE);
+    while(DMA_GetCmdStatus(OLED_SPI_DMA_STREAM) == ENABLE);//ɻʱӲEN
+    error = DMA_GetFlagStatus(OLED_SPI_DMA_STREAM, OLED_SPI_DMA_FLAG_TE) == SET;
+    OLED_SpiStop();
+    oledSpi.busy = 0;
+    return error;
+}
+
+#ifdef OLED_USE_BACKGROUND_REFRESH
+/**
+ * @brief ύһ첽, ÷IIC_BusSubmitͬ
+ * @return 0-ύ; 1-DMAڷ
+ * @note ɻصDMAжִ
  */
-static uint8_t OLED_WriteData(uint8_t data)
+static uint8_t OLED_SpiSubmit(IIC_TransferTypedef *transfer)
 {
-    IIC_Start();
-    IIC_WriteByte(OLED_IIC_ADDRESS);//D/C#=0; R/W#=0
-    IIC_IF_NOT_ACK_RETURN_1;
-    IIC_WriteByte(0x40);//write data
-    IIC_IF_NOT_ACK_RETURN_1;
-    IIC_WriteByte(data);
-    IIC_IF_NOT_ACK_RETURN_1;  
-    IIC_Stop();
+    if(OLED_SpiAcquire())
+        return 1;
+    oledSpi.transfer = transfer;
+    transfer->status = IIC_STATUS_PENDING;
+    OLED_SpiStart(transfer->reg == 0x40, transfer->data, transfer->len, ENABLE);
     return 0;
 }
 
+/**
+ * @brief SPIDMAжϷ, ֻ첽俪ж
+ */
+void OLED_SPI_DMA_IRQHANDLER()
+{
+    IIC_TransferTypedef *transfer = oledSpi.transfer;
+    uint8_t error = DMA_GetITStatus(OLED_SPI_DMA_STREAM, OLED_SPI_DMA_IT_TE) != RESET;
+
+    DMA_ClearITPendingBit(OLED_SPI_DMA_STREAM, OLED_SPI_DMA_IT_TC | OLED_SPI_DMA_IT_TE);
+    if(transfer == NULL)
+        return;
+    OLED_SpiStop();
+    oledSpi.transfer = NULL;
+    oledSpi.busy = 0;
+    transfer->status = error ? IIC_STATUS_ERROR : IIC_STATUS_OK;
+    if(transfer->callback)
+        transfer->callback(transfer);
+}
+#endif
+#endif
+
+
 
 /**
  * @brief ȫ
@@ -134,31 +432,344 @@ static uint8_t OLED_WriteData(uint8_t data)
 void OLED_FillScreen(uint8_t fillData)
 {
     uint8_t m, n;
+    OLED_BeginDraw();
     for(m = 0; m < OLED_PAGES; m++)
     {
-        OLED_WriteCommand(0xb0 + m);//page0-page1
-        OLED_WriteCommand(0x00);//low column start address
-        OLED_WriteCommand(0x10);//high column start address
         for(n = 0; n < OLED_WIDTH; n++)
-        {
-            OLED_WriteData(fillData);
             gRam[m][n] = fillData;
+        OLED_MarkDirty(m, 0, OLED_WIDTH - 1);
+    }
+    OLED_EndDraw();
+}
+
+
+
+/**
+ * @brief ԴиĶһ, ˢʱдĻ
+ * @param page ҳ(0~7)
+ * @param beginX ʼ(0~127)
+ * @param endX (0~127), 
+ */
+static inline void OLED_MarkDirty(uint8_t page, uint8_t beginX, uint8_t endX)
+{
+    if(!dirtyEnd[page])
+    {
+        dirtyBegin[page] = beginX;
+        dirtyEnd[page] = endX + 1;
+        return;
+    }
+    if(beginX < dirtyBegin[page])
+        dirtyBegin[page] = beginX;
+    if(endX >= dirtyEnd[page])
+        dirtyEnd[page] = endX + 1;
+}
+
+/**
+ * @brief ԴĸĶ滮ɾδ, ȻĶ
+ * @param windows , OLED_PAGES
+ * @return ڸ
+ * @note ĸĶҳϲһ, ϲഫֽڲOLED_FLUSH_MERGE_BYTESʱźϲ
+ */
+static uint8_t OLED_PlanWindows(OLED_WindowTypedef *windows)
+{
+    uint8_t page = 0, count = 0, beginPage, beginX, endX, mergedBeginX, mergedEndX;
+    uint16_t bytes, mergedBytes;
+
+    while(page < OLED_PAGES)
+    {
+        if(!dirtyEnd[page])
+        {
+            page++;
+            continue;
         }
+        beginPage = page;
+        beginX = dirtyBegin[page];
+        endX = dirtyEnd[page];
+        bytes = endX - beginX;
+        for(page++; page < OLED_PAGES && dirtyEnd[page]; page++)
+        {
+            mergedBeginX = dirtyBegin[page] < beginX ? dirtyBegin[page] : beginX;
+            mergedEndX = dirtyEnd[page] > endX ? dirtyEnd[page] : endX;
+            mergedBytes = (page - beginPage + 1) * (mergedEndX - mergedBeginX);
+            if(mergedBytes > bytes + (dirtyEnd[page] - dirtyBegin[page]) + OLED_FLUSH_MERGE_BYTES)
+                break;
+            beginX = mergedBeginX;
+            endX = mergedEndX;
+            bytes = mergedBytes;
+        }
+        windows[count].beginX = beginX;
+        windows[count].endX = endX - 1;
+        windows[count].beginPage = beginPage;
+        windows[count].endPage = page - 1;
+        count++;
     }
+    for(page = 0; page < OLED_PAGES; page++)
+        dirtyEnd[page] = 0;
+    return count;
 }
 
+/**
+ * @brief ڵĵrowڻеλúֽ
+ * @note пĴڻ, ֻһ
+ */
+static inline uint8_t *OLED_WindowRow(__IO uint8_t (*ram)[OLED_WIDTH], const OLED_WindowTypedef *window, uint8_t row, uint16_t *len)
+{
+    if(window->beginX == 0 && window->endX == OLED_WIDTH - 1)
+        *len = (window->endPage - window->beginPage + 1) * OLED_WIDTH;
+    else
+        *len = window->endX - window->beginX + 1;
+    return (uint8_t *)&ram[window->beginPage + row][window->beginX];
+}
 
+/**
+ * @brief ڻе
+ */
+static inline uint8_t OLED_WindowRows(const OLED_WindowTypedef *window)
+{
+    return window->beginX == 0 && window->endX == OLED_WIDTH - 1 ? 1 : window->endPage - window->beginPage + 1;
+}
 
 /**
- * @brief 
- * @param x (0~127)
- * @param y ҳ(0~7)
+ * @brief ôڵ: еַҳַΧ, ֮ݰԶҳ
  */
-static inline void OLED_SetPosition(uint8_t x, uint8_t y)
-{     
-    OLED_WriteCommand(0xb0 + y);
-    OLED_WriteCommand(((x & 0xf0) >> 4) | 0x10);
-    OLED_WriteCommand((x & 0x0f));
+static inline void OLED_WindowCommand(const OLED_WindowTypedef *window, uint8_t command[6])
+{
+    command[0] = 0x21;
+    command[1] = window->beginX;
+    command[2] = window->endX;
+    command[3] = 0x22;
+    command[4] = window->beginPage;
+    command[5] = window->endPage;
+}
+
+#ifndef OLED_USE_BACKGROUND_REFRESH
+/**
+ * @brief ԴиĶĲˢµĻ
+ * @note ÿһô, IICݰIIC_CHUNK_SIZEֿд, ֮䴫ĸȼԲ
+ *       OLED_USE_MANUAL_FLUSHʱӦóڵ, ƺǰԶ
+ */
+void OLED_Flush()
+{
+    OLED_WindowTypedef windows[OLED_PAGES];
+    uint8_t command[6];
+    uint8_t count, i, row;
+    uint16_t len;
+    uint8_t *data;
+
+    if(shownTop != ringTop)
+    {
+        shownTop = ringTop;
+        OLED_WriteCommand(0x40 | (ringTop << 3));//set display start line, ʼЧ, µһȳڶ
+    }
+    count = OLED_PlanWindows(windows);
+    for(i = 0; i < count; i++)
+    {
+        OLED_WindowCommand(&windows[i], command);
+        OLED_WRITE_COMMANDS(sizeof(command), command);
+        for(row = 0; row < OLED_WindowRows(&windows[i]); row++)
+        {
+            data = OLED_WindowRow(gRam, &windows[i], row, &len);
+            OLED_WRITE_DATA(len, data);
+        }
+    }
+}
+#else
+/**
+ * @brief ̨ˢµһ֡
+ * @note ʱжϺIICص(PendSV)SPIDMAжϵռȼͬ, ụ
+ */
+static struct {
+    OLED_WindowTypedef windows[OLED_PAGES];
+    uint8_t count;//ڸ
+    uint8_t index;//ڷ͵Ĵ
+    uint8_t row;//ڷ͵, 0xFFʾûзôڵ
+    uint16_t offset;//ѷ͵ֽ
+    uint8_t command[6];
+    uint8_t startLineCommand;//ʾʼе
+    uint8_t sendStartLine;//һ֡ȷstartLineCommand
+    IIC_TransferTypedef transfer;
+    __IO uint8_t busy;//һ֡ûз
+    __IO uint8_t deferred;//ʱʱڻ, Ƴٵƽ
+}oledFrame;
+static uint8_t frontRam[OLED_PAGES][OLED_WIDTH];//еһ֡, gRamӰ
+
+static void OLED_FrameCallback(IIC_TransferTypedef *transfer);
+
+/**
+ * @brief ύһ֡еһ: ôڵһ
+ * @return 0-ύ; 1-һ֡ѷ
+ * @note ʱû͵Ĵ±ΪĶ, һ֡ٷ
+ */
+static uint8_t OLED_FrameNext()
+{
+    IIC_TransferTypedef *transfer = &oledFrame.transfer;
+    OLED_WindowTypedef *window;
+    uint16_t len;
+    uint8_t *data;
+    uint8_t page;
+
+    window = &oledFrame.windows[oledFrame.index];
+    transfer->addr = OLED_IIC_ADDRESS >> 1;
+    transfer->isRead = 0;
+    transfer->segments = NULL;
+    transfer->segmentCount = 0;
+    transfer->priority = IIC_PRIORITY_LOW;
+    transfer->callback = OLED_FrameCallback;
+    if(oledFrame.sendStartLine)
+    {
+        transfer->reg = 0x00;
+        transfer->len = 1;
+        transfer->data = &oledFrame.startLineCommand;
+        oledFrame.sendStartLine = 0;
+    }
+    else if(oledFrame.index >= oledFrame.count)
+        return 1;
+    else if(oledFrame.row == 0xFF)
+    {
+        OLED_WindowCommand(window, oledFrame.command);
+        transfer->reg = 0x00;
+        transfer->len = sizeof(oledFrame.command);
+        transfer->data = oledFrame.command;
+        oledFrame.row = 0;
+        oledFrame.offset = 0;
+    }
+    else
+    {
+        data = OLED_WindowRow((__IO uint8_t (*)[OLED_WIDTH])frontRam, window, oledFrame.row, &len);
+        transfer->reg = 0x40;
+        transfer->len = len - oledFrame.offset > OLED_CHUNK_SIZE ? OLED_CHUNK_SIZE : len - oledFrame.offset;
+        transfer->data = data + oledFrame.offset;
+        oledFrame.offset += transfer->len;
+        if(oledFrame.offset >= len && ++oledFrame.row >= OLED_WindowRows(window))
+        {
+            oledFrame.index++;
+            oledFrame.row = 0xFF;
+        }
+    }
+    if(!OLED_SUBMIT(transfer))
+        return 0;
+    shownTop = 0xFF;//ʼпûз, һ֡ط
+    for(; window < oledFrame.windows + oledFrame.count; window++)
+    {
+        for(page = window->beginPage; page <= window->endPage; page++)
+            OLED_MarkDirty(page, window->beginX, window->endX);
+    }
+    return 1;
+}
+
+/**
+ * @brief һ, ύһ, PendSVִ
+ */
+static void OLED_FrameCallback(IIC_TransferTypedef *transfer)
+{
+    if(OLED_FrameNext())
+        oledFrame.busy = 0;
+}
+
+/**
+ * @brief ԴиĶĲˢµĻ
+ * @note ̨ˢʱɶʱ, ֻȴԴĸĶȫ
+ *       ȴڼҪIICжϺPendSV, Ҫж
+ */
+void OLED_Flush()
+{
+    uint8_t page;
+    do
+    {
+        for(page = 0; page < OLED_PAGES && !dirtyEnd[page]; page++);
+    }while(oledFrame.busy || page < OLED_PAGES || shownTop != ringTop);
+}
+
+/**
+ * @brief ʼ̨ˢ, ÿ1/OLED_REFRESH_HZ뷢һ֡ԴĸĶ
+ */
+static void OLED_RefreshInit()
+{
+    TIM_TimeBaseInitTypeDef TIM_TimeBaseStructure;
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    RCC_APB1PeriphClockCmd(OLED_REFRESH_TIM_CLK, ENABLE);
+    TIM_TimeBaseStructure.TIM_Prescaler = 8400 - 1;//APB1ʱʱ84MHz, Ƶ10KHz
+    TIM_TimeBaseStructure.TIM_CounterMode = TIM_CounterMode_Up;
+    TIM_TimeBaseStructure.TIM_Period = 10000 / OLED_REFRESH_HZ - 1;
+    TIM_TimeBaseStructure.TIM_ClockDivision = TIM_CKD_DIV1;
+    TIM_TimeBaseInit(OLED_REFRESH_TIM, &TIM_TimeBaseStructure);
+    TIM_ClearITPendingBit(OLED_REFRESH_TIM, TIM_IT_Update);
+    TIM_ITConfig(OLED_REFRESH_TIM, TIM_IT_Update, ENABLE);
+    oledFrame.row = 0xFF;
+    //PendSVͬһռȼ
+    NVIC_InitStructure.NVIC_IRQChannel = OLED_REFRESH_IRQCHANNEL;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 3;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+    TIM_Cmd(OLED_REFRESH_TIM, ENABLE);
+}
+
+/**
+ * @brief ̨ˢµĶʱжϷ
+ * @note һ֡ûлƺִʱ, жϰѸĶĴڸƵfrontRam, Ȼʼ
+ *       ڼжĻƺҲִ, ÿһֻ֡Ļƽ, ˺
+ */
+void OLED_REFRESH_IRQHANDLER()
+{
+    uint32_t primask;
+    OLED_WindowTypedef *window;
+    uint8_t page;
+
+    TIM_ClearITPendingBit(OLED_REFRESH_TIM, TIM_IT_Update);
+    if(oledFrame.busy)
+        return;
+    if(oledDrawing)
+    {
+        oledFrame.deferred = 1;
+        return;
+    }
+    primask = __get_PRIMASK();
+    __disable_irq();
+    oledFrame.count = OLED_PlanWindows(oledFrame.windows);
+    for(window = oledFrame.windows; window < oledFrame.windows + oledFrame.count; window++)
+    {
+        for(page = window->beginPage; page <= window->endPage; page++)
+            memcpy(&frontRam[page][window->beginX], (uint8_t *)&gRam[page][window->beginX], window->endX - window->beginX + 1);
+    }
+    oledFrame.sendStartLine = shownTop != ringTop;
+    oledFrame.startLineCommand = 0x40 | (ringTop << 3);
+    shownTop = ringTop;
+    __set_PRIMASK(primask);
+    oledFrame.index = 0;
+    oledFrame.row = 0xFF;
+    if((oledFrame.count || oledFrame.sendStartLine) && !OLED_FrameNext())
+        oledFrame.busy = 1;
+}
+#endif
+
+/**
+ * @brief ƺʼ, ̨ˢڻƽǰḴԴ
+ * @note Ƕ, OLED_EndDrawɶԵ
+ */
+void OLED_BeginDraw()
+{
+    oledDrawing++;
+}
+
+/**
+ * @brief ƺ, Ļƽʱˢ»ϱƳٵĺ̨ˢ
+ * @note OLED_USE_MANUAL_FLUSHʱӦóOLED_Flush
+ */
+void OLED_EndDraw()
+{
+    if(--oledDrawing)
+        return;
+#if defined(OLED_USE_BACKGROUND_REFRESH)
+    if(oledFrame.deferred)
+    {
+        oledFrame.deferred = 0;
+        NVIC_SetPendingIRQ(OLED_REFRESH_IRQCHANNEL);
+    }
+#elif !defined(OLED_USE_MANUAL_FLUSH)
+    OLED_Flush();
+#endif
 }
 
 /**
@@ -188,18 +799,7 @@ void OLED_TurnOff()
  */
 void OLED_Clear(OLED_HandleTypedef *oledHandle)
 {  
-    uint8_t m, n;            
-    for(m = 0; m < OLED_PAGES; m++)  
-    {  
-        OLED_WriteCommand(0xb0 + m);//ҳַ0~7
-        OLED_WriteCommand(0x00);//ʾλáе͵ַ
-        OLED_WriteCommand(0x10);//ʾλáиߵַ   
-        for(n = 0; n < OLED_WIDTH; n++)
-        {
-            OLED_WriteData(0);
-            gRam[m][n] = 0;
-        }
-    } //ʾ
+    OLED_FillScreen(0);
     oledHandle->stringX = 0;
     oledHandle->stringY = 0;
 }
@@ -210,18 +810,7 @@ void OLED_Clear(OLED_HandleTypedef *oledHandle)
  */
 void OLED_Blank()
 {  
-    uint8_t m,n;            
-    for(m = 0; m < OLED_PAGES; m++)  
-    {  
-        OLED_WriteCommand(0xb0 + m);//ҳַ0~7
-        OLED_WriteCommand(0x00);//ʾλáе͵ַ
-        OLED_WriteCommand(0x10);//ʾλáиߵַ   
-        for(n = 0; n < OLED_WIDTH; n++)
-        {
-            OLED_WriteData(1);
-            gRam[m][n] = 1;
-        }
-    } //ʾ
+    OLED_FillScreen(1);
 }
 
 /**
@@ -235,15 +824,187 @@ static inline void OLED_DisplayCharacter(uint8_t positionX, uint8_t positionY, u
 {
     uint32_t characterOffset = (uint32_t)(character - ' ');//õƫƺֵ
     uint8_t i;
-    OLED_SetPosition(positionX, positionY);
     for(i = 0; i < OLED_CHARACTER_WIDTH; i++)
+        gRam[OLED_PAGE(positionY)][positionX + i] = F6x8[characterOffset][i];
+    OLED_MarkDirty(OLED_PAGE(positionY), positionX, positionX + OLED_CHARACTER_WIDTH - 1);
+}
+
+/**
+ * @brief ַָλʾһַ, ֻ޸Դ
+ * @param column (0~20)
+ * @param line (0~7)
+ * @param character Ҫʾַ
+ * @note ˢĻ, OLED_BeginDrawOLED_EndDraw֮
+ */
+void OLED_DisplayCell(uint8_t column, uint8_t line, char character)
+{
+    if(column >= OLED_CHARACTERS_ONE_LINE || line >= OLED_LINES)
+        return;
+    OLED_DisplayCharacter((column << 1) + (column << 2), line, character, 8);
+}
+
+/**
+ * @brief дһ, ֻ޸Դ
+ * @param positionX (0~127)
+ * @param line ʼ(0~7)
+ * @param lines , ĻĲֺ
+ * @param column ÿһֽ, λ
+ * @note ˢĻ, OLED_BeginDrawOLED_EndDraw֮
+ */
+void OLED_DisplayColumn(uint8_t positionX, uint8_t line, uint8_t lines, const uint8_t *column)
+{
+    if(positionX >= OLED_WIDTH)
+        return;
+    for(; lines && line < OLED_LINES; lines--, line++)
     {
-        OLED_WriteData(F6x8[characterOffset][i]);
-        gRam[positionY][positionX + i] = F6x8[characterOffset][i];
+        gRam[OLED_PAGE(line)][positionX] = *column++;
+        OLED_MarkDirty(OLED_PAGE(line), positionX, positionX);
     }
-    
 }
 
+/**
+ * @brief дһ, ֻ޸Դ
+ * @param positionX ʼ(0~127)
+ * @param line (0~7)
+ * @param width , ĻĲֺ
+ * @param row ÿһֽ, λ
+ * @note ˢĻ, OLED_BeginDrawOLED_EndDraw֮
+ */
+void OLED_DisplayRow(uint8_t positionX, uint8_t line, uint8_t width, const uint8_t *row)
+{
+    uint8_t page, i;
+    if(positionX >= OLED_WIDTH || line >= OLED_LINES || !width)
+        return;
+    if(width > OLED_WIDTH - positionX)
+        width = OLED_WIDTH - positionX;
+    page = OLED_PAGE(line);
+    for(i = 0; i < width; i++)
+        gRam[page][positionX + i] = row[i];
+    OLED_MarkDirty(page, positionX, positionX + width - 1);
+}
+
+/**
+ * @brief λûһַ
+ * @param positionX , Ϊ򳬳Ļ, Ĳֲõ
+ * @param positionY (), Ϊ򳬳Ļ, Ĳֲõ
+ * @param font ,  @ref OLED_FontTypedef
+ * @param character Ҫʾַ, еַʾ
+ * @param mode ԴϷʽ,  @ref OLED_BlitModeTypedef
+ * @note ַһλƴһ32λ, Դڼҳͬһһ, ÿֻдһԴ
+ */
+void OLED_DrawGlyph(int16_t positionX, int16_t positionY, const OLED_FontTypedef *font, char character, OLED_BlitModeTypedef mode)
+{
+    const uint8_t *glyph;
+    uint8_t pages = (font->height + 7) >> 3, index = (uint8_t)character - font->first;
+    uint8_t shift, affected, i, p;
+    int16_t page, x, beginX, endX;
+    uint32_t bits, mask, frame;
+
+    if(index >= font->count || font->height > OLED_GLYPH_MAX_HEIGHT)
+        return;
+    if(positionX >= OLED_WIDTH || positionX + font->width <= 0 || positionY >= OLED_HEIGHT || positionY + font->height <= 0)
+        return;
+    glyph = font->data + (uint32_t)index * pages * font->width;
+    page = positionY >= 0 ? positionY >> 3 : -((7 - positionY) >> 3);//ȡ
+    shift = positionY - (page << 3);
+    affected = (shift + font->height + 7) >> 3;
+    mask = ((1UL << font->height) - 1) << shift;
+    beginX = positionX < 0 ? 0 : positionX;
+    endX = positionX + font->width > OLED_WIDTH ? OLED_WIDTH - 1 : positionX + font->width - 1;
+
+    OLED_BeginDraw();
+    for(x = beginX; x <= endX; x++)
+    {
+        i = x - positionX;
+        for(bits = 0, p = 0; p < pages; p++)
+            bits |= (uint32_t)glyph[p * font->width + i] << (p << 3);
+        bits = (bits << shift) & mask;
+        for(frame = 0, p = 0; p < affected; p++)
+        {
+            if(page + p >= 0 && page + p < OLED_PAGES)
+                frame |= (uint32_t)gRam[OLED_PAGE(page + p)][x] << (p << 3);
+        }
+        switch(mode)
+        {
+            case OLED_BLIT_OR:
+                frame |= bits;
+                break;
+            case OLED_BLIT_AND:
+                frame &= bits | ~mask;
+                break;
+            case OLED_BLIT_XOR:
+                frame ^= bits;
+                break;
+            default:
+                frame = (frame & ~mask) | bits;
+                break;
+        }
+        for(p = 0; p < affected; p++)
+        {
+            if(page + p >= 0 && page + p < OLED_PAGES)
+                gRam[OLED_PAGE(page + p)][x] = frame >> (p << 3);
+        }
+    }
+    for(p = 0; p < affected; p++)
+    {
+        if(page + p >= 0 && page + p < OLED_PAGES)
+            OLED_MarkDirty(OLED_PAGE(page + p), beginX, endX);
+    }
+    OLED_EndDraw();
+}
+
+/**
+ * @brief λûַ
+ * @param positionX , Ϊ򳬳Ļ, Ĳֲõ
+ * @param positionY (), Ϊ򳬳Ļ, Ĳֲõ
+ * @param font ,  @ref OLED_FontTypedef
+ * @param string ַ, ַ
+ * @param mode ԴϷʽ,  @ref OLED_BlitModeTypedef
+ * @return ַĺ
+ */
+int16_t OLED_DrawString(int16_t positionX, int16_t positionY, const OLED_FontTypedef *font, const char *string, OLED_BlitModeTypedef mode)
+{
+    OLED_BeginDraw();
+    for(; *string && positionX < OLED_WIDTH; string++, positionX += font->width)
+        OLED_DrawGlyph(positionX, positionY, font, *string, mode);
+    OLED_EndDraw();
+    return positionX;
+}
+
+#ifdef OLED_USE_BENCHMARK
+/**
+ * @brief OLED_DrawGlyphٶ
+ * @param font ,  @ref OLED_FontTypedef
+ * @param shift ҳ߽ƫ(0~7), 0ʱҪλƴ
+ * @param mode ԴϷʽ,  @ref OLED_BlitModeTypedef
+ * @return ÿ뻭ַ
+ * @note ֻͳдԴʱ, ˢĻ; 
+ */
+uint32_t OLED_BenchmarkGlyphs(const OLED_FontTypedef *font, uint8_t shift, OLED_BlitModeTypedef mode)
+{
+    uint32_t begin, cycles;
+    uint16_t i;
+    int16_t positionX = 0, positionY = shift & 7;
+    CYCLECOUNTER_Init();
+    OLED_BeginDraw();
+    begin = CYCLECOUNTER_Read();
+    for(i = 0; i < OLED_BENCHMARK_GLYPHS; i++)
+    {
+        OLED_DrawGlyph(positionX, positionY, font, font->first + i % font->count, mode);
+        if((positionX += font->width) > OLED_WIDTH - font->width)
+        {
+            positionX = 0;
+            if((positionY += font->height) > OLED_HEIGHT - font->height)
+                positionY = shift & 7;
+        }
+    }
+    cycles = CYCLECOUNTER_Read() - begin;
+    OLED_FillScreen(0);
+    OLED_EndDraw();
+    return (uint32_t)((uint64_t)OLED_BENCHMARK_GLYPHS * (CYCLECOUNTER_CORE_CLOCK / 1000) / (cycles ? cycles : 1));
+}
+#endif
+
 static inline void OLED_ClearString(uint8_t beginX, uint8_t beginY, uint8_t endX, uint8_t endY)
 {
     uint8_t i, j;
@@ -251,44 +1012,77 @@ static inline void OLED_ClearString(uint8_t beginX, uint8_t beginY, uint8_t endX
     endX = (endX << 1) + (endX << 2);
     if(endY != beginY)
     {
-        OLED_WriteCommand(0xb0 | beginY);//ҳַ
-        OLED_WriteCommand(0x00 | (beginX & 0x0F));//ʾλáе͵ַ
-        OLED_WriteCommand(0x10 | (beginX >> 4));//ʾλáиߵַ   
-        for(j = beginX; j < 128; j++)
-        {
-            OLED_WriteData(0);
-            gRam[beginY][j] = 0;
-        }
+        for(j = beginX; j < OLED_WIDTH; j++)
+            gRam[OLED_PAGE(beginY)][j] = 0;
+        OLED_MarkDirty(OLED_PAGE(beginY), beginX, OLED_WIDTH - 1);
         for(j = beginY + 1; j < endY; j++)
         {
-            OLED_WriteCommand(0xb0 | j);//ҳַ
-            OLED_WriteCommand(0x00);//ʾλáе͵ַ
-            OLED_WriteCommand(0x10);//ʾλáиߵַ   
             for(i = 0; i < OLED_WIDTH; i++)
-            {
-                OLED_WriteData(0);
-                gRam[j][i] = 0;
-            }
+                gRam[OLED_PAGE(j)][i] = 0;
+            OLED_MarkDirty(OLED_PAGE(j), 0, OLED_WIDTH - 1);
         }
-        OLED_WriteCommand(0xb0 | endY);//ҳַ
-        OLED_WriteCommand(0x00);//ʾλáе͵ַ
-        OLED_WriteCommand(0x10);//ʾλáиߵַ   
         for(j = 0; j <= endX; j++)
-        {
-            OLED_WriteData(0);
-            gRam[endY][j] = 0;
-        }
+            gRam[OLED_PAGE(endY)][j] = 0;
+        OLED_MarkDirty(OLED_PAGE(endY), 0, endX);
     }
     else
     {
-        OLED_WriteCommand(0xb0 | beginY);//ҳַ
-        OLED_WriteCommand(0x00 | (beginX & 0x0F));//ʾλáе͵ַ
-        OLED_WriteCommand(0x10 | (beginX >> 4));//ʾλáиߵַ   
         for(j = beginX; j <= endX; j++)
-        {
-            OLED_WriteData(0);
-            gRam[beginY][j] = 0;
-        }
+            gRam[OLED_PAGE(beginY)][j] = 0;
+        OLED_MarkDirty(OLED_PAGE(beginY), beginX, endX);
+    }
+}
+
+/**
+ * @brief ʽʱĹ
+ */
+typedef struct {
+    uint8_t x;//ǰ(0~20)
+    uint16_t y;//ǰ
+    uint8_t skipNewline;//βԶ\r\nظ, ִֻһλ 1-һ\n
+    uint8_t linesScrollUp;//ԭҪϹ, һҪӡַʱٹ
+}OLED_CursorTypedef;
+
+/**
+ * @brief OLED_DisplayFormat, һַԴ
+ * @param context ,  @ref OLED_CursorTypedef
+ * @param character Ҫʾַ
+ */
+static void OLED_PutFormat(void *context, char character)
+{
+    OLED_CursorTypedef *cursor = (OLED_CursorTypedef *)context;
+    switch(character)
+    {
+        case '\r':
+            cursor->x = 0;//س\rǻص
+            break;
+        case '\n':
+            if(!cursor->skipNewline)//ʱ++y\n
+                cursor->y++;
+            cursor->skipNewline = 0;//ٺ´λ
+            break;
+        case '\t':
+            cursor->skipNewline = 0;//β\tٺ\n, Ϊʱѵһ
+            cursor->x = tabLookUpTable[cursor->x];//ҵҪλ
+            if(cursor->x >= OLED_CHARACTERS_ONE_LINE - 1)//\t󳬹ұ߽
+            {
+                cursor->x = 0;
+                cursor->y++;
+            }
+            break;
+        default://ǿַ, Ҫӡַ
+            cursor->skipNewline = 0;//βӡһַٺ\n, Ϊӡѵһ
+
+            //(x << 1) + (x << 2)x * 6, һַ6
+            OLED_DisplayCharacter((cursor->x << 1) + (cursor->x << 2), cursor->y > 7 ? 7 : cursor->y, character, 8);
+            
+            if(++cursor->x == OLED_CHARACTERS_ONE_LINE)//βԶвһ\nз
+            {
+                cursor->x = 0;
+                cursor->y++;
+                cursor->skipNewline = 1;
+            }
+            break;
     }
 }
 
@@ -297,19 +1091,18 @@ static inline void OLED_ClearString(uint8_t beginX, uint8_t beginY, uint8_t endX
  * @param oledHandle oled,  @ref OLED_HandleTypedef
  * @param positionX (0~127)
  * @param positionY ҳ(0~7)
- * @param format ʽַ
+ * @param format ʽַ, ֵ֧ת˵oled_format.h
  * @param ... 㶮
+ * @note ߸ʽ߻Դ, мַ, ʾOLED_STRING_MAX_CHARACTERSַ
  */
 void OLED_DisplayFormat(OLED_HandleTypedef *oledHandle, const char *format, ...)
 {
-    static uint8_t needYPlus = 1;//βԶ\r\nظִֻһλ 0-\r\n
-    uint8_t x = 0;//ǰ(0~20)
-    uint8_t y = 0;//ǰ(0~7)
-    uint8_t i = 0;
+    OLED_CursorTypedef cursor;
     va_list aptr;
  
     if(oledHandle == NULL)
         return;
+    OLED_BeginDraw();
     
     if(oledHandle->stringClear == ENABLE)
     {
@@ -318,61 +1111,26 @@ void OLED_DisplayFormat(OLED_HandleTypedef *oledHandle, const char *format, ...)
         oledHandle->stringClear = DISABLE;
     }
     
-    va_start(aptr, format);
-    vsprintf(oledHandle->__string, format, aptr);
-    va_end(aptr);
-    
     if(oledHandle->stringContinuous == ENABLE)
     {
-        x = oledHandle->__stringLastEndX;
-        y = oledHandle->__stringLastEndY;
+        cursor.x = oledHandle->__stringLastEndX;
+        cursor.y = oledHandle->__stringLastEndY;
     }
     else
     {
-        x = oledHandle->stringX;
-        y = oledHandle->stringY;
-    }
-    oledHandle->__stringLastBeignX = x;
-    oledHandle->__stringLastBeignY = y;
-    while (oledHandle->__string[i] != '\0')
-    { 
-        switch(oledHandle->__string[i])
-        {
-            case '\r':
-                x = 0;//س\rǻص
-                break;
-            case '\n':
-                if(needYPlus)//ʱ++y\n
-                    y++;
-                needYPlus = 1;//ٺ´λ
-                break;
-            case '\t':
-                needYPlus = 1;//β\tٺ\n, Ϊʱѵһ
-                x = tabLookUpTable[x];//ҵҪλ
-                if(x >= OLED_CHARACTERS_ONE_LINE - 1)//\t󳬹ұ߽
-                {
-                    x = 0;
-                    y++;
-                }
-                break;
-            default://ǿַ, Ҫӡַ
-                needYPlus = 1;//βӡһַٺ\n, Ϊӡѵһ
-
-                //(x << 1) + (x << 2)x * 6, һַ6
-                OLED_DisplayCharacter((x << 1) + (x << 2), y > 7 ? 7 : y, oledHandle->__string[i], 8);
-                
-                if(++x == OLED_CHARACTERS_ONE_LINE)//βԶвһ\nз
-                {
-                    x = 0;
-                    y++;
-                    needYPlus = 0;
-                }
-                break;
-        }
-        i++;
+        cursor.x = oledHandle->stringX;
+        cursor.y = oledHandle->stringY;
     }
-    oledHandle->__stringLastEndX = x;
-    oledHandle->__stringLastEndY = y;
+    cursor.skipNewline = oledHandle->__stringSkipNewline;
+    oledHandle->__stringLastBeignX = cursor.x;
+    oledHandle->__stringLastBeignY = cursor.y;
+    va_start(aptr, format);
+    OLED_FormatV(OLED_PutFormat, &cursor, OLED_STRING_MAX_CHARACTERS, format, aptr);
+    va_end(aptr);
+    oledHandle->__stringLastEndX = cursor.x;
+    oledHandle->__stringLastEndY = cursor.y;
+    oledHandle->__stringSkipNewline = cursor.skipNewline;
+    OLED_EndDraw();
 }
 
 /**
@@ -383,161 +1141,136 @@ void OLED_DisplayFormat(OLED_HandleTypedef *oledHandle, const char *format, ...)
 static inline void OLED_ClearLine(uint8_t lineIndex)
 {
     uint8_t n;
-    OLED_WriteCommand(0xb0 + lineIndex);//page0-page1
-    OLED_WriteCommand(0x00);//low column start address
-    OLED_WriteCommand(0x10);//high column start address
     for(n = 0; n < OLED_WIDTH; n++)
-    {
-        OLED_WriteData(0);
-        gRam[lineIndex][n] = 0;
-    }
+        gRam[OLED_PAGE(lineIndex)][n] = 0;
+    OLED_MarkDirty(OLED_PAGE(lineIndex), 0, OLED_WIDTH - 1);
 }
 
 /**
  * @brief Ļһ
  * @note һмһҳ߶, 8
+ *       ԭĵ0гΪһв, ˢʱֻһʾʼеһҳ
  */
 static inline void OLED_ScrollUpOneLine()
 {
-    uint8_t m, n;
-    for(m = 0; m < OLED_LINES - 1; m++)  
-    {  
-        OLED_WriteCommand(0xb0 + m);//ҳַ0~6
-        OLED_WriteCommand(0x00);//ʾλáе͵ַ
-        OLED_WriteCommand(0x10);//ʾλáиߵַ   
-        for(n = 0; n < OLED_WIDTH; n++)
-        {
-            gRam[m][n] = gRam[m + 1][n];
-            OLED_WriteData(gRam[m][n]);
-        }
-    } //ʾ
-    OLED_ClearLine(7);
+    ringTop = (ringTop + 1) & (OLED_PAGES - 1);
+    OLED_ClearLine(OLED_LINES - 1);
+}
+
+/**
+ * @brief OLED_DisplayLog, һַԴ, ҪʱϹ
+ * @param context ,  @ref OLED_CursorTypedef
+ * @param character Ҫʾַ
+ */
+static void OLED_PutLog(void *context, char character)
+{
+    OLED_CursorTypedef *cursor = (OLED_CursorTypedef *)context;
+    switch(character)
+    {
+        case '\r':
+            cursor->x = 0;//س\rǻص
+            break;
+        case '\n':
+            if(!cursor->skipNewline && (++cursor->y > OLED_LINES - 1))//ʱ++y\n
+                cursor->linesScrollUp++;//к󳬳Ļײ, ϶һ
+            cursor->skipNewline = 0;//ٺ´λ
+            break;
+        case '\t':
+            cursor->skipNewline = 0;//β\tٺ\n, Ϊʱѵһ
+            cursor->x = tabLookUpTable[cursor->x];//ҵҪλ
+            if((cursor->x >= OLED_CHARACTERS_ONE_LINE - 1) && (cursor->x = 0, ++cursor->y > OLED_LINES - 1))//\t󳬹ұ߽
+                cursor->linesScrollUp++;//к󳬳Ļײ, ϶һ
+            break;
+        default://ǿַ, Ҫӡַ
+            cursor->skipNewline = 0;//βӡһַٺ\n, Ϊӡѵһ
+            while(cursor->linesScrollUp)//ϹҪ
+            {
+                OLED_ScrollUpOneLine();
+                cursor->linesScrollUp--;
+            }
+            //(x << 1) + (x << 2)x * 6, һַ6
+            OLED_DisplayCharacter((cursor->x << 1) + (cursor->x << 2), cursor->y > (OLED_LINES - 1) ? (OLED_LINES - 1) : cursor->y, character, 8);
+            if((++cursor->x == OLED_CHARACTERS_ONE_LINE) && (cursor->x = 0, cursor->skipNewline = 1, ++cursor->y > (OLED_LINES - 1)))//ס, βԶвһ\nз
+                cursor->linesScrollUp++;//к󳬳Ļײ, ϶һ
+            break;
+    }
 }
 
 /**
  * @brief ʾϢ
  * @param oledHandle oled,  @ref OLED_HandleTypedef
- * @param format ʽַ, ַֿ֧
+ * @param format ʽַ, ַֿ֧, ֵ֧ת˵oled_format.h
  * @param ... 㶮
  * @note ʾ, ϸַһ׿ʼӡ; ָλÿʼ
- *       Ϣʾʱԭʾһ,  CPUռø
+ *       Ϣʾʱԭʾһ, Ļʾʼ, ÿֻдһҳ
  *       ֧Զ, ֶзwindowsͬ(crlf)
+ *       ʾOLED_STRING_MAX_CHARACTERSַ
  */
 void OLED_DisplayLog(OLED_HandleTypedef *oledHandle, const char *format, ...)
 {
-    uint8_t x = 0;//ǰ(0~20)
-    uint16_t y = 0;//ǰ(0~7)
-    static uint8_t linesScrollUp = 0;//ԭҪϹ
-    static uint8_t needYPlus = 1;//βԶ\r\nظִֻһλ 0-\r\n
-    uint16_t i = 0;
+    OLED_CursorTypedef cursor;
     va_list aptr;
     
     if(oledHandle == NULL)
         return;
-    
-    va_start(aptr, format);
-    vsprintf(oledHandle->__string, format, aptr);
-    va_end(aptr);
+    OLED_BeginDraw();
 
     if(oledHandle->stringContinuous == ENABLE)
     {
-        x = oledHandle->__stringLastEndX;
-        y = oledHandle->__stringLastEndY;
+        cursor.x = oledHandle->__stringLastEndX;
+        cursor.y = oledHandle->__stringLastEndY;
     }
     else
     {
-        x = oledHandle->stringX;
-        y = oledHandle->stringY;
+        cursor.x = oledHandle->stringX;
+        cursor.y = oledHandle->stringY;
     }
+    cursor.skipNewline = oledHandle->__logSkipNewline;
+    cursor.linesScrollUp = oledHandle->__logLinesScrollUp;
     
-    while (oledHandle->__string[i] != '\0')
-    { 
-        switch(oledHandle->__string[i])
-        {
-            case '\r':
-                x = 0;//س\rǻص
-                break;
-            case '\n':
-                if(needYPlus && (++y > OLED_LINES - 1))//ʱ++y\n
-                    linesScrollUp++;//к󳬳Ļײ, ϶һ
-                needYPlus = 1;//ٺ´λ
-                break;
-            case '\t':
-                needYPlus = 1;//β\tٺ\n, Ϊʱѵһ
-                x = tabLookUpTable[x];//ҵҪλ
-                if((x >= OLED_CHARACTERS_ONE_LINE - 1) && (x = 0, ++y > OLED_LINES - 1))//\t󳬹ұ߽
-                    linesScrollUp++;//к󳬳Ļײ, ϶һ
-                break;
-            default://ǿַ, Ҫӡַ
-                needYPlus = 1;//βӡһַٺ\n, Ϊӡѵһ
-                while(linesScrollUp)//ϹҪ
-                {
-                    OLED_ScrollUpOneLine();
-                    linesScrollUp--;
-                }
-                //(x << 1) + (x << 2)x * 6, һַ6
-                OLED_DisplayCharacter((x << 1) + (x << 2), y > (OLED_LINES - 1) ? (OLED_LINES - 1) : y, oledHandle->__string[i], 8);
-                if((++x == OLED_CHARACTERS_ONE_LINE) && (x = needYPlus = 0, ++y > (OLED_LINES - 1)))//ס, βԶвһ\nз
-                    linesScrollUp++;//к󳬳Ļײ, ϶һ
-                break;
-        }
-        i++;
-    }
-    oledHandle->__stringLastEndX = x;
-    oledHandle->__stringLastEndY = y;
-}
-
-
-///**
-// * @brief ָλʾ
-// * @param positionX (0~127)
-// * @param positionY ҳ(0~7)
-// * @param number 
-// */
-//void OLED_DisplayChinese(uint8_t positionX, uint8_t positionY, uint8_t number)
-//{                      
-//    uint8_t i, address=0;
-//    OLED_SetPosition(positionX, positionY);    
-//    for(i = 0; i < 22; i++)
-//    {
-//        OLED_WriteData(Hzk[number << 1][i]);
-//        gRam[positionY][positionX + i] = Hzk[(number << 1) + 1][i];
-//        address += 1;
-//    }    
-//    OLED_SetPosition(positionX, positionY + 1);    
-//    for(i = 0; i < 16; i++)
-//    {    
-//        OLED_WriteData(Hzk[(number << 1) + 1][i]);
-//        gRam[positionY + 1][positionX + i] = Hzk[(number << 1) + 1][i];
-//        address += 1;
-//    }                    
-//}
-
-///**
-// * @brief ָλʾͼƬ
-// * @param positionX (0~127)
-// * @param positionY ҳ(0~7)
-// * @param width ͼƬ()
-// * @param width ͼƬ߶()
-// * @param picture ҪʾͼƬ
-// */
-//void OLED_DisplayPicture(uint8_t positionX, uint8_t positionY, uint8_t width, uint8_t height, uint8_t picture[])
-//{     
-//    uint32_t j = 0;
-//    uint8_t x, y;
-//    height += (positionY >> 3);
-//    uint8_t endY = !(height % 8) ?  (height >> 3) : ((height >> 3) + 1);
-//    uint8_t endX = positionX + width;
-//    for(y = positionY; y <= endY; y++)
-//    {
-//        OLED_SetPosition(positionX, y);
-//        for(x = positionX; x <= endX; x++)
-//        {
-//            OLED_WriteData(picture[j]);
-//            gRam[y][x] = picture[j];
-//            j++;
-//        }
-//    }
-//} 
+    va_start(aptr, format);
+    OLED_FormatV(OLED_PutLog, &cursor, OLED_STRING_MAX_CHARACTERS, format, aptr);
+    va_end(aptr);
+    oledHandle->__stringLastEndX = cursor.x;
+    oledHandle->__stringLastEndY = cursor.y;
+    oledHandle->__logSkipNewline = cursor.skipNewline;
+    oledHandle->__logLinesScrollUp = cursor.linesScrollUp;
+    OLED_EndDraw();
+}
+
+/**
+ * @brief жʾϢ, ʽ, OLED_ProcessLogʾ
+ * @param format ʽַ, ַֿ֧, ֵ֧ת˵oled_format.h
+ * @param ... 㶮
+ * @return 0-ɹ; 1-, Ϣ
+ * @note ʱ̶, ʹö, OLED_QUEUE_ITEM_SIZE - 1ַ
+ *       ֻһ(ͬһռȼļж), oled_queue.h
+ */
+uint8_t OLED_PostLog(const char *format, ...)
+{
+    va_list aptr;
+    uint8_t res;
+    va_start(aptr, format);
+    res = OLED_InsertQueueItemV(&oledLogQueue, format, aptr);
+    va_end(aptr);
+    return res;
+}
+
+static void OLED_ProcessLogItem(const char *item, void *context)
+{
+    OLED_DisplayLog((OLED_HandleTypedef *)context, "%s", item);
+}
+
+/**
+ * @brief ʾOLED_PostLogеϢ, ѭе
+ * @param oledHandle oled,  @ref OLED_HandleTypedef
+ */
+void OLED_ProcessLog(OLED_HandleTypedef *oledHandle)
+{
+    if(oledHandle == NULL)
+        return;
+    OLED_TraverseQueue(&oledLogQueue, OLED_ProcessLogItem, oledHandle);
+}
+
 
 
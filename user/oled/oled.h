@@ -1,7 +1,7 @@
 /**
  * @file    oled.h
  * @author  Miaow, Evk123
- * @version 0.1.0
+ * @version 0.12.0
  * @date    2018/10/05
  * @brief   
  *          This file provides functions to manage the following 
@@ -10,15 +10,36 @@
  *              2. Display formatted strings, pictures and Chinese characters
  *              3. Turn on/off the screen
  *              4. Show logs
+ *              5. Framebuffer with dirty region flush
+ *              6. Timer paced background refresh
+ *              7. Formatted text without vsprintf, see oled_format.h
+ *              8. Log entries posted from interrupts, see oled_queue.h
+ *              9. Bound value widgets, see oled_widget.h
+ *              10. Strip chart, see oled_chart.h
+ *              11. Pixel addressed text in any font
+ *              12. Compressed pictures and Chinese characters in flash, see oled_asset.h
+ *              13. 4-wire SPI with DMA instead of IIC
+ *              14. Text terminal with scrollback, see oled_terminal.h
  * @note
  *          Minimum version of source file:
- *              0.1.0
+ *              0.15.0
+ *          Define OLED_USE_SEPARATE_IIC to move the OLED off the IMU bus,
+ *          SCL/SDA are then OLED_IIC_SCL_PORT/OLED_IIC_SDA_PORT (PE2/PE3).
  *          Recommanded pin connection:
  *               
  *               PB8SCL     
  *               PB9SDA     
  *               
  *          STM32F407      0.96" OLED
+ *          Define OLED_USE_SPI for modules strapped to 4-wire SPI:
+ *               
+ *              PB13D0(SCK) 
+ *              PB15D1(MOSI)
+ *              PD10RES     
+ *              PB14DC      
+ *              PB12CS      
+ *               
+ *          STM32F407      0.96" OLED
  *          
  *          The source code repository is not available on GitHub now:
  *              https://github.com/3703781
@@ -36,8 +57,117 @@
 #include "bsp_iic.h"
 
 #define OLED_IIC_ADDRESS            0x78
+
+/**
+ * @brief OLEDʹõIIC
+ * @note ʱMPU6050Ĭ; ˢĻƳMPU6050FIFOȡ
+ */
+//#define OLED_USE_SEPARATE_IIC
+#define OLED_IIC_SCL_PORT           GPIOE
+#define OLED_IIC_SCL_PIN            GPIO_Pin_2
+#define OLED_IIC_SDA_PORT           GPIOE
+#define OLED_IIC_SDA_PIN            GPIO_Pin_3
+#define OLED_IIC_SPEED              IIC_SPEED_FAST
 #define	OLED_BRIGHTNESS             255
 
+/**
+ * @brief OLEDʹ4SPIIIC, SPI2DMA
+ * @note ģ躸4SPIģʽ, ûӦ, ʼʱRESŸλIIC̽
+ *       SCKԼ10MHz, 1KBԼ1ms, IICģʽԼ25ms; OLED_USE_SEPARATE_IIC
+ *       OLED_USE_BACKGROUND_REFRESHͬʱʱ, ÿδDMAжϽύ, ռCPU
+ */
+//#define OLED_USE_SPI
+#define OLED_SPI                    SPI2
+#define OLED_SPI_CLK                RCC_APB1Periph_SPI2
+#define OLED_SPI_GPIO_AF            GPIO_AF_SPI2
+#define OLED_SPI_PRESCALER          SPI_BaudRatePrescaler_4//APB1 42MHz, 4Ƶ10.5MHz; ߽ϳʱΪ8Ƶ
+#define OLED_SPI_SCK_PORT           GPIOB
+#define OLED_SPI_SCK_PIN            GPIO_Pin_13
+#define OLED_SPI_SCK_PINSOURCE      GPIO_PinSource13
+#define OLED_SPI_MOSI_PORT          GPIOB
+#define OLED_SPI_MOSI_PIN           GPIO_Pin_15
+#define OLED_SPI_MOSI_PINSOURCE     GPIO_PinSource15
+#define OLED_SPI_CS_PORT            GPIOB
+#define OLED_SPI_CS_PIN             GPIO_Pin_12
+#define OLED_SPI_DC_PORT            GPIOB
+#define OLED_SPI_DC_PIN             GPIO_Pin_14
+#define OLED_SPI_RES_PORT           GPIOD
+#define OLED_SPI_RES_PIN            GPIO_Pin_10
+#define OLED_SPI_GPIO_CLK_ALL       (RCC_AHB1Periph_GPIOB | RCC_AHB1Periph_GPIOD)
+//DMA, SPI2_TXDMA14ͨ0
+#define OLED_SPI_DMA_CLK            RCC_AHB1Periph_DMA1
+#define OLED_SPI_DMA_CHANNEL        DMA_Channel_0
+#define OLED_SPI_DMA_STREAM         DMA1_Stream4
+#define OLED_SPI_DMA_IRQCHANNEL     DMA1_Stream4_IRQn
+#define OLED_SPI_DMA_IRQHANDLER     DMA1_Stream4_IRQHandler
+#define OLED_SPI_DMA_IT_TC          DMA_IT_TCIF4
+#define OLED_SPI_DMA_IT_TE          DMA_IT_TEIF4
+#define OLED_SPI_DMA_FLAG_TE        DMA_FLAG_TEIF4
+#define OLED_SPI_DMA_FLAG_ALL       (DMA_FLAG_TCIF4 | DMA_FLAG_HTIF4 | DMA_FLAG_TEIF4 | DMA_FLAG_DMEIF4 | DMA_FLAG_FEIF4)
+
+/**
+ * @brief ƺֻ޸Դ, ӦóڵOLED_FlushѸĶˢµĻ
+ * @note ʱOLED_DisplayFormatȺǰԶOLED_Flush
+ */
+//#define OLED_USE_MANUAL_FLUSH
+/**
+ * @brief ˢһαȺϲˢ¶ֽ(ôڵݴĵַ)
+ * @note ҳϲһںഫֽڲʱͺϲ
+ */
+#define OLED_FLUSH_MERGE_BYTES      10
+
+/**
+ * @brief ̨ˢ: ʱÿ1/OLED_REFRESH_HZԴĸĶΪȼ첽䷢, ƺȴ
+ * @note ĬʹIIC_USE_HARDWAREIIC_USE_WAVEʱDMAжϷ, ռCPU; PendSVз
+ *       ÿһ֡ûлƺִʱƵڶ黺ٷ, ˺
+ *       OLED_USE_MANUAL_FLUSH, ʱжPendSVͬΪռȼ
+ */
+//#define OLED_USE_BACKGROUND_REFRESH
+#define OLED_REFRESH_HZ             20
+#define OLED_REFRESH_TIM            TIM7
+#define OLED_REFRESH_TIM_CLK        RCC_APB1Periph_TIM7
+#define OLED_REFRESH_IRQCHANNEL     TIM7_IRQn
+#define OLED_REFRESH_IRQHANDLER     TIM7_IRQHandler
+
+/**
+ * @brief OLED_DisplayFormat, OLED_DisplayLogһʾַ, ַ
+ * @note ֱַӻԴ, ûм仺, ֻһεõĺʱ
+ */
+#define OLED_STRING_MAX_CHARACTERS  255
+
+/**
+ * @brief OLED_BenchmarkGlyphs
+ */
+//#define OLED_USE_BENCHMARK
+#define OLED_BENCHMARK_GLYPHS       256//ÿβַ
+#define OLED_GLYPH_MAX_HEIGHT       24//ָ߼ϲ7λλҪŽ32λ
+
+/**
+ * @brief 
+ * @note ÿַռ(height + 7) / 8ҳ, ҳ, ÿҳwidthֽ, ֽڵλ
+ *       OLED_Font6x8, OLED_Font8x16Ϊ, Ҳ԰ʽԼ
+ */
+typedef struct {
+    uint8_t width;//ֿ()
+    uint8_t height;//ָ(, 1~OLED_GLYPH_MAX_HEIGHT)
+    uint8_t first;//һַ
+    uint8_t count;//ַ
+    const uint8_t *data;//
+}OLED_FontTypedef;
+
+/**
+ * @brief ַԴϷʽ
+ */
+typedef enum {
+    OLED_BLIT_COPY = 0,//ַڵľαַ
+    OLED_BLIT_OR,//ַֻ
+    OLED_BLIT_AND,//ַֻ
+    OLED_BLIT_XOR//ַȡ
+}OLED_BlitModeTypedef;
+
+extern const OLED_FontTypedef OLED_Font6x8;
+extern const OLED_FontTypedef OLED_Font8x16;
+
 /**
  * @brief oled
  * @note stringX, stringY, stringClear, stringContinuousΪ
@@ -55,7 +185,9 @@ typedef struct {
     uint8_t __stringLastBeignY;//ϴδӡַʼλ
     uint8_t __stringLastEndX;//ϴδӡַλ
     uint8_t __stringLastEndY;//ϴδӡַλ
-    char __string[100];//ʵʴӡַ
+    uint8_t __stringSkipNewline;//OLED_DisplayFormatβԶ, Խŵ\n
+    uint8_t __logSkipNewline;//OLED_DisplayLogβԶ, Խŵ\n
+    uint8_t __logLinesScrollUp;//OLED_DisplayLogûִеϹ
 }OLED_HandleTypedef;
 
 void OLED_Init(OLED_HandleTypedef *oledHandle);
@@ -65,5 +197,16 @@ void OLED_Clear(OLED_HandleTypedef *oledHandle);
 void OLED_Blank(void);
 void OLED_DisplayFormat(OLED_HandleTypedef *oledHandle, const char *format, ...);
 void OLED_DisplayLog(OLED_HandleTypedef *oledHandle, const char *format, ...);
+uint8_t OLED_PostLog(const char *format, ...);
+void OLED_ProcessLog(OLED_HandleTypedef *oledHandle);
+void OLED_Flush(void);
+void OLED_BeginDraw(void);
+void OLED_EndDraw(void);
+void OLED_DisplayCell(uint8_t column, uint8_t line, char character);
+void OLED_DisplayColumn(uint8_t positionX, uint8_t line, uint8_t lines, const uint8_t *column);
+void OLED_DisplayRow(uint8_t positionX, uint8_t line, uint8_t width, const uint8_t *row);
+void OLED_DrawGlyph(int16_t positionX, int16_t positionY, const OLED_FontTypedef *font, char character, OLED_BlitModeTypedef mode);
+int16_t OLED_DrawString(int16_t positionX, int16_t positionY, const OLED_FontTypedef *font, const char *string, OLED_BlitModeTypedef mode);
+uint32_t OLED_BenchmarkGlyphs(const OLED_FontTypedef *font, uint8_t shift, OLED_BlitModeTypedef mode);
 
 #endif 
@@ -0,0 +1,210 @@
+/**
+ * @file    oled_asset.c
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2026/10/16
+ * @brief
+ *          This file provides functions to manage the following
+ *          functionalities of compressed OLED assets:
+ *              1. Pictures and fonts kept in flash, RLE and column-delta compressed
+ *              2. Streaming decoder into the framebuffer
+ *              3. LRU cache of decoded glyphs
+ * @note
+ *          Minimum version of header file:
+ *              0.1.0
+ *          Stream format, written by tools/oledasset:
+ *              0x00~0x7F n: n + 1 literal bytes follow
+ *              0x80~0xFF n: the next byte is repeated (n & 0x7F) + 2 times
+ *          A decoded byte is XORed with the previous column of the same page.
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#include "oled_asset.h"
+#include "stddef.h"
+
+#define OLED_ASSET_ROW_BYTES        128//Ļ, һν
+
+/**
+ * @brief ַ
+ */
+static struct {
+    const OLED_CompressedFontTypedef *font;//ΪNULLʾ
+    uint16_t index;//ַ
+    uint32_t used;//һʹõʱ
+    uint8_t data[OLED_ASSET_CACHE_BYTES];
+}glyphCache[OLED_ASSET_CACHE_SIZE];
+static uint32_t glyphClock = 0;//ÿβҼ1
+static uint32_t cacheHits = 0, cacheMisses = 0;
+
+/**
+ * @brief ʼ
+ * @param decoder ״̬
+ * @param data ѹ
+ * @param size ѹݵֽ
+ * @param width ÿҳ
+ */
+void OLED_AssetBegin(OLED_AssetDecoderTypedef *decoder, const uint8_t *data, uint16_t size, uint8_t width)
+{
+    decoder->data = data;
+    decoder->end = data + size;
+    decoder->run = 0;
+    decoder->repeat = 0;
+    decoder->previous = 0;
+    decoder->width = width;
+    decoder->column = 0;
+}
+
+/**
+ * @brief ֽ
+ * @param decoder ״̬
+ * @param buffer , ҳŵĵ
+ * @param len Ҫֽ
+ * @return ֽ, ѹݽʱСlen
+ */
+uint16_t OLED_AssetRead(OLED_AssetDecoderTypedef *decoder, uint8_t *buffer, uint16_t len)
+{
+    uint16_t n;
+    uint8_t control, delta;
+    for(n = 0; n < len; n++)
+    {
+        if(!decoder->run)
+        {
+            if(decoder->data >= decoder->end)
+                break;
+            control = *decoder->data++;
+            decoder->repeat = control >> 7;
+            if(decoder->repeat)
+            {
+                decoder->run = (control & 0x7F) + 2;
+                decoder->value = *decoder->data++;
+            }
+            else
+                decoder->run = control + 1;
+        }
+        delta = decoder->repeat ? decoder->value : *decoder->data++;
+        decoder->run--;
+        decoder->previous = delta ^ (decoder->column ? decoder->previous : 0);
+        buffer[n] = decoder->previous;
+        if(++decoder->column == decoder->width)
+            decoder->column = 0;
+    }
+    return n;
+}
+
+/**
+ * @brief ָλʾͼƬ
+ * @param positionX (0~127)
+ * @param positionY ҳ(0~7)
+ * @param picture ҪʾͼƬ,  @ref OLED_AssetTypedef
+ * @note ÿνһҳдԴ, ĻĲֲõ;
+ *       һҳĻʱֶν, һ֮һĻ, 󶪵
+ */
+void OLED_DisplayPicture(uint8_t positionX, uint8_t positionY, const OLED_AssetTypedef *picture)
+{
+    OLED_AssetDecoderTypedef decoder;
+    uint8_t row[OLED_ASSET_ROW_BYTES];
+    uint8_t page, n;
+    uint16_t column;
+    OLED_AssetBegin(&decoder, picture->data, picture->size, picture->width);
+    OLED_BeginDraw();
+    for(page = 0; page < picture->pages; page++)
+    {
+        for(column = 0; column < picture->width; column += n)
+        {
+            n = picture->width - column > OLED_ASSET_ROW_BYTES ? OLED_ASSET_ROW_BYTES : picture->width - column;
+            if(OLED_AssetRead(&decoder, row, n) < n)
+                break;
+            if(!column)
+                OLED_DisplayRow(positionX, positionY + page, n, row);
+        }
+        if(column < picture->width)
+            break;
+    }
+    OLED_EndDraw();
+}
+
+/**
+ * @brief һһַ
+ * @return ĵ, ַЧʱNULL
+ * @note ûлʱ滻ûʹõһ
+ */
+static const uint8_t *OLED_AssetGlyph(const OLED_CompressedFontTypedef *font, uint16_t index)
+{
+    OLED_AssetDecoderTypedef decoder;
+    uint8_t i, victim = 0;
+    uint16_t bytes = ((font->height + 7) >> 3) * font->width;
+    if(index >= font->count || bytes > OLED_ASSET_CACHE_BYTES)
+        return NULL;
+    glyphClock++;
+    for(i = 0; i < OLED_ASSET_CACHE_SIZE; i++)
+    {
+        if(glyphCache[i].font == font && glyphCache[i].index == index)
+        {
+            glyphCache[i].used = glyphClock;
+            cacheHits++;
+            return glyphCache[i].data;
+        }
+        if(!glyphCache[i].font)
+            victim = i;
+        else if(glyphCache[victim].font && glyphCache[i].used < glyphCache[victim].used)
+            victim = i;
+    }
+    cacheMisses++;
+    OLED_AssetBegin(&decoder, font->data + font->offsets[index], font->offsets[index + 1] - font->offsets[index], font->width);
+    OLED_AssetRead(&decoder, glyphCache[victim].data, bytes);
+    glyphCache[victim].font = font;
+    glyphCache[victim].index = index;
+    glyphCache[victim].used = glyphClock;
+    return glyphCache[victim].data;
+}
+
+/**
+ * @brief λûѹеһַ
+ * @param positionX , Ϊ򳬳Ļ, Ĳֲõ
+ * @param positionY (), Ϊ򳬳Ļ, Ĳֲõ
+ * @param font ,  @ref OLED_CompressedFontTypedef
+ * @param index ַ
+ * @param mode ԴϷʽ,  @ref OLED_BlitModeTypedef
+ */
+void OLED_DrawCompressedGlyph(int16_t positionX, int16_t positionY, const OLED_CompressedFontTypedef *font, uint16_t index, OLED_BlitModeTypedef mode)
+{
+    OLED_FontTypedef glyph;
+    const uint8_t *data = OLED_AssetGlyph(font, index);
+    if(data == NULL)
+        return;
+    glyph.width = font->width;
+    glyph.height = font->height;
+    glyph.first = 0;
+    glyph.count = 1;
+    glyph.data = data;
+    OLED_DrawGlyph(positionX, positionY, &glyph, 0, mode);
+}
+
+/**
+ * @brief ָλʾ
+ * @param positionX (0~127)
+ * @param positionY ҳ(0~7)
+ * @param number , oled_font.hеHzk
+ */
+void OLED_DisplayChinese(uint8_t positionX, uint8_t positionY, uint8_t number)
+{
+    OLED_DrawCompressedGlyph(positionX, positionY << 3, &OLED_FontHzk, number, OLED_BLIT_COPY);
+}
+
+/**
+ * @brief ȡַкδд
+ * @param hits д
+ * @param misses δ()
+ */
+void OLED_AssetCacheStatistics(uint32_t *hits, uint32_t *misses)
+{
+    *hits = cacheHits;
+    *misses = cacheMisses;
+}
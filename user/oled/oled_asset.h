@@ -0,0 +1,86 @@
+/**
+ * @file    oled_asset.h
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2026/10/16
+ * @brief
+ *          This file provides functions to manage the following
+ *          functionalities of compressed OLED assets:
+ *              1. Pictures and fonts kept in flash, RLE and column-delta compressed
+ *              2. Streaming decoder into the framebuffer
+ *              3. LRU cache of decoded glyphs
+ * @note
+ *          Minimum version of source file:
+ *              0.1.0
+ *          Assets are generated by tools/oledasset from page-major bitmaps:
+ *          every byte is XORed with the byte of the previous column of the
+ *          same page, then the result is run-length encoded.
+ *          A picture is decoded one page at a time into a buffer on the stack.
+ *          Glyphs are compressed one by one and decoded into a cache of
+ *          OLED_ASSET_CACHE_SIZE entries, repeated characters are then drawn
+ *          without decoding.
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#ifndef __OLED_ASSET_H
+#define __OLED_ASSET_H
+
+#include "stm32f4xx.h"
+#include "oled.h"
+
+#define OLED_ASSET_CACHE_SIZE       8//ַ
+#define OLED_ASSET_CACHE_BYTES      32//һַֽ, 16x16Ϊ32
+
+/**
+ * @brief ѹͼƬ
+ */
+typedef struct {
+    uint8_t width;//()
+    uint8_t pages;//߶(ҳ)
+    uint16_t size;//ѹݵֽ
+    const uint8_t *data;//ѹ
+}OLED_AssetTypedef;
+
+/**
+ * @brief ѹ, ÿַѹ
+ */
+typedef struct {
+    uint8_t width;//ֿ()
+    uint8_t height;//ָ()
+    uint16_t count;//ַ
+    const uint16_t *offsets;//ÿַѹdataеλ, count + 1
+    const uint8_t *data;//ѹ
+}OLED_CompressedFontTypedef;
+
+/**
+ * @brief ״̬
+ */
+typedef struct {
+    const uint8_t *data;//һѹֽ
+    const uint8_t *end;//ѹݵĽβ
+    uint8_t run;//ǰʣֽ
+    uint8_t repeat;//1-ǰظvalue; 0-ǰԭֽ
+    uint8_t value;//ظεֽ
+    uint8_t previous;//һеֽ
+    uint8_t width;//ÿҳ
+    uint8_t column;//һֽڵ
+}OLED_AssetDecoderTypedef;
+
+extern const OLED_AssetTypedef OLED_PictureBmp1;
+extern const OLED_CompressedFontTypedef OLED_FontHzk;
+
+void OLED_AssetBegin(OLED_AssetDecoderTypedef *decoder, const uint8_t *data, uint16_t size, uint8_t width);
+uint16_t OLED_AssetRead(OLED_AssetDecoderTypedef *decoder, uint8_t *buffer, uint16_t len);
+void OLED_DisplayPicture(uint8_t positionX, uint8_t positionY, const OLED_AssetTypedef *picture);
+void OLED_DrawCompressedGlyph(int16_t positionX, int16_t positionY, const OLED_CompressedFontTypedef *font, uint16_t index, OLED_BlitModeTypedef mode);
+void OLED_DisplayChinese(uint8_t positionX, uint8_t positionY, uint8_t number);
+void OLED_AssetCacheStatistics(uint32_t *hits, uint32_t *misses);
+
+#endif
@@ -1,80 +1,42 @@
 //////////////////////////////////////////////////////////////////////////////////	 
 //
 //
-//洢ͼƬݣͼƬСΪ64*32
+//洢ͼƬݣͼƬСΪ128*64, ѹ, tools/oledassetoled_asset.c
 //
 /////////////////////////////////////////////////////////////////////////////////
 
 #ifndef __BMP_H
 #define __BMP_H
-unsigned char BMP1[] =
-{0x00,0x06,0x0A,0xFE,0x0A,0xC6,0x00,0xE0,0x00,0xF0,0x00,0xF8,0x00,0x00,0x00,0x00,
-0x00,0x00,0xFE,0x7D,0xBB,0xC7,0xEF,0xEF,0xEF,0xEF,0xEF,0xEF,0xEF,0xC7,0xBB,0x7D,
-0xFE,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x08,
-0x0C,0xFE,0xFE,0x0C,0x08,0x20,0x60,0xFE,0xFE,0x60,0x20,0x00,0x00,0x00,0x78,0x48,
-0xFE,0x82,0xBA,0xBA,0x82,0xBA,0xBA,0x82,0xBA,0xBA,0x82,0xBA,0xBA,0x82,0xFE,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFE,0xFF,
-0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0xFF,0xFF,0x00,0x00,0xFE,0xFF,0x03,
-0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0xFF,0xFE,0x00,0x00,0x00,0x00,0xC0,0xC0,
-0xC0,0x00,0x00,0x00,0x00,0xFE,0xFF,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,
-0xFF,0xFE,0x00,0x00,0xFE,0xFF,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0xFF,
-0xFE,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFF,0xFF,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFF,0xFF,0x00,0x00,0xFF,0xFF,0x0C,
-0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0xFF,0xFF,0x00,0x00,0x00,0x00,0xE1,0xE1,
-0xE1,0x00,0x00,0x00,0x00,0xFF,0xFF,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0xFF,0xFF,0x00,0x00,0xFF,0xFF,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0xFF,
-0xFF,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x0F,0x1F,
-0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x1F,0x0F,0x00,0x00,0x0F,0x1F,0x18,
-0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x1F,0x0F,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x0F,0x1F,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18,
-0x1F,0x0F,0x00,0x00,0x0F,0x1F,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x1F,
-0x0F,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x8C,0x42,0x22,0x12,0x0C,0x00,0xFC,0x02,0x02,0x02,0xFC,0x00,0x00,0x04,
-0xFE,0x00,0x00,0x00,0x20,0x58,0x44,0xFE,0x40,0x00,0x10,0x10,0x10,0x10,0x10,0x00,
-0x00,0x04,0xFE,0x00,0x00,0x00,0xFC,0x02,0x02,0x02,0xFC,0x00,0x10,0x10,0x10,0x10,
-0x10,0x00,0xFC,0x02,0x02,0x02,0xFC,0x00,0x00,0x04,0xFE,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x24,0xA4,0x2E,0x24,0xE4,0x24,0x2E,0xA4,0x24,0x00,0x00,0x00,0xF8,0x4A,0x4C,
-0x48,0xF8,0x48,0x4C,0x4A,0xF8,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x01,0x01,0x01,0x01,0x01,0x00,0x00,0x01,0x01,0x01,0x00,0x00,0x00,0x01,
-0x01,0x01,0x00,0x00,0x00,0x00,0x00,0x01,0x01,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x01,0x01,0x01,0x00,0x00,0x00,0x01,0x01,0x01,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x01,0x01,0x01,0x00,0x00,0x00,0x01,0x01,0x01,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xC0,0x20,0x10,0x10,
-0x10,0x10,0x20,0xC0,0x00,0x00,0xC0,0x20,0x10,0x10,0x10,0x10,0x20,0xC0,0x00,0x00,
-0x00,0x12,0x0A,0x07,0x02,0x7F,0x02,0x07,0x0A,0x12,0x00,0x00,0x00,0x0B,0x0A,0x0A,
-0x0A,0x7F,0x0A,0x0A,0x0A,0x0B,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x1F,0x20,0x40,0x40,
-0x40,0x50,0x20,0x5F,0x80,0x00,0x1F,0x20,0x40,0x40,0x40,0x50,0x20,0x5F,0x80,0x00,/*"C:\Users\evk\Desktop\??2014.bmp",0*/
-
+//1024 bytes compressed to 424 bytes, 128 x 64 pixels
+const unsigned char BMP1[424] = {
+    0x0C,0x00,0x06,0x0C,0xF4,0xF4,0xCC,0xC6,0xE0,0xE0,0xF0,0xF0,0xF8,0xF8,0x83,0x00,
+    0x04,0xFE,0x83,0xC6,0x7C,0x28,0x84,0x00,0x04,0x28,0x7C,0xC6,0x83,0xFE,0xBB,0x00,
+    0x20,0x08,0x04,0xF2,0x00,0xF2,0x04,0x28,0x40,0x9E,0x00,0x9E,0x40,0x20,0x00,0x00,
+    0x78,0x30,0xB6,0x7C,0x38,0x00,0x38,0x38,0x00,0x38,0x38,0x00,0x38,0x38,0x00,0x38,
+    0x7C,0xFE,0x91,0x00,0x00,0x01,0x8A,0x00,0x00,0x01,0xFB,0x00,0x02,0xFE,0x01,0xFC,
+    0x86,0x00,0x06,0xFC,0x00,0xFF,0x00,0xFE,0x01,0xFC,0x86,0x00,0x02,0xFC,0x01,0xFE,
+    0x81,0x00,0x03,0xC0,0x00,0x00,0xC0,0x81,0x00,0x02,0xFE,0x01,0xFC,0x86,0x00,0x06,
+    0xFC,0x01,0xFE,0x00,0xFE,0x01,0xFC,0x86,0x00,0x02,0xFC,0x01,0xFE,0xBA,0x00,0x02,
+    0xFF,0x00,0xFF,0x86,0x00,0x06,0xFF,0x00,0xFF,0x00,0xFF,0x00,0xF3,0x86,0x00,0x02,
+    0xF3,0x00,0xFF,0x81,0x00,0x03,0xE1,0x00,0x00,0xE1,0x81,0x00,0x02,0xFF,0x00,0xFF,
+    0x86,0x00,0x06,0xFF,0x00,0xFF,0x00,0xFF,0x00,0xF3,0x86,0x00,0x02,0xF3,0x00,0xFF,
+    0xBA,0x00,0x02,0x0F,0x10,0x07,0x86,0x00,0x06,0x07,0x10,0x0F,0x00,0x0F,0x10,0x07,
+    0x86,0x00,0x02,0x07,0x10,0x0F,0x88,0x00,0x02,0x0F,0x10,0x07,0x86,0x00,0x06,0x07,
+    0x10,0x0F,0x00,0x0F,0x10,0x07,0x86,0x00,0x02,0x07,0x10,0x0F,0xBE,0x00,0x18,0x8C,
+    0xCE,0x60,0x30,0x1E,0x0C,0xFC,0xFE,0x00,0x00,0xFE,0xFC,0x00,0x04,0xFA,0xFE,0x00,
+    0x00,0x20,0x78,0x1C,0xBA,0xBE,0x40,0x10,0x82,0x00,0x0D,0x10,0x00,0x04,0xFA,0xFE,
+    0x00,0x00,0xFC,0xFE,0x00,0x00,0xFE,0xFC,0x10,0x82,0x00,0x0A,0x10,0xFC,0xFE,0x00,
+    0x00,0xFE,0xFC,0x00,0x04,0xFA,0xFE,0xA3,0x00,0x15,0x24,0x80,0x8A,0x0A,0xC0,0xC0,
+    0x0A,0x8A,0x80,0x24,0x00,0x00,0xF8,0xB2,0x06,0x04,0xB0,0xB0,0x04,0x06,0xB2,0xF8,
+    0x89,0x00,0x00,0x01,0x82,0x00,0x0B,0x01,0x00,0x01,0x00,0x00,0x01,0x00,0x00,0x01,
+    0x00,0x00,0x01,0x82,0x00,0x02,0x01,0x00,0x01,0x85,0x00,0x09,0x01,0x00,0x00,0x01,
+    0x00,0x00,0x01,0x00,0x00,0x01,0x86,0x00,0x09,0x01,0x00,0x00,0x01,0x00,0x00,0x01,
+    0x00,0x00,0x01,0x8D,0x00,0x02,0xC0,0xE0,0x30,0x81,0x00,0x06,0x30,0xE0,0xC0,0x00,
+    0xC0,0xE0,0x30,0x81,0x00,0x1A,0x30,0xE0,0xC0,0x00,0x00,0x12,0x18,0x0D,0x05,0x7D,
+    0x7D,0x05,0x0D,0x18,0x12,0x00,0x00,0x0B,0x01,0x00,0x00,0x75,0x75,0x00,0x00,0x01,
+    0x0B,0xD3,0x00,0x13,0x1F,0x3F,0x60,0x00,0x00,0x10,0x70,0x7F,0xDF,0x80,0x1F,0x3F,
+    0x60,0x00,0x00,0x10,0x70,0x7F,0xDF,0x80
 };
-
 #endif
 
 
@@ -0,0 +1,143 @@
+/**
+ * @file    oled_chart.c
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2026/10/16
+ * @brief
+ *          This file provides functions to manage the following
+ *          functionalities of the OLED strip chart:
+ *              1. Plot one or two signals
+ *              2. One column per sample in a sweeping ring
+ *              3. Auto-scaling without redrawing old columns
+ * @note
+ *          Minimum version of header file:
+ *              0.1.0
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#include "oled_chart.h"
+#include "oled.h"
+
+/**
+ * @brief Ϊ
+ * @return , 0ڵײ, Χʱȡ߽
+ */
+static uint8_t OLED_ChartScale(const OLED_ChartTypedef *chart, int32_t sample)
+{
+    uint8_t height = chart->lines << 3;
+    if(sample <= chart->min)
+        return 0;
+    if(sample >= chart->max)
+        return height - 1;
+    return (uint8_t)((int64_t)((int64_t)sample - chart->min) * (height - 1) / ((int64_t)chart->max - chart->min));
+}
+
+/**
+ * @brief һеy0y1
+ * @param column ÿһֽ, λ
+ */
+static void OLED_ChartSegment(const OLED_ChartTypedef *chart, uint8_t *column, uint8_t y0, uint8_t y1)
+{
+    uint8_t height = chart->lines << 3, row, y;
+    if(y0 > y1)
+    {
+        y = y0;
+        y0 = y1;
+        y1 = y;
+    }
+    for(y = y0; y <= y1; y++)
+    {
+        row = height - 1 - y;
+        column[row >> 3] |= 1 << (row & 7);
+    }
+}
+
+/**
+ * @brief ѷΧΪ[low, high], ߸1/8
+ */
+static void OLED_ChartFit(OLED_ChartTypedef *chart, int32_t low, int32_t high)
+{
+    int64_t margin = (((int64_t)high - low) >> 3) + 1;
+    chart->min = low - margin < INT32_MIN ? INT32_MIN : (int32_t)(low - margin);
+    chart->max = high + margin > INT32_MAX ? INT32_MAX : (int32_t)(high + margin);
+}
+
+/**
+ * @brief һ, ڹڵвһ
+ * @param chart ͼ
+ * @param sample0 0Ĳ
+ * @param sample1 1Ĳ, signalsΪ1ʱ
+ * @note ÿֻ޸Դ, ʱ޹
+ */
+void OLED_ChartAddSample(OLED_ChartTypedef *chart, int32_t sample0, int32_t sample1)
+{
+    uint8_t column[OLED_CHART_MAX_LINES] = {0}, blank[OLED_CHART_MAX_LINES] = {0};
+    int32_t samples[2];
+    uint8_t i, y, next;
+
+    samples[0] = sample0;
+    samples[1] = sample1;
+    if(chart->min >= chart->max)//ûиΧʱɵһ
+        OLED_ChartFit(chart, sample0, sample0);
+    for(i = 0; i < chart->signals && i < 2; i++)
+    {
+        if(chart->autoScale)
+        {
+            if(samples[i] < chart->__sweepMin)
+                chart->__sweepMin = samples[i];
+            if(samples[i] > chart->__sweepMax)
+                chart->__sweepMax = samples[i];
+            if(samples[i] < chart->min)//Χʱ
+                OLED_ChartFit(chart, samples[i], chart->max);
+            else if(samples[i] > chart->max)
+                OLED_ChartFit(chart, chart->min, samples[i]);
+        }
+        y = OLED_ChartScale(chart, samples[i]);
+        //0һ, 1ֻ
+        OLED_ChartSegment(chart, column, i == 0 && chart->__started ? chart->__lastY[0] : y, y);
+        chart->__lastY[i] = y;
+    }
+    chart->__started = 1;
+
+    next = chart->__cursor + 1 >= chart->width ? 0 : chart->__cursor + 1;
+    OLED_BeginDraw();
+    OLED_DisplayColumn(chart->positionX + chart->__cursor, chart->line, chart->lines, column);
+    if(next != chart->__cursor)
+        OLED_DisplayColumn(chart->positionX + next, chart->line, chart->lines, blank);
+    OLED_EndDraw();
+    chart->__cursor = next;
+
+    if(!next)//һɨ, һֵĲΧ
+    {
+        chart->__started = 0;//˱, һвһ
+        if(chart->autoScale && chart->__sweepMin <= chart->__sweepMax)
+            OLED_ChartFit(chart, chart->__sweepMin, chart->__sweepMax);
+        chart->__sweepMin = INT32_MAX;
+        chart->__sweepMax = INT32_MIN;
+    }
+}
+
+/**
+ * @brief ͼ, ص
+ * @param chart ͼ
+ */
+void OLED_ChartClear(OLED_ChartTypedef *chart)
+{
+    uint8_t blank[OLED_CHART_MAX_LINES] = {0};
+    uint8_t i;
+    OLED_BeginDraw();
+    for(i = 0; i < chart->width; i++)
+        OLED_DisplayColumn(chart->positionX + i, chart->line, chart->lines, blank);
+    OLED_EndDraw();
+    chart->__cursor = 0;
+    chart->__started = 0;
+    chart->__sweepMin = INT32_MAX;
+    chart->__sweepMax = INT32_MIN;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file    oled_chart.h
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2026/10/16
+ * @brief
+ *          This file provides functions to manage the following
+ *          functionalities of the OLED strip chart:
+ *              1. Plot one or two signals
+ *              2. One column per sample in a sweeping ring
+ *              3. Auto-scaling without redrawing old columns
+ * @note
+ *          Minimum version of source file:
+ *              0.1.0
+ *          The chart is drawn like a sweeping oscilloscope: each sample
+ *          overwrites the column at the cursor and blanks the next one, so a
+ *          sample changes two columns of gRam and the flush sends a two column
+ *          0x21/0x22 window no matter how wide the chart is.
+ *          Signal 0 is drawn as a continuous line, signal 1 as dots.
+ *          With autoScale the range grows at once when a sample leaves it, and
+ *          is fitted to the samples of the last sweep when the cursor wraps.
+ *          Columns already drawn keep their old scale until overwritten.
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#ifndef __OLED_CHART_H
+#define __OLED_CHART_H
+
+#include "stm32f4xx.h"
+
+#define OLED_CHART_MAX_LINES        8
+
+/**
+ * @brief ͼ
+ * @note positionX, width, line, lines, signals, min, max, autoScaleΪ
+ */
+typedef struct {
+    uint8_t positionX;//ʼ(0~127)
+    uint8_t width;//(), ʾĲ
+    uint8_t line;//ʼ(0~7)
+    uint8_t lines;//ռõ(1~8), ߶Ϊlines * 8
+    uint8_t signals;//, 12
+    int32_t min;//
+    int32_t max;//
+    uint8_t autoScale;//1-Զ귶Χ; 0-̶, ΧĲڱ߽
+    uint8_t __cursor;//һڵ
+    uint8_t __started;//Ѿ, __lastYЧ
+    uint8_t __lastY[2];//һ(, 0ڵײ)
+    int32_t __sweepMin;//ɨС
+    int32_t __sweepMax;//ɨ
+}OLED_ChartTypedef;
+
+/**
+ * @brief ͼʼֵ
+ */
+#define OLED_CHART_INIT(positionX, width, line, lines, signals, min, max, autoScale) \
+    {(positionX), (width), (line), (lines), (signals), (min), (max), (autoScale), 0, 0, {0, 0}, INT32_MAX, INT32_MIN}
+
+void OLED_ChartAddSample(OLED_ChartTypedef *chart, int32_t sample0, int32_t sample1);
+void OLED_ChartClear(OLED_ChartTypedef *chart);
+
+#endif
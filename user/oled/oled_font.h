@@ -200,52 +200,41 @@ const unsigned char F8X16[]=
   0x00,0x02,0x02,0x7C,0x80,0x00,0x00,0x00,0x00,0x40,0x40,0x3F,0x00,0x00,0x00,0x00,//} 93
   0x00,0x06,0x01,0x01,0x02,0x02,0x04,0x04,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,//~ 94
 };
-char Hzk[][32]={
-
-{0x00,0x00,0xF0,0x10,0x10,0x10,0x10,0xFF,0x10,0x10,0x10,0x10,0xF0,0x00,0x00,0x00},
-{0x00,0x00,0x0F,0x04,0x04,0x04,0x04,0xFF,0x04,0x04,0x04,0x04,0x0F,0x00,0x00,0x00},/*"",0*/
-
-{0x40,0x40,0x40,0x5F,0x55,0x55,0x55,0x75,0x55,0x55,0x55,0x5F,0x40,0x40,0x40,0x00},
-{0x00,0x40,0x20,0x0F,0x09,0x49,0x89,0x79,0x09,0x09,0x09,0x0F,0x20,0x40,0x00,0x00},/*"",1*/
-
-{0x00,0xFE,0x02,0x42,0x4A,0xCA,0x4A,0x4A,0xCA,0x4A,0x4A,0x42,0x02,0xFE,0x00,0x00},
-{0x00,0xFF,0x40,0x50,0x4C,0x43,0x40,0x40,0x4F,0x50,0x50,0x5C,0x40,0xFF,0x00,0x00},/*"԰",2*/
-
-{0x00,0x00,0xF8,0x88,0x88,0x88,0x88,0xFF,0x88,0x88,0x88,0x88,0xF8,0x00,0x00,0x00},
-{0x00,0x00,0x1F,0x08,0x08,0x08,0x08,0x7F,0x88,0x88,0x88,0x88,0x9F,0x80,0xF0,0x00},/*"",3*/
-
-{0x80,0x82,0x82,0x82,0x82,0x82,0x82,0xE2,0xA2,0x92,0x8A,0x86,0x82,0x80,0x80,0x00},
-{0x00,0x00,0x00,0x00,0x00,0x40,0x80,0x7F,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},/*"",4*/
-
-{0x24,0x24,0xA4,0xFE,0xA3,0x22,0x00,0x22,0xCC,0x00,0x00,0xFF,0x00,0x00,0x00,0x00},
-{0x08,0x06,0x01,0xFF,0x00,0x01,0x04,0x04,0x04,0x04,0x04,0xFF,0x02,0x02,0x02,0x00},/*"",5*/
-
-{0x10,0x10,0x10,0xFF,0x10,0x90,0x08,0x88,0x88,0x88,0xFF,0x88,0x88,0x88,0x08,0x00},
-{0x04,0x44,0x82,0x7F,0x01,0x80,0x80,0x40,0x43,0x2C,0x10,0x28,0x46,0x81,0x80,0x00},/*"?",0*/
-
-{0x40,0x40,0x48,0x48,0x48,0xC8,0x78,0x4F,0x48,0x48,0x48,0x48,0x48,0x40,0x40,0x00},
-{0x00,0x00,0x00,0x00,0x03,0x12,0x12,0x22,0x22,0x52,0x8A,0x06,0x00,0x00,0x00,0x00},/*"ר",0*/
-
-{0x00,0x10,0x60,0x80,0x00,0xFF,0x00,0x00,0x00,0xFF,0x00,0x00,0xC0,0x30,0x00,0x00},
-{0x40,0x40,0x40,0x43,0x40,0x7F,0x40,0x40,0x40,0x7F,0x42,0x41,0x40,0x40,0x40,0x00},/*"ҵ",1*/
-
-{0x10,0x10,0x10,0xFF,0x10,0x90,0x08,0x88,0x88,0x88,0xFF,0x88,0x88,0x88,0x08,0x00},
-{0x04,0x44,0x82,0x7F,0x01,0x80,0x80,0x40,0x43,0x2C,0x10,0x28,0x46,0x81,0x80,0x00},/*"",2*/
-
-{0x00,0x10,0x10,0x10,0x10,0xD0,0x30,0xFF,0x30,0xD0,0x12,0x1C,0x10,0x10,0x00,0x00},
-{0x10,0x08,0x04,0x02,0x01,0x00,0x00,0xFF,0x00,0x00,0x01,0x02,0x04,0x08,0x10,0x00},/*"",3*/
-
-{0x00,0x00,0xFE,0x22,0x22,0x22,0xFE,0x00,0xFE,0x82,0x82,0x92,0xA2,0x9E,0x00,0x00},
-{0x80,0x60,0x1F,0x02,0x42,0x82,0x7F,0x00,0xFF,0x40,0x2F,0x10,0x2C,0x43,0x80,0x00},/*"",4*/
-
-{0x00,0x00,0x90,0x88,0x4C,0x57,0xA4,0x24,0x54,0x54,0x8C,0x84,0x00,0x00,0x00,0x00},
-{0x01,0x01,0x80,0x42,0x22,0x1A,0x07,0x02,0x42,0x82,0x42,0x3E,0x01,0x01,0x01,0x00},/*"",5*/
-
-{0x00,0x04,0xE4,0x24,0x2C,0xB4,0x25,0x26,0x24,0xB4,0x2C,0x24,0xE4,0x04,0x00,0x00},
-{0x00,0x00,0xFF,0x02,0x01,0x1E,0x12,0x12,0x12,0x1E,0x41,0x82,0x7F,0x00,0x00,0x00},/*"",6*/
-
-
-
+//16x16, ѹ, tools/oledassetoled_asset.c
+//0 1 2԰ 3 4 5 6? 7ר 8ҵ 9 10 11 12 13
+//448 bytes compressed to 444 bytes, 16 x 16 pixels per glyph
+const unsigned char Hzk[444] = {
+    0x80,0x00,0x01,0xF0,0xE0,0x81,0x00,0x80,0xEF,0x81,0x00,0x01,0xE0,0xF0,0x82,0x00,
+    0x01,0x0F,0x0B,0x81,0x00,0x80,0xFB,0x81,0x00,0x03,0x0B,0x0F,0x00,0x00,0x1F,0x40,
+    0x00,0x00,0x1F,0x0A,0x00,0x00,0x20,0x20,0x00,0x00,0x0A,0x1F,0x00,0x00,0x40,0x00,
+    0x40,0x60,0x2F,0x06,0x40,0xC0,0xF0,0x70,0x00,0x00,0x06,0x2F,0x60,0x40,0x00,0x1F,
+    0x00,0xFE,0xFC,0x40,0x08,0x80,0x80,0x00,0x80,0x80,0x00,0x08,0x40,0xFC,0xFE,0x00,
+    0x00,0xFF,0xBF,0x10,0x1C,0x0F,0x03,0x00,0x0F,0x1F,0x00,0x0C,0x1C,0xBF,0xFF,0x00,
+    0x80,0x00,0x01,0xF8,0x70,0x81,0x00,0x80,0x77,0x81,0x00,0x01,0x70,0xF8,0x82,0x00,
+    0x01,0x1F,0x17,0x81,0x00,0x01,0x77,0xF7,0x81,0x00,0x03,0x17,0x1F,0x70,0xF0,0x01,
+    0x80,0x02,0x83,0x00,0x08,0x60,0x40,0x30,0x18,0x0C,0x04,0x02,0x00,0x80,0x83,0x00,
+    0x03,0x40,0xC0,0xFF,0x7F,0x85,0x00,0x0C,0x24,0x00,0x80,0x5A,0x5D,0x81,0x22,0x22,
+    0xEE,0xCC,0x00,0xFF,0xFF,0x81,0x00,0x06,0x08,0x0E,0x07,0xFE,0xFF,0x01,0x05,0x82,
+    0x00,0x04,0xFB,0xFD,0x00,0x00,0x02,0x1F,0x10,0x00,0x00,0xEF,0xEF,0x80,0x98,0x80,
+    0x00,0x00,0x77,0x77,0x00,0x00,0x80,0x08,0x04,0x40,0xC6,0xFD,0x7E,0x81,0x00,0xC0,
+    0x03,0x6F,0x3C,0x38,0x6E,0xC7,0x01,0x80,0x08,0x40,0x00,0x08,0x00,0x00,0x80,0xB0,
+    0x37,0x07,0x82,0x00,0x02,0x08,0x00,0x40,0x82,0x00,0x08,0x03,0x11,0x00,0x30,0x00,
+    0x70,0xD8,0x8C,0x06,0x81,0x00,0x1F,0x00,0x10,0x70,0xE0,0x80,0xFF,0xFF,0x00,0x00,
+    0xFF,0xFF,0x00,0xC0,0xF0,0x30,0x00,0x40,0x00,0x00,0x03,0x03,0x3F,0x3F,0x00,0x00,
+    0x3F,0x3D,0x03,0x01,0x00,0x00,0x40,0x1F,0x10,0x00,0x00,0xEF,0xEF,0x80,0x98,0x80,
+    0x00,0x00,0x77,0x77,0x00,0x00,0x80,0x08,0x04,0x40,0xC6,0xFD,0x7E,0x81,0x00,0xC0,
+    0x03,0x6F,0x3C,0x38,0x6E,0xC7,0x01,0x80,0x01,0x00,0x10,0x81,0x00,0x1A,0xC0,0xE0,
+    0xCF,0xCF,0xE0,0xC2,0x0E,0x0C,0x00,0x10,0x00,0x10,0x18,0x0C,0x06,0x03,0x01,0x00,
+    0xFF,0xFF,0x00,0x01,0x03,0x06,0x0C,0x18,0x10,0x80,0x00,0x1D,0xFE,0xDC,0x00,0x00,
+    0xDC,0xFE,0xFE,0x7C,0x00,0x10,0x30,0x3C,0x9E,0x00,0x80,0xE0,0x7F,0x1D,0x40,0xC0,
+    0xFD,0x7F,0xFF,0xBF,0x6F,0x3F,0x3C,0x6F,0xC3,0x80,0x80,0x00,0x0A,0x90,0x18,0xC4,
+    0x1B,0xF3,0x80,0x70,0x00,0xD8,0x08,0x84,0x81,0x00,0x0F,0x01,0x00,0x81,0xC2,0x60,
+    0x38,0x1D,0x05,0x40,0xC0,0xC0,0x7C,0x3F,0x00,0x00,0x01,0x0E,0x00,0x04,0xE0,0xC0,
+    0x08,0x98,0x91,0x03,0x02,0x90,0x98,0x08,0xC0,0xE0,0x04,0x81,0x00,0x0D,0xFF,0xFD,
+    0x03,0x1F,0x0C,0x00,0x00,0x0C,0x5F,0xC3,0xFD,0x7F,0x00,0x00
+};
+const unsigned short HzkOffsets[15] = {
+    0,30,63,96,127,151,183,216,246,279,312,345,378,411,444
 };
 
 #endif
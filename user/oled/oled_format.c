@@ -0,0 +1,491 @@
+/**
+ * @file    oled_format.c
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2026/10/16
+ * @brief
+ *          This file provides functions to manage the following
+ *          functionalities of the OLED text formatter:
+ *              1. Integers, strings and characters without the C library
+ *              2. Fixed-point numbers
+ *              3. Restricted single precision floating point numbers
+ *              4. Cycle benchmark against vsnprintf
+ * @note
+ *          Minimum version of header file:
+ *              0.1.0
+ *          Characters are handed to the output function one by one, no
+ *          intermediate string is built. Each field is converted into a
+ *          small buffer on the stack first.
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#include "oled_format.h"
+#include "stddef.h"
+#ifdef OLED_FORMAT_USE_BENCHMARK
+#include "cyclecounter.h"
+#include "stdio.h"
+#include "string.h"
+#endif
+
+#define OLED_FORMAT_LEFT            0x01//'-'
+#define OLED_FORMAT_ZERO            0x02//'0'
+#define OLED_FORMAT_PLUS            0x04//'+'
+#define OLED_FORMAT_SPACE           0x08//' '
+#define OLED_FORMAT_BUFFER_SIZE     24//һֶεַ()
+
+/**
+ * @brief ʽ̵״̬
+ */
+typedef struct {
+    OLED_FormatOutputTypedef output;
+    void *context;
+    uint16_t limit;//ַ
+    uint16_t count;//ַ
+}OLED_FormatStateTypedef;
+
+/**
+ * @brief һת˵
+ */
+typedef struct {
+    uint8_t flags;
+    uint8_t width;
+    int16_t precision;//-1ʾûָ
+}OLED_FormatSpecTypedef;
+
+static const uint32_t powerOfTen[10] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+/**
+ * @brief һַ, limitĶ
+ */
+static inline void OLED_FormatPut(OLED_FormatStateTypedef *state, char character)
+{
+    if(state->count < state->limit)
+    {
+        state->output(state->context, character);
+        state->count++;
+    }
+}
+
+/**
+ * @brief һֶ, 
+ * @param sign , Ϊ0ʱûз
+ * @param body ֶ
+ * @param len ֶݵַ
+ * @param zero 1-'0'; 0-ÿո
+ */
+static void OLED_FormatField(OLED_FormatStateTypedef *state, const OLED_FormatSpecTypedef *spec, char sign, const char *body, uint8_t len, uint8_t zero)
+{
+    uint8_t total = len + (sign ? 1 : 0);
+    uint8_t pad = spec->width > total ? spec->width - total : 0;
+    if(!(spec->flags & OLED_FORMAT_LEFT) && !zero)
+        for(; pad; pad--)
+            OLED_FormatPut(state, ' ');
+    if(sign)
+        OLED_FormatPut(state, sign);
+    if(!(spec->flags & OLED_FORMAT_LEFT))
+        for(; pad; pad--)
+            OLED_FormatPut(state, '0');
+    while(len--)
+        OLED_FormatPut(state, *body++);
+    for(; pad; pad--)
+        OLED_FormatPut(state, ' ');
+}
+
+/**
+ * @brief ޷תΪַ, дbufferĩβ
+ * @param end bufferĩβ
+ * @param minDigits λ, ʱǰ油0
+ * @return һַλ
+ */
+static char *OLED_FormatDigits(char *end, uint32_t value, uint8_t base, uint8_t upper, uint8_t minDigits)
+{
+    const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char *p = end;
+    while(value)
+    {
+        *--p = digits[value % base];
+        value /= base;
+    }
+    while(end - p < minDigits)
+        *--p = '0';
+    return p;
+}
+
+/**
+ * @brief λ
+ */
+static inline char OLED_FormatSign(const OLED_FormatSpecTypedef *spec, uint8_t negative)
+{
+    if(negative)
+        return '-';
+    if(spec->flags & OLED_FORMAT_PLUS)
+        return '+';
+    if(spec->flags & OLED_FORMAT_SPACE)
+        return ' ';
+    return 0;
+}
+
+/**
+ * @brief , Ϊλ
+ */
+static void OLED_FormatInteger(OLED_FormatStateTypedef *state, const OLED_FormatSpecTypedef *spec, uint32_t value, uint8_t negative, uint8_t base, uint8_t upper)
+{
+    char buffer[OLED_FORMAT_BUFFER_SIZE];
+    char *end = buffer + sizeof(buffer), *p;
+    int16_t minDigits = spec->precision < 0 ? 1 : spec->precision;
+    if(minDigits > OLED_FORMAT_BUFFER_SIZE)
+        minDigits = OLED_FORMAT_BUFFER_SIZE;
+    p = OLED_FormatDigits(end, value, base, upper, minDigits);
+    OLED_FormatField(state, spec, OLED_FormatSign(spec, negative), p, end - p, (spec->flags & OLED_FORMAT_ZERO) && spec->precision < 0);
+}
+
+/**
+ * @brief ֺprecisionλС
+ * @param fraction Сֳ10^precision
+ */
+static void OLED_FormatDecimal(OLED_FormatStateTypedef *state, const OLED_FormatSpecTypedef *spec, uint32_t integer, uint32_t fraction, uint8_t precision, uint8_t negative)
+{
+    char buffer[OLED_FORMAT_BUFFER_SIZE];
+    char *end = buffer + sizeof(buffer), *p = end;
+    if(precision)
+    {
+        p = OLED_FormatDigits(end, fraction, 10, 0, precision);
+        *--p = '.';
+    }
+    p = OLED_FormatDigits(p, integer, 10, 0, 1);
+    OLED_FormatField(state, spec, OLED_FormatSign(spec, negative), p, end - p, spec->flags & OLED_FORMAT_ZERO);
+}
+
+#ifdef OLED_FORMAT_USE_FLOAT
+/**
+ * @brief ȸ
+ * @note ֳuint32_tʱ"ovf"
+ */
+static void OLED_FormatFloat(OLED_FormatStateTypedef *state, const OLED_FormatSpecTypedef *spec, float value)
+{
+    uint8_t precision = spec->precision < 0 ? OLED_FORMAT_FLOAT_PRECISION : spec->precision;
+    uint8_t negative = value < 0.0f;
+    uint32_t integer, fraction;
+    if(value != value)
+    {
+        OLED_FormatField(state, spec, 0, "nan", 3, 0);
+        return;
+    }
+    if(negative)
+        value = -value;
+    if(value >= 4294967296.0f)
+    {
+        OLED_FormatField(state, spec, OLED_FormatSign(spec, negative), "ovf", 3, 0);
+        return;
+    }
+    if(precision > OLED_FORMAT_FLOAT_PRECISION_MAX)
+        precision = OLED_FORMAT_FLOAT_PRECISION_MAX;
+    integer = (uint32_t)value;
+    fraction = (uint32_t)((value - integer) * powerOfTen[precision] + 0.5f);
+    if(fraction >= powerOfTen[precision])//λ
+    {
+        fraction -= powerOfTen[precision];
+        integer++;
+    }
+    OLED_FormatDecimal(state, spec, integer, fraction, precision, negative);
+}
+#endif
+
+/**
+ * @brief ʽַ
+ * @param output 
+ * @param context Ĳ
+ * @param limit ַ, Ĳֶ
+ * @param format ʽַ
+ * @param args б
+ * @return ַ
+ */
+uint16_t OLED_FormatV(OLED_FormatOutputTypedef output, void *context, uint16_t limit, const char *format, va_list args)
+{
+    OLED_FormatStateTypedef state = {output, context, limit, 0};
+    OLED_FormatSpecTypedef spec;
+    const char *begin, *string;
+    char length, character;
+    int32_t value;
+    uint32_t magnitude;
+    uint8_t precision;
+    int n;
+
+    while(*format)
+    {
+        if(*format != '%')
+        {
+            OLED_FormatPut(&state, *format++);
+            continue;
+        }
+        begin = format++;
+        spec.flags = 0;
+        spec.width = 0;
+        spec.precision = -1;
+        for(;; format++)
+        {
+            if(*format == '-')
+                spec.flags |= OLED_FORMAT_LEFT;
+            else if(*format == '0')
+                spec.flags |= OLED_FORMAT_ZERO;
+            else if(*format == '+')
+                spec.flags |= OLED_FORMAT_PLUS;
+            else if(*format == ' ')
+                spec.flags |= OLED_FORMAT_SPACE;
+            else
+                break;
+        }
+        if(*format == '*')
+        {
+            n = va_arg(args, int);
+            if(n < 0)
+            {
+                spec.flags |= OLED_FORMAT_LEFT;
+                n = -n;
+            }
+            spec.width = n > 255 ? 255 : n;
+            format++;
+        }
+        else
+        {
+            for(n = 0; *format >= '0' && *format <= '9'; format++)
+                n = n < 255 ? n * 10 + *format - '0' : 255;
+            spec.width = n > 255 ? 255 : n;
+        }
+        if(*format == '.')
+        {
+            format++;
+            if(*format == '*')
+            {
+                n = va_arg(args, int);
+                spec.precision = n < 0 ? -1 : (n > 255 ? 255 : n);
+                format++;
+            }
+            else
+            {
+                for(n = 0; *format >= '0' && *format <= '9'; format++)
+                    n = n < 255 ? n * 10 + *format - '0' : 255;
+                spec.precision = n > 255 ? 255 : n;
+            }
+        }
+        length = 0;
+        if(*format == 'h' || *format == 'l' || *format == 'z')
+        {
+            length = *format++;
+            if(length == 'h' && *format == 'h')
+            {
+                length = 'H';
+                format++;
+            }
+        }
+        character = *format;
+        if(character)
+            format++;
+        switch(character)
+        {
+            case 'd':
+            case 'i':
+                value = length == 'l' ? (int32_t)va_arg(args, long) : va_arg(args, int);
+                if(length == 'h')
+                    value = (int16_t)value;
+                else if(length == 'H')
+                    value = (int8_t)value;
+                magnitude = value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+                OLED_FormatInteger(&state, &spec, magnitude, value < 0, 10, 0);
+                break;
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+                magnitude = length == 'l' ? (uint32_t)va_arg(args, unsigned long) : va_arg(args, unsigned int);
+                if(length == 'h')
+                    magnitude = (uint16_t)magnitude;
+                else if(length == 'H')
+                    magnitude = (uint8_t)magnitude;
+                spec.flags &= ~(OLED_FORMAT_PLUS | OLED_FORMAT_SPACE);
+                OLED_FormatInteger(&state, &spec, magnitude, 0, character == 'u' ? 10 : (character == 'o' ? 8 : 16), character == 'X');
+                break;
+            case 'k':
+                value = length == 'l' ? (int32_t)va_arg(args, long) : va_arg(args, int);
+                precision = spec.precision < 0 ? 0 : (spec.precision > 9 ? 9 : spec.precision);
+                magnitude = value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+                OLED_FormatDecimal(&state, &spec, magnitude / powerOfTen[precision], magnitude % powerOfTen[precision], precision, value < 0);
+                break;
+            case 'f':
+#ifdef OLED_FORMAT_USE_FLOAT
+                OLED_FormatFloat(&state, &spec, (float)va_arg(args, double));
+#else
+                (void)va_arg(args, double);
+                OLED_FormatField(&state, &spec, 0, "?", 1, 0);
+#endif
+                break;
+            case 'c':
+                character = (char)va_arg(args, int);
+                OLED_FormatField(&state, &spec, 0, &character, 1, 0);
+                break;
+            case 's':
+                string = va_arg(args, const char *);
+                if(string == NULL)
+                    string = "(null)";
+                for(n = 0; string[n] && (spec.precision < 0 || n < spec.precision) && n < 255; n++);
+                OLED_FormatField(&state, &spec, 0, string, n, 0);
+                break;
+            case '%':
+                OLED_FormatPut(&state, '%');
+                break;
+            default://ֵ֧ת˵ԭ
+                while(begin < format)
+                    OLED_FormatPut(&state, *begin++);
+                break;
+        }
+    }
+    return state.count;
+}
+
+/**
+ * @brief OLED_FormatStringλ
+ */
+typedef struct {
+    char *buffer;
+    uint16_t index;
+}OLED_FormatBufferTypedef;
+
+static void OLED_FormatToBuffer(void *context, char character)
+{
+    OLED_FormatBufferTypedef *target = (OLED_FormatBufferTypedef *)context;
+    target->buffer[target->index++] = character;
+}
+
+/**
+ * @brief ʽ
+ * @param buffer 
+ * @param size ֽ, β'\0', Ϊ0ʱд
+ * @param format ʽַ
+ * @param ... 
+ * @return дַ, '\0'
+ */
+uint16_t OLED_FormatString(char *buffer, uint16_t size, const char *format, ...)
+{
+    OLED_FormatBufferTypedef target = {buffer, 0};
+    va_list args;
+    if(!size)
+        return 0;
+    va_start(args, format);
+    OLED_FormatV(OLED_FormatToBuffer, &target, size - 1, format, args);
+    va_end(args);
+    buffer[target.index] = '\0';
+    return target.index;
+}
+
+#ifdef OLED_FORMAT_USE_BENCHMARK
+#define OLED_FORMAT_BENCHMARK_SIZE  32
+#define OLED_FORMAT_BENCHMARK_RUNS  3
+
+/**
+ * @brief OLED_FormatV
+ * @return ٵ, ųһʱĻˮӰ
+ */
+static uint32_t OLED_FormatBenchmarkOwn(char *buffer, const char *format, ...)
+{
+    OLED_FormatBufferTypedef target;
+    uint32_t begin, cycles, best = 0xFFFFFFFF;
+    va_list args;
+    uint8_t i;
+    for(i = 0; i < OLED_FORMAT_BENCHMARK_RUNS; i++)
+    {
+        target.buffer = buffer;
+        target.index = 0;
+        va_start(args, format);
+        begin = CYCLECOUNTER_Read();
+        OLED_FormatV(OLED_FormatToBuffer, &target, OLED_FORMAT_BENCHMARK_SIZE - 1, format, args);
+        cycles = CYCLECOUNTER_Read() - begin;
+        va_end(args);
+        buffer[target.index] = '\0';
+        if(cycles < best)
+            best = cycles;
+    }
+    return best;
+}
+
+/**
+ * @brief vsnprintf
+ * @return ٵ
+ */
+static uint32_t OLED_FormatBenchmarkLibc(char *buffer, const char *format, ...)
+{
+    uint32_t begin, cycles, best = 0xFFFFFFFF;
+    va_list args;
+    uint8_t i;
+    for(i = 0; i < OLED_FORMAT_BENCHMARK_RUNS; i++)
+    {
+        va_start(args, format);
+        begin = CYCLECOUNTER_Read();
+        vsnprintf(buffer, OLED_FORMAT_BENCHMARK_SIZE, format, args);
+        cycles = CYCLECOUNTER_Read() - begin;
+        va_end(args);
+        if(cycles < best)
+            best = cycles;
+    }
+    return best;
+}
+
+/**
+ * @brief ȽOLED_FormatStringvsnprintfĺʱ
+ * @param result ͳƽ, OLED_FORMAT_BENCHMARK_CASES
+ * @return ͬ
+ * @note vsnprintf"%d.%02d"Ƚ, ԭʾд
+ */
+uint8_t OLED_FormatBenchmark(OLED_FormatBenchmarkTypedef *result)
+{
+    char own[OLED_FORMAT_BENCHMARK_SIZE], libc[OLED_FORMAT_BENCHMARK_SIZE];
+    uint8_t i, mismatches = 0;
+    CYCLECOUNTER_Init();
+    for(i = 0; i < OLED_FORMAT_BENCHMARK_CASES; i++)
+    {
+        switch(i)
+        {
+            case 0:
+                result[i].format = "%5d";
+                result[i].formatCycles = OLED_FormatBenchmarkOwn(own, result[i].format, -1234);
+                result[i].libcCycles = OLED_FormatBenchmarkLibc(libc, "%5d", -1234);
+                break;
+            case 1:
+                result[i].format = "%08lX";
+                result[i].formatCycles = OLED_FormatBenchmarkOwn(own, result[i].format, 0xBEEFUL);
+                result[i].libcCycles = OLED_FormatBenchmarkLibc(libc, "%08lX", 0xBEEFUL);
+                break;
+            case 2:
+                result[i].format = "%-8s|%c";
+                result[i].formatCycles = OLED_FormatBenchmarkOwn(own, result[i].format, "yaw", 'k');
+                result[i].libcCycles = OLED_FormatBenchmarkLibc(libc, "%-8s|%c", "yaw", 'k');
+                break;
+            case 3:
+                result[i].format = "%.2k";
+                result[i].formatCycles = OLED_FormatBenchmarkOwn(own, result[i].format, 1234);
+                result[i].libcCycles = OLED_FormatBenchmarkLibc(libc, "%d.%02d", 12, 34);
+                break;
+            case 4:
+                result[i].format = "%.3f";
+                result[i].formatCycles = OLED_FormatBenchmarkOwn(own, result[i].format, 3.14159);
+                result[i].libcCycles = OLED_FormatBenchmarkLibc(libc, "%.3f", 3.14159);
+                break;
+            default:
+                result[i].format = "Err-%d%5d%5d%5d";
+                result[i].formatCycles = OLED_FormatBenchmarkOwn(own, result[i].format, -3, 100, -20, 3000);
+                result[i].libcCycles = OLED_FormatBenchmarkLibc(libc, "Err-%d%5d%5d%5d", -3, 100, -20, 3000);
+                break;
+        }
+        result[i].match = !strcmp(own, libc);
+        if(!result[i].match)
+            mismatches++;
+    }
+    return mismatches;
+}
+#endif
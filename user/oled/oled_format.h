@@ -0,0 +1,98 @@
+/**
+ * @file    oled_format.h
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2026/10/16
+ * @brief
+ *          This file provides functions to manage the following
+ *          functionalities of the OLED text formatter:
+ *              1. Integers, strings and characters without the C library
+ *              2. Fixed-point numbers
+ *              3. Restricted single precision floating point numbers
+ *              4. Cycle benchmark against vsnprintf
+ * @note
+ *          Minimum version of source file:
+ *              0.1.0
+ *          Supported conversions: %d %i %u %x %X %o %c %s %% %k %f
+ *          Flags '-', '0', '+', ' ', width and precision (numbers or '*'),
+ *          length modifiers h, hh, l and z. ll and the other C99 conversions
+ *          are not supported and are printed as they are.
+ *          %k prints an int32_t fixed-point value scaled by 10^precision:
+ *          ("%.2k", 1234) gives "12.34".
+ *          %f converts its argument to float, so only about 7 significant
+ *          digits are exact. Precision is limited to OLED_FORMAT_FLOAT_PRECISION_MAX
+ *          and values out of uint32_t range are printed as "ovf".
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#ifndef __OLED_FORMAT_H
+#define __OLED_FORMAT_H
+
+#include "stm32f4xx.h"
+#include "stdarg.h"
+
+/**
+ * @brief ֧%f, ʱ%fֻ'?'
+ * @note ʹõȸ, Cĸʽ
+ */
+#define OLED_FORMAT_USE_FLOAT
+#define OLED_FORMAT_FLOAT_PRECISION_MAX 6
+#define OLED_FORMAT_FLOAT_PRECISION     6//%fָʱλ, printfͬ
+/**
+ * @brief OLED_FormatBenchmark, Cvsnprintf
+ */
+//#define OLED_FORMAT_USE_BENCHMARK
+
+/**
+ * @brief һַ
+ * @param context OLED_FormatVʱĲ
+ * @param character ַ
+ */
+typedef void (* OLED_FormatOutputTypedef)(void *context, char character);
+
+/**
+ * @brief һʽĺʱ,  @ref OLED_FormatBenchmark
+ */
+typedef struct {
+    const char *format;//OLED_FormatStringʹõĸʽ
+    uint32_t formatCycles;//OLED_FormatString
+    uint32_t libcCycles;//vsnprintfͬı
+    uint8_t match;//Ƿͬ
+}OLED_FormatBenchmarkTypedef;
+#define OLED_FORMAT_BENCHMARK_CASES     6
+
+/**
+ * @brief ʽַ
+ * @param output 
+ * @param context Ĳ
+ * @param limit ַ, Ĳֶ
+ * @param format ʽַ
+ * @param args б
+ * @return ַ
+ */
+uint16_t OLED_FormatV(OLED_FormatOutputTypedef output, void *context, uint16_t limit, const char *format, va_list args);
+/**
+ * @brief ʽ
+ * @param buffer 
+ * @param size ֽ, β'\0', Ϊ0ʱд
+ * @param format ʽַ
+ * @param ... 
+ * @return дַ, '\0'
+ */
+uint16_t OLED_FormatString(char *buffer, uint16_t size, const char *format, ...);
+/**
+ * @brief ȽOLED_FormatStringvsnprintfĺʱ
+ * @param result ͳƽ, OLED_FORMAT_BENCHMARK_CASES
+ * @return ͬ
+ * @note 趨OLED_FORMAT_USE_BENCHMARK, ÿȡ3ٵ
+ */
+uint8_t OLED_FormatBenchmark(OLED_FormatBenchmarkTypedef *result);
+
+#endif
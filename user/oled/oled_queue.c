@@ -1,17 +1,19 @@
 /**
- * @file    bsp_iic.c
+ * @file    oled_queue.c
  * @author  Miaow
- * @version 0.1.0
+ * @version 0.2.0
  * @date    2018/10/04
- * @brief   
- *          This file provides functions to manage a queue implemented by
- *          the single linked list:
- *              1. Initialization & deinitialization
+ * @brief
+ *          This file provides functions to manage a queue of preformatted
+ *          log entries implemented by a static ring buffer:
+ *              1. Initialization
  *              2. Insert & delete
  *              3. Traverse
  * @note
  *          Minimum version of header file:
- *              0.1.0
+ *              0.2.0
+ *          Every function runs in constant time and never touches the heap,
+ *          so entries can be inserted from any interrupt.
  *
  *          The source code repository is not available on GitHub now:
  *              https://github.com/3703781
@@ -21,51 +23,31 @@
  *              2. Avoid to commit several features in one commit.
  *              3. Make your modification compact - don't reformat source code in your request.
  */
-//    队列的单链表实现
-//    头节点：哨兵作用，不存放数据，用来初始化队列时使队头队尾指向的地方
-//    首节点：头节点后第一个节点，存放数据
+//    队列的环形缓冲区实现
+//    rear和front自由递增, 取低位作为下标, rear - front为队列中的条数
+//    生产者先写好数据域再更新rear, 消费者先用完数据域再更新front
 
-#include "stdlib.h"
 #include "stm32f4xx.h"
 #include "oled_queue.h"
+#include "oled_format.h"
 
-
-////    主函数
-//int main() {
-//    int val = 0;    //    定义临时变量
-//    queue queue;    //    创建队列变量
-//    InitQueue(&queue);    //    调用初始化队列函数
-//    IsEmptyQueue(&queue);    //    调用判断队列是否为空函数
-//    InsertQueue(&queue, 100);    //调用入队函数
-//    InsertQueue(&queue, 200);
-//    InsertQueue(&queue, 300);
-//    InsertQueue(&queue, 400);
-//    InsertQueue(&queue, 500);
-//    InsertQueue(&queue, 600);
-//    IsEmptyQueue(&queue);
-//    TraverseQueue(&queue);    //    调用队列遍历函数
-//    DeleteQueue(&queue, &val);    //    调用出队函数
-//    TraverseQueue(&queue);
-//    ClearQueue(&queue);        //    调用清空队列函数
-//    IsEmptyQueue(&queue);
-//    DestroyQueue(&queue);    //    调用摧毁队列函数
-
-//    return 0;
-//}
+/**
+ * @brief 写入数据域时的位置
+ */
+typedef struct {
+    char *item;
+    uint8_t index;
+}OLED_QueueWriterTypedef;
 
 /**
  * @brief 初始化
  * @param queue 队列变量
- * @return 0-初始化成功, 1-初始化失败
+ * @note 生产者和消费者开始运行前调用
  */
-uint8_t OLED_InitQueue(pQueue queue)
+void OLED_InitQueue(OLED_QueueTypedef *queue)
 {
-    queue->front = queue->rear = (pNode)malloc(sizeof(node));//动态创建头节点，使队头，队尾指向该节点
-    //头节点相当于哨兵节点的作用，不存储数据（区别于首节点）
-    if (queue->front == NULL)
-        return 1;//内存分配失败
-    queue->front->Next = NULL;//初始队列头节点指针指向为空
-    return 0;
+    queue->rear = queue->front = 0;
+    queue->dropped = 0;
 }
 
 /**
@@ -73,101 +55,110 @@ uint8_t OLED_InitQueue(pQueue queue)
  * @param queue 队列变量
  * @return 0-不为空, 1-为空
  */
-inline uint8_t OLED_IsEmptyQueue(pQueue queue)
+uint8_t OLED_IsEmptyQueue(OLED_QueueTypedef *queue)
 {
     return queue->front == queue->rear;
 }
 
+static void OLED_QueueWrite(void *context, char character)
+{
+    OLED_QueueWriterTypedef *writer = (OLED_QueueWriterTypedef *)context;
+    writer->item[writer->index++] = character;
+}
+
 /**
- * @brief 入队列
+ * @brief 入队列, 格式化后放入队尾
  * @param queue 指定队列
- * @param item 入队元素
- * @return 0-入队成功, 1-入队失败
+ * @param format 格式字符串, 支持的转换说明见oled_format.h
+ * @param args 参数列表
+ * @return 0-入队成功, 1-队列已满, 该条被丢弃
+ * @note 只在生产者中调用, 最多写OLED_QUEUE_ITEM_SIZE - 1个字符
  */
-uint8_t OLED_InsertQueueItem(pQueue queue, char* item)
+uint8_t OLED_InsertQueueItemV(OLED_QueueTypedef *queue, const char *format, va_list args)
 {
-    pNode P = (pNode)malloc(sizeof(node));//创建一个新节点用于存放插入的元素
-    if (P == NULL) 
-        return 1;//内存分配失败
-    P->item = item;//把要插入的数据放到节点数据域
-    P->Next = NULL;//新节点指针指向为空
-    queue->rear->Next = P;//使上一个队列尾部的节点指针指向新建的节点
-    queue->rear = P;//更新队尾指针，使其指向队列最后的节点
+    uint16_t rear = queue->rear;
+    OLED_QueueWriterTypedef writer;
+    if((uint16_t)(rear - queue->front) >= OLED_QUEUE_LENGTH)
+    {
+        queue->dropped++;
+        return 1;//队列满,无法入队
+    }
+    writer.item = queue->items[rear & (OLED_QUEUE_LENGTH - 1)];
+    writer.index = 0;
+    OLED_FormatV(OLED_QueueWrite, &writer, OLED_QUEUE_ITEM_SIZE - 1, format, args);
+    writer.item[writer.index] = '\0';
+    __DMB();//数据域写完后才能被消费者看到
+    queue->rear = rear + 1;
     return 0;
 }
 
 /**
- * @brief 出队列
+ * @brief 入队列, 格式化后放入队尾
  * @param queue 指定队列
- * @param item 输出出队元素
- * @return 0-出队成功, 1-出队失败
- * @note 从队列的首节点开始出队
+ * @param format 格式字符串, 支持的转换说明见oled_format.h
+ * @param ... 参数
+ * @return 0-入队成功, 1-队列已满, 该条被丢弃
  */
-uint8_t OLED_DeleteQueueItem(pQueue queue, __IO char* item)
+uint8_t OLED_InsertQueueItem(OLED_QueueTypedef *queue, const char *format, ...)
 {
-    if (OLED_IsEmptyQueue(queue))
-        return 1;//队列空,无法出队
-    pNode  P = queue->front->Next;//临时指针
-    item = P->item;//保存其值
-    P->item = NULL;
-    queue->front->Next = P->Next;//更新头节点
-    if (queue->rear == P)
-        queue->rear = queue->front;
-    free(P);//释放头队列
-    P = NULL;//防止产生野指针
-    return 0;
+    va_list args;
+    uint8_t res;
+    va_start(args, format);
+    res = OLED_InsertQueueItemV(queue, format, args);
+    va_end(args);
+    return res;
 }
 
 /**
- * @brief 遍历队列
+ * @brief 出队列
  * @param queue 指定队列
- * @param callback 回调函数
- * @return 0-成功, 1-失败
+ * @param item 输出出队元素, 至少OLED_QUEUE_ITEM_SIZE字节
+ * @return 0-出队成功, 1-出队失败
+ * @note 从队列头出队, 只在消费者中调用
  */
-uint8_t OLED_TraverseQueue(pQueue queue, void (* callback)(char *item))
+uint8_t OLED_DeleteQueueItem(OLED_QueueTypedef *queue, char *item)
 {
-    
-    if (OLED_IsEmptyQueue(queue))
-        return 1;
-    pNode P = queue->front->Next;//从队列首节点开始遍历(非头节点,注意区分)
-    while (P != NULL)
-    {
-        callback(P->item);
-        P = P->Next;
-    }
+    uint16_t front = queue->front;
+    const char *p;
+    if(front == queue->rear)
+        return 1;//队列空,无法出队
+    __DMB();//先看到rear再读数据域
+    p = queue->items[front & (OLED_QUEUE_LENGTH - 1)];
+    while((*item++ = *p++) != '\0');
+    __DMB();//数据域读完后才能被生产者覆盖
+    queue->front = front + 1;
     return 0;
 }
 
 /**
- * @brief 删除整个队列
+ * @brief 遍历队列, 每一条传给回调函数后出队
  * @param queue 指定队列
- * @note 释放整个队列,包括头节点
+ * @param callback 回调函数, 返回后该条即被覆盖
+ * @param context 传给回调函数的参数
+ * @return 0-成功, 1-队列为空
+ * @note 只在消费者中调用, 遍历期间新入队的条目也会被遍历
  */
-void OLED_DestroyQueue(pQueue queue)
+uint8_t OLED_TraverseQueue(OLED_QueueTypedef *queue, void (* callback)(const char *item, void *context), void *context)
 {
-    while (queue->front != NULL)
+    uint16_t front = queue->front;
+    if(front == queue->rear)
+        return 1;
+    while(front != queue->rear)
     {
-        queue->rear = queue->front->Next;
-        free(queue->front);
-        queue->front = queue->rear;
+        __DMB();
+        callback(queue->items[front & (OLED_QUEUE_LENGTH - 1)], context);
+        __DMB();
+        queue->front = ++front;
     }
+    return 0;
 }
 
 /**
  * @brief 清空队列
  * @param queue 指定队列
+ * @note 只在消费者中调用
  */
-void OLED_ClearQueue(pQueue queue)
+void OLED_ClearQueue(OLED_QueueTypedef *queue)
 {
-    pNode P = queue->front->Next;//临时指针
-    pNode Q = NULL;//临时指针
-    queue->rear = queue->front;//使队尾指针指向头节点
-    queue->front->Next = NULL;
-    //从首节点开始清空
-    while (P != NULL)
-    {
-        Q = P;
-        P = P->Next;
-        free(Q);
-    }
+    queue->front = queue->rear;
 }
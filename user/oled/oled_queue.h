@@ -1,17 +1,21 @@
 /**
- * @file    bsp_iic.c
+ * @file    oled_queue.h
  * @author  Miaow
- * @version 0.1.0
+ * @version 0.2.0
  * @date    2018/10/04
- * @brief   
- *          This file provides functions to manage a queue implemented by
- *          the single linked list:
- *              1. Initialization & deinitialization
+ * @brief
+ *          This file provides functions to manage a queue of preformatted
+ *          log entries implemented by a static ring buffer:
+ *              1. Initialization
  *              2. Insert & delete
  *              3. Traverse
  * @note
- *          Minimum version of header file:
- *              0.1.0
+ *          Minimum version of source file:
+ *              0.2.0
+ *          Single producer, single consumer: one context inserts and one
+ *          context deletes or traverses, no lock is needed between them.
+ *          Producers in several interrupts must share one preemption priority
+ *          so that they cannot interrupt each other.
  *
  *          The source code repository is not available on GitHub now:
  *              https://github.com/3703781
@@ -21,39 +25,33 @@
  *              2. Avoid to commit several features in one commit.
  *              3. Make your modification compact - don't reformat source code in your request.
  */
- 
+
 #ifndef __OLED_QUEUE_H
 #define __OLED_QUEUE_H
 
 #include "stm32f4xx.h"
+#include "stdarg.h"
 
-
-
-/**
- * @brief 节点结构
- */
-typedef struct OLED_Node{
-    char* item;//数据域
-    struct OLED_Node * Next;
-}node, *pNode;
+#define OLED_QUEUE_LENGTH           8//条数, 必须是2的幂
+#define OLED_QUEUE_ITEM_SIZE        32//每条的字节数, 含结尾的'\0', 超出的部分截断
 
 /**
  * @brief 队列结构体
  */
 typedef struct {
-    pNode front;//队列头
-    pNode rear;//队列尾
-}queue, *pQueue;
-
-
-
-uint8_t OLED_InitQueue(pQueue);
-inline uint8_t OLED_IsEmptyQueue(pQueue);
-uint8_t OLED_InsertQueueItem(pQueue queue, char* item);
-uint8_t OLED_DeleteQueueItem(pQueue queue, __IO char* item);
-void OLED_DestroyQueue(pQueue);
-uint8_t OLED_TraverseQueue(pQueue queue, void (*callback)(char *item));
-void OLED_ClearQueue(pQueue);
+    char items[OLED_QUEUE_LENGTH][OLED_QUEUE_ITEM_SIZE];//数据域
+    __IO uint16_t rear;//队列尾, 只由生产者修改
+    __IO uint16_t front;//队列头, 只由消费者修改
+    __IO uint32_t dropped;//队列满时丢弃的条数
+}OLED_QueueTypedef;
+
+void OLED_InitQueue(OLED_QueueTypedef *queue);
+uint8_t OLED_IsEmptyQueue(OLED_QueueTypedef *queue);
+uint8_t OLED_InsertQueueItem(OLED_QueueTypedef *queue, const char *format, ...);
+uint8_t OLED_InsertQueueItemV(OLED_QueueTypedef *queue, const char *format, va_list args);
+uint8_t OLED_DeleteQueueItem(OLED_QueueTypedef *queue, char *item);
+uint8_t OLED_TraverseQueue(OLED_QueueTypedef *queue, void (*callback)(const char *item, void *context), void *context);
+void OLED_ClearQueue(OLED_QueueTypedef *queue);
 
 
 #endif
@@ -0,0 +1,211 @@
+/**
+ * @file    oled_terminal.c
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2026/10/16
+ * @brief
+ *          This file provides functions to manage the following
+ *          functionalities of the OLED text terminal:
+ *              1. Character cell scrollback kept in RAM
+ *              2. \r, \n and \t handled the same as OLED_DisplayLog
+ *              3. Paging through the history
+ *              4. Redraw only the visible cells that changed
+ * @note
+ *          Minimum version of header file:
+ *              0.1.0
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#include "oled_terminal.h"
+#include "oled_format.h"
+#include "oled.h"
+#include "stdarg.h"
+#include "string.h"
+
+#define OLED_TERMINAL_ROW(terminal, row)    ((terminal)->__text[(row) & (OLED_TERMINAL_HISTORY - 1)])
+
+/**
+ * @brief ʾ, Χʱȡ߽
+ */
+static inline uint8_t OLED_TerminalLines(const OLED_TerminalTypedef *terminal)
+{
+    if(!terminal->lines)
+        return 1;
+    return terminal->lines > OLED_TERMINAL_MAX_LINES ? OLED_TERMINAL_MAX_LINES : terminal->lines;
+}
+
+/**
+ * @brief ʱӿڵĵһ, ԼϹ
+ * @note ݲһʱӵһпʼʾ, Ժһ
+ */
+static uint32_t OLED_TerminalFollowTop(const OLED_TerminalTypedef *terminal, uint32_t *maxBack)
+{
+    uint8_t lines = OLED_TerminalLines(terminal);
+    uint32_t oldest = terminal->__last + 1 - (terminal->__count ? terminal->__count : 1);
+    uint32_t top = terminal->__last + 1 > lines ? terminal->__last + 1 - lines : 0;
+    if(top < oldest)
+        top = oldest;
+    *maxBack = top - oldest;
+    return top;
+}
+
+/**
+ * @brief µһ, ɵһб
+ * @note Ϲ鿴ʱӿͣԭ
+ */
+static void OLED_TerminalNewLine(OLED_TerminalTypedef *terminal)
+{
+    uint32_t maxBack;
+    terminal->__last++;
+    memset(OLED_TERMINAL_ROW(terminal, terminal->__last), 0, OLED_TERMINAL_COLUMNS);
+    if(terminal->__count < OLED_TERMINAL_HISTORY)
+        terminal->__count++;
+    if(terminal->__back)
+    {
+        OLED_TerminalFollowTop(terminal, &maxBack);
+        if(terminal->__back < maxBack)
+            terminal->__back++;
+        else
+            terminal->__back = maxBack;
+    }
+}
+
+/**
+ * @brief OLED_TerminalWrite, һַд뱣
+ * @param context ն,  @ref OLED_TerminalTypedef
+ * @param character Ҫдַ
+ * @note дһк, ŵ\nֻһ, OLED_DisplayLogͬ
+ */
+static void OLED_TerminalPut(void *context, char character)
+{
+    OLED_TerminalTypedef *terminal = (OLED_TerminalTypedef *)context;
+    switch(character)
+    {
+        case '\r':
+            terminal->__x = 0;
+            break;
+        case '\n':
+            if(terminal->__x >= OLED_TERMINAL_COLUMNS)
+                terminal->__x = 0;
+            OLED_TerminalNewLine(terminal);
+            break;
+        case '\t':
+            if(terminal->__x >= OLED_TERMINAL_COLUMNS)
+            {
+                terminal->__x = 0;
+                OLED_TerminalNewLine(terminal);
+            }
+            terminal->__x = (terminal->__x & ~3) + 4;//һ4ı
+            if(terminal->__x >= OLED_TERMINAL_COLUMNS - 1)//ұ߽
+            {
+                terminal->__x = 0;
+                OLED_TerminalNewLine(terminal);
+            }
+            break;
+        default:
+            if(terminal->__x >= OLED_TERMINAL_COLUMNS)
+            {
+                terminal->__x = 0;
+                OLED_TerminalNewLine(terminal);
+            }
+            OLED_TERMINAL_ROW(terminal, terminal->__last)[terminal->__x++] = character;
+            break;
+    }
+}
+
+/**
+ * @brief նϢˢ
+ * @param terminal ն
+ * @param format ʽַ, ַֿ֧, ֵ֧ת˵oled_format.h
+ * @param ... 㶮
+ * @note ֶзwindowsͬ(crlf), OLED_STRING_MAX_CHARACTERSַ
+ *       Ϲ鿴ʱֻ, Ļϵݲ
+ */
+void OLED_TerminalWrite(OLED_TerminalTypedef *terminal, const char *format, ...)
+{
+    va_list aptr;
+    va_start(aptr, format);
+    OLED_FormatV(OLED_TerminalPut, terminal, OLED_STRING_MAX_CHARACTERS, format, aptr);
+    va_end(aptr);
+    OLED_TerminalRender(terminal);
+}
+
+/**
+ * @brief 鿴
+ * @param terminal ն
+ * @param lines (), ; һҳΪterminal->lines
+ * @note ¸µ
+ */
+void OLED_TerminalScroll(OLED_TerminalTypedef *terminal, int16_t lines)
+{
+    uint32_t maxBack;
+    int32_t back = (int32_t)terminal->__back + lines;
+    OLED_TerminalFollowTop(terminal, &maxBack);
+    if(back < 0)
+        back = 0;
+    terminal->__back = (uint32_t)back > maxBack ? maxBack : (uint32_t)back;
+    OLED_TerminalRender(terminal);
+}
+
+/**
+ * @brief ձ, صһ
+ * @param terminal ն
+ */
+void OLED_TerminalClear(OLED_TerminalTypedef *terminal)
+{
+    memset(terminal->__text, 0, sizeof(terminal->__text));
+    terminal->__last = 0;
+    terminal->__count = 1;
+    terminal->__back = 0;
+    terminal->__x = 0;
+    OLED_TerminalRender(terminal);
+}
+
+/**
+ * @brief ӿеݻĻ, ֻػַı˵λ
+ * @param terminal ն
+ * @note ʱֻʾй, ҳʱÿıַػһ
+ */
+void OLED_TerminalRender(OLED_TerminalTypedef *terminal)
+{
+    uint8_t lines = OLED_TerminalLines(terminal), i, column;
+    uint32_t maxBack, row;
+    const char *text;
+    char character;
+
+    row = OLED_TerminalFollowTop(terminal, &maxBack);
+    if(terminal->__back > maxBack)
+        terminal->__back = maxBack;
+    row -= terminal->__back;
+    OLED_BeginDraw();
+    for(i = 0; i < lines; i++, row++)
+    {
+        text = row <= terminal->__last ? OLED_TERMINAL_ROW(terminal, row) : NULL;
+        for(column = 0; column < OLED_TERMINAL_COLUMNS; column++)
+        {
+            character = text != NULL && text[column] ? text[column] : ' ';
+            if(terminal->__valid && terminal->__shown[i][column] == character)
+                continue;
+            OLED_DisplayCell(column, terminal->line + i, character);
+            terminal->__shown[i][column] = character;
+        }
+    }
+    terminal->__valid = 1;
+    OLED_EndDraw();
+}
+
+/**
+ * @brief ʹն´ˢʱȫػ
+ * @param terminal ն
+ */
+void OLED_TerminalInvalidate(OLED_TerminalTypedef *terminal)
+{
+    terminal->__valid = 0;
+}
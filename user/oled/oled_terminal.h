@@ -0,0 +1,70 @@
+/**
+ * @file    oled_terminal.h
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2026/10/16
+ * @brief
+ *          This file provides functions to manage the following
+ *          functionalities of the OLED text terminal:
+ *              1. Character cell scrollback kept in RAM
+ *              2. \r, \n and \t handled the same as OLED_DisplayLog
+ *              3. Paging through the history
+ *              4. Redraw only the visible cells that changed
+ * @note
+ *          Minimum version of source file:
+ *              0.1.0
+ *          Each terminal owns its text, cursor and view, several terminals
+ *          can share the screen in different lines.
+ *          Text is written into the ring of OLED_TERMINAL_HISTORY lines, the
+ *          screen is then compared with the window being viewed cell by cell,
+ *          the cost does not depend on the length of the history.
+ *          Call OLED_TerminalInvalidate after anything else has drawn over
+ *          the terminal, e.g. OLED_Clear.
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#ifndef __OLED_TERMINAL_H
+#define __OLED_TERMINAL_H
+
+#include "stm32f4xx.h"
+
+#define OLED_TERMINAL_COLUMNS       21//һеַ
+#define OLED_TERMINAL_MAX_LINES     8//ʾ
+#define OLED_TERMINAL_HISTORY       64//, 2, ÿռOLED_TERMINAL_COLUMNSֽ
+
+/**
+ * @brief ն
+ * @note line, linesΪ
+ */
+typedef struct {
+    uint8_t line;//ʼ(0~7)
+    uint8_t lines;//ʾ(1~OLED_TERMINAL_MAX_LINES)
+    char __text[OLED_TERMINAL_HISTORY][OLED_TERMINAL_COLUMNS];//, 0ʾհ
+    char __shown[OLED_TERMINAL_MAX_LINES][OLED_TERMINAL_COLUMNS];//Ļϵַ
+    uint32_t __last;//һе, __textеλΪ__last % OLED_TERMINAL_HISTORY
+    uint16_t __count;//(1~OLED_TERMINAL_HISTORY)
+    uint16_t __back;//ӿڱµϹ, 0ʾµ
+    uint8_t __x;//ڵ, OLED_TERMINAL_COLUMNSʾдһ, һַ
+    uint8_t __valid;//__shownĻһ
+}OLED_TerminalTypedef;
+
+/**
+ * @brief ն˳ʼֵ
+ */
+#define OLED_TERMINAL_INIT(line, lines) \
+    {(line), (lines), {{0}}, {{0}}, 0, 1, 0, 0, 0}
+
+void OLED_TerminalWrite(OLED_TerminalTypedef *terminal, const char *format, ...);
+void OLED_TerminalScroll(OLED_TerminalTypedef *terminal, int16_t lines);
+void OLED_TerminalClear(OLED_TerminalTypedef *terminal);
+void OLED_TerminalRender(OLED_TerminalTypedef *terminal);
+void OLED_TerminalInvalidate(OLED_TerminalTypedef *terminal);
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * @file    oled_widget.c
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2026/10/16
+ * @brief
+ *          This file provides functions to manage the following
+ *          functionalities of OLED widgets:
+ *              1. Numeric fields bound to variables
+ *              2. Redraw only the character cells that changed
+ * @note
+ *          Minimum version of header file:
+ *              0.1.0
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#include "oled_widget.h"
+#include "oled_format.h"
+#include "oled.h"
+
+/**
+ * @brief 󶨱͸ʽ
+ * @param text , OLED_WIDGET_MAX_WIDTH + 1ֽ
+ */
+static void OLED_WidgetFormat(const OLED_WidgetTypedef *widget, char *text)
+{
+    uint8_t size = (widget->width > OLED_WIDGET_MAX_WIDTH ? OLED_WIDGET_MAX_WIDTH : widget->width) + 1;
+    switch(widget->type)
+    {
+        case OLED_WIDGET_UINT32:
+            OLED_FormatString(text, size, widget->format, *(const volatile uint32_t *)widget->value);
+            break;
+        case OLED_WIDGET_INT16:
+            OLED_FormatString(text, size, widget->format, (int32_t)*(const volatile int16_t *)widget->value);
+            break;
+        case OLED_WIDGET_FLOAT:
+            OLED_FormatString(text, size, widget->format, (double)*(const volatile float *)widget->value);
+            break;
+        default:
+            OLED_FormatString(text, size, widget->format, *(const volatile int32_t *)widget->value);
+            break;
+    }
+}
+
+/**
+ * @brief ˢ¿ؼ, ֻػַı˵λ
+ * @param widgets ؼ
+ * @param count ؼ
+ * @note пؼһλ, ̨ˢ²ֻһ
+ */
+void OLED_WidgetRefresh(OLED_WidgetTypedef *widgets, uint8_t count)
+{
+    char text[OLED_WIDGET_MAX_WIDTH + 1];
+    uint8_t i, width, end;
+    OLED_BeginDraw();
+    for(; count; count--, widgets++)
+    {
+        width = widgets->width > OLED_WIDGET_MAX_WIDTH ? OLED_WIDGET_MAX_WIDTH : widgets->width;
+        OLED_WidgetFormat(widgets, text);
+        for(end = 0; text[end]; end++);
+        for(i = 0; i < width; i++)
+        {
+            if(i >= end)
+                text[i] = ' ';//λòո, ϴνϳ
+            if(widgets->__valid && widgets->__shown[i] == text[i])
+                continue;
+            OLED_DisplayCell(widgets->column + i, widgets->line, text[i]);
+            widgets->__shown[i] = text[i];
+        }
+        widgets->__valid = 1;
+    }
+    OLED_EndDraw();
+}
+
+/**
+ * @brief ʹؼ´ˢʱȫػ
+ * @param widgets ؼ
+ * @param count ؼ
+ */
+void OLED_WidgetInvalidate(OLED_WidgetTypedef *widgets, uint8_t count)
+{
+    for(; count; count--, widgets++)
+        widgets->__valid = 0;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file    oled_widget.h
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2026/10/16
+ * @brief
+ *          This file provides functions to manage the following
+ *          functionalities of OLED widgets:
+ *              1. Numeric fields bound to variables
+ *              2. Redraw only the character cells that changed
+ * @note
+ *          Minimum version of source file:
+ *              0.1.0
+ *          A widget remembers the characters it has drawn. OLED_WidgetRefresh
+ *          formats the bound variable again and draws only the cells whose
+ *          character differs, so an unchanged value costs no bus traffic.
+ *          Call OLED_WidgetInvalidate after anything else has drawn over the
+ *          widgets, e.g. OLED_Clear.
+ *
+ *          The source code repository is not available on GitHub now:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#ifndef __OLED_WIDGET_H
+#define __OLED_WIDGET_H
+
+#include "stm32f4xx.h"
+
+#define OLED_WIDGET_MAX_WIDTH       21//һеַ
+
+/**
+ * @brief 󶨱
+ */
+typedef enum {
+    OLED_WIDGET_INT32 = 0,
+    OLED_WIDGET_UINT32,
+    OLED_WIDGET_INT16,
+    OLED_WIDGET_FLOAT//ʽʹ%f
+}OLED_WidgetTypeTypedef;
+
+/**
+ * @brief ֵؼ
+ * @note column, line, width, format, type, valueΪ, п޸formatvalue
+ */
+typedef struct {
+    uint8_t column;//ʼ(0~20)
+    uint8_t line;//(0~7)
+    uint8_t width;//ռõַ, ʽʱո, ʱض
+    const char *format;//ʽַ, ֵ֧ת˵oled_format.h
+    OLED_WidgetTypeTypedef type;//󶨱
+    const volatile void *value;//󶨵ı
+    char __shown[OLED_WIDGET_MAX_WIDTH];//Ļϵַ
+    uint8_t __valid;//__shownĻһ
+}OLED_WidgetTypedef;
+
+/**
+ * @brief ؼʼֵ
+ */
+#define OLED_WIDGET_INIT(column, line, width, format, type, value) \
+    {(column), (line), (width), (format), (type), (value), {0}, 0}
+
+void OLED_WidgetRefresh(OLED_WidgetTypedef *widgets, uint8_t count);
+void OLED_WidgetInvalidate(OLED_WidgetTypedef *widgets, uint8_t count);
+
+#endif
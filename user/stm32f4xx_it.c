@@ -125,14 +125,8 @@ void DebugMon_Handler(void)
 {
 }
 
-/**
-  * @brief  This function handles PendSVC exception.
-  * @param  None
-  * @retval None
-  */
-void PendSV_Handler(void)
-{
-}
+/* PendSV_Handler is the background task of IIC asynchronous transfers,
+   see IIC_BACKGROUND_IRQHANDLER in bsp_iic.c. */
 
 /**
   * @brief  This function handles SysTick Handler.